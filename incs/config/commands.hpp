@@ -34,6 +34,9 @@ namespace commands
 	const std::string WHOWAS 				= "WHOWAS";
 	const std::string WHO 					= "WHO";
 	const std::string AWAY 					= "AWAY";
+	const std::string LUSERS 				= "LUSERS";
+	const std::string OPER 					= "OPER";
+	const std::string STATS 				= "STATS";
 	const std::string QUIT		 			= "QUIT";
 	const std::string DCC					= "DCC";
 }
\ No newline at end of file
@@ -26,6 +26,105 @@ namespace server
 
 	const int PING_INTERVAL 				= 240;
 	const int PONG_TIMEOUT 					= 300;
+	const int HIBERNATE_DELAY 				= 60;			// Inactivité après laquelle un client rend la mémoire de ses buffers
+
+	// Files d'attente par client : au-delà, le client est déconnecté
+	const size_t RECVQ_MAX 					= 8192;			// Octets reçus sans fin de ligne
+	const size_t SENDQ_MAX 					= 262144;		// Octets en attente d'envoi (client qui ne lit plus)
+
+	// Population attendue : capacité réservée au lancement (pools d'objets et index)
+	const size_t EXPECTED_CLIENTS 			= 256;
+	const size_t EXPECTED_CHANNELS 			= 64;
+}
+
+// === REVERSE DNS ===
+namespace dns
+{
+	const std::string RESOLV_CONF 			= "/etc/resolv.conf";
+	const std::string HOSTS_FILE 			= "/etc/hosts";
+	const std::string NAMESERVER_ENV 		= "IRCSERV_NAMESERVER";		// "ip" ou "ip:port", remplace resolv.conf (ex: résolveur local de test)
+	const int PORT 							= 53;
+
+	const int RETRY_DELAY 					= 2;			// Secondes avant de renvoyer une requête sans réponse
+	const int TIMEOUT 						= 5;			// Secondes avant d'abandonner (le client garde son IP)
+	const unsigned int CACHE_TTL_MIN 		= 60;			// Bornes du TTL d'un nom confirmé en cache
+	const unsigned int CACHE_TTL_MAX 		= 3600;
+	const unsigned int NEGATIVE_TTL 		= 60;			// Durée de cache d'un échec
+	const size_t CACHE_MAX 					= 1024;			// Nombre maximum d'IP en cache
+	const size_t HOSTLEN 					= 63;			// Longueur maximum d'un nom d'hôte affiché
+
+	enum Type
+	{
+		TYPE_A  							= 1,
+		TYPE_PTR  							= 12
+	};
+}
+
+// === CHANNEL SHARDS (MODE OPTIONNEL) ===
+namespace shard
+{
+	const std::string COUNT_ENV 			= "IRCSERV_CHANNEL_SHARDS";	// Nombre de shards, absent ou 0 = commandes de canal exécutées à la lecture
+	const size_t MAX_COUNT 					= 64;
+	const size_t TICK_BUDGET 				= 32;			// Opérations exécutées par shard et par tour de boucle
+}
+
+// === LARGE CHANNELS FAN-OUT ===
+namespace fanout
+{
+	const std::string THRESHOLD_ENV 		= "IRCSERV_FANOUT_THRESHOLD";	// Remplace le seuil ci-dessous
+	const size_t THRESHOLD 					= 1000;			// Membres à partir desquels un message de canal est envoyé en plusieurs tours de boucle
+	const size_t TICK_BUDGET 				= 4096;			// Copies envoyées par tour de boucle (toutes diffusions confondues)
+}
+
+// === DEFERRED RECLAMATION (CLIENTS, CHANNELS) ===
+namespace reclaim
+{
+	const size_t MAX_READERS 				= 64;			// Threads lecteurs enregistrés en même temps (cf EpochReclaimer)
+}
+
+// === SERVER STATISTICS (STATS) + SERVER OPERATORS (OPER) ===
+namespace stats
+{
+	const std::string OPER_NAME_ENV 		= "IRCSERV_OPER_NAME";		// Nom attendu par OPER, stats::OPER_NAME par défaut
+	const std::string OPER_PASSWORD_ENV 	= "IRCSERV_OPER_PASSWORD";	// Mot de passe de OPER, absent = aucun opérateur possible
+	const std::string OPER_NAME 			= "admin";
+	const int RATE_WINDOW 					= 5;			// Secondes sur lesquelles les débits (par seconde) sont moyennés
+	const std::string LATENCY_FILE_ENV 		= "IRCSERV_LATENCY_FILE";	// Fichier des histogrammes de durée par commande, absent = pas d'export
+	const std::string SLOW_TICK_ENV 		= "IRCSERV_SLOW_TICK_MS";	// Remplace le seuil ci-dessous
+	const unsigned long SLOW_TICK_MS 		= 50;			// Durée de travail d'un tour de boucle au-delà de laquelle il est signalé
+	const int SLOW_TICK_LOG_INTERVAL 		= 1;			// Secondes minimum entre deux avertissements de tour lent
+	const size_t LOOP_WINDOWS 				= 12;			// Fenêtres de RATE_WINDOW secondes gardées pour la boucle (une minute)
+
+	// Raisons de départ comptées séparément
+	enum Disconnect
+	{
+		DISCONNECT_SHUTDOWN  				= -1,			// Arrêt du serveur : non compté
+		DISCONNECT_QUIT  					= 0,
+		DISCONNECT_TIMEOUT  				= 1,
+		DISCONNECT_SENDQ  					= 2,
+		DISCONNECT_RECVQ  					= 3,
+		DISCONNECT_CLOSED  					= 4,
+		DISCONNECT_REASONS  				= 5
+	};
+
+	// Phases de fin de tour mesurées (hors descripteurs prêts)
+	enum LoopPhase
+	{
+		PHASE_NONE  						= 0,
+		PHASE_SHARDS  						= 1,
+		PHASE_FANOUT  						= 2,
+		PHASE_FILE_COPY  					= 3
+	};
+}
+
+// === METRICS ENDPOINT (HTTP, PROMETHEUS) ===
+namespace metrics
+{
+	const std::string PORT_ENV 				= "IRCSERV_METRICS_PORT";	// Port local de GET /metrics, absent = pas d'endpoint
+	const std::string PATH 					= "/metrics";
+	const size_t MAX_CONNECTIONS 			= 8;			// Connexions HTTP ouvertes en même temps (les suivantes sont refusées)
+	const size_t REQUEST_MAX 				= 4096;			// Taille maximale d'une requête (ligne + en-têtes)
+	const int TIMEOUT 						= 5;			// Secondes laissées à une connexion pour envoyer sa requête et lire la réponse
 }
 
 // === ENV INFOS ===
@@ -88,6 +187,9 @@ namespace file
 {
 	const std::string SEND_CMD 				= "SEND";
 	const std::string GET_CMD 				= "GET";
+
+	const size_t CHUNK_SIZE 				= 16384;		// Octets copiés d'un coup pour un GET (cf FileCopier)
+	const size_t TICK_BUDGET 				= 262144;		// Octets copiés par tour de boucle (toutes copies confondues)
 }
 
 // === REASON FOR LEAVING CHANNEL ===
@@ -101,6 +203,38 @@ namespace leaving_code
 	};
 }
 
+// === CHANNEL MEMBER FLAGS ===
+namespace member_flag
+{
+	enum Flag
+	{
+		JOINED  							= 1 << 0,
+		OPERATOR  							= 1 << 1,
+		VOICE  								= 1 << 2,
+		INVITED  							= 1 << 3
+	};
+}
+
+// === CLIENT STATE FLAGS ===
+namespace client_flag
+{
+	enum Flag
+	{
+		IRSSI  								= 1 << 0,
+		IDENTIFIED  						= 1 << 1,
+		AUTHENTICATED  						= 1 << 2,
+		RIGHT_PASS_SERV  					= 1 << 3,
+		AWAY  								= 1 << 4,
+		ERROR_MSG_TOO_LONG_SENT  			= 1 << 5,
+		PING_SENT  							= 1 << 6,
+		MARKED_FOR_DELETION  				= 1 << 7,
+		SENDQ_EXCEEDED  					= 1 << 8,
+		HIBERNATING  						= 1 << 9,
+		HOST_LOOKUP_PENDING  				= 1 << 10,
+		SERVER_OPERATOR  					= 1 << 11
+	};
+}
+
 // === PRINT ERRORS ===
 namespace error_display
 {
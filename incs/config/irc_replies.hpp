@@ -22,6 +22,36 @@ namespace irc_replies
 	const std::string RPL_LUSERUNKNOWN 				= "253";	// Nombre d'utilisateurs inconnus (non enregistrés)
 	const std::string RPL_LUSERCHANNELS 			= "254";	// Nombre de canaux actifs
 	const std::string RPL_LUSERME 					= "255";	// Résumé des utilisateurs et opérateurs sur le serveur
+	const std::string RPL_LOCALUSERS 				= "265";	// Nombre d'utilisateurs connectés + pic depuis le lancement
+	const std::string RPL_GLOBALUSERS 				= "266";	// Nombre d'utilisateurs authentifiés + pic depuis le lancement
+
+
+	// === SERVER STATS (OPERATORS) ===
+
+	// 212 RPL_STATSCOMMANDS : Nombre d'appels d'une commande (STATS m).
+	const std::string RPL_STATSCOMMANDS 			= "212";
+
+	// 219 RPL_ENDOFSTATS : Fin d'un rapport STATS.
+	const std::string RPL_ENDOFSTATS 				= "219";
+	const std::string RPL_ENDOFSTATS_MSG 			= "End of /STATS report";
+
+	// 242 RPL_STATSUPTIME : Durée de fonctionnement du serveur (STATS u).
+	const std::string RPL_STATSUPTIME 				= "242";
+
+	// 249 RPL_STATSDEBUG : Ligne libre d'un rapport STATS (compteurs du serveur).
+	const std::string RPL_STATSDEBUG 				= "249";
+
+	// 381 RPL_YOUREOPER : Le client est maintenant opérateur du serveur.
+	const std::string RPL_YOUREOPER 				= "381";
+	const std::string RPL_YOUREOPER_MSG 			= "You are now an IRC operator";
+
+	// 481 ERR_NOPRIVILEGES : Commande réservée aux opérateurs du serveur.
+	const std::string ERR_NOPRIVILEGES 				= "481";
+	const std::string ERR_NOPRIVILEGES_MSG 			= "Permission Denied- You're not an IRC operator";
+
+	// 491 ERR_NOOPERHOST : Aucun opérateur configuré (ou mauvais nom).
+	const std::string ERR_NOOPERHOST 				= "491";
+	const std::string ERR_NOOPERHOST_MSG 			= "No O-lines for your host";
 
 
 	// === CONNECT ===
@@ -50,6 +50,11 @@ namespace server_messages
 	const std::string NICKNAME_PROMPT 				= "- Nickname: NICK <your_nickname> | len <= 10";
 	const std::string USERNAME_PROMPT 				= "- Username: USER <username> <hostname> <servername> :<realname>";
 
+	// --- HOSTNAME LOOKUP
+	const std::string LOOKING_UP_HOST 				= "*** Looking up your hostname...";
+	const std::string FOUND_HOST 					= "*** Found your hostname";
+	const std::string HOST_LOOKUP_FAILED 			= "*** Couldn't look up your hostname, using your IP address instead";
+
 	// --- AUTHENTICATION SUCCESS
 	const std::string SERVER_PASSWORD_FOUND 		= "Server password found";
 	const std::string PROMPT_ONCE_REGISTERED 		= "You can now join a channel and start chatting!";
@@ -71,4 +76,6 @@ namespace server_messages
 	const std::string SHUTDOWN_REASON 				= "Server shutting down";
 	const std::string CONNECTION_FAILED 			= "Connection failed";
 	const std::string CONNECTION_TIMEOUT 			= "Connection timeout";
+	const std::string SENDQ_EXCEEDED 				= "SendQ exceeded";
+	const std::string RECVQ_EXCEEDED 				= "RecvQ exceeded";
 }
\ No newline at end of file
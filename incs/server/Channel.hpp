@@ -14,11 +14,28 @@
 
 #include <iostream>				// gestion chaînes de caractères -> std::cout, std::cerr, std::string
 #include <sstream>				// gestion flux -> std::ostringstream
-#include <set>					// container set
+#include <vector>				// container vector
+
+#include "HashTable.hpp"		// table de hachage (index des membres)
+#include "StringPool.hpp"		// symboles internés (clé du canal)
+#include "ObjectPool.hpp"		// allocateur par blocs (objets Channel)
 
 // =========================================================================================
 
 class Client;
+
+/**
+ * @brief One entry of the channel member table: a client and its member_flag bits
+ * (JOINED, OPERATOR, VOICE, INVITED).
+ */
+struct ChannelMember
+{
+	Client* client;
+	int flags;
+
+	ChannelMember(Client* member, int memberFlags) : client(member), flags(memberFlags) {}
+};
+
 class Channel
 {
 	private:
@@ -33,13 +50,26 @@ class Channel
 		Channel& operator=(const Channel& src);
 
 		std::string _name, _password;								// Nom et mot de passe du canal
+		Symbol _key;												// Symbole du nom casefoldé (RFC 1459), clé des index de canaux
 		std::string _topic, _topicSetterMask;						// Sujet du canal et auteur de la dernière modification du topic
 		time_t _channelTimestamp, _topicTimestamp;					// Moment où a ete cree le channel et date de la dernière modification du sujet format UNIX
 
-		std::set<const Client*> _connected, _operators, _invited;	// Liste des clients connectés, des opérateurs et des invités	
+		std::vector<ChannelMember> _members;						// Table des membres (connectés + invités) et de leurs flags
+		HashTable<const Client*, size_t, PointerHash> _memberIndex;	// Index client -> position dans _members
+		int _connectedCount, _operatorsCount, _invitedCount;		// Nombre de clients connectés, d'opérateurs et d'invités
 		
 		bool _isInviteOnly, _isSettableTopic;						// Modes invite +i et topic +t
 		int _clientsLimit;											// Mode +l limite de clients sur le canal
+
+		static ObjectPool<Channel> _pool;							// Mémoire de tous les objets Channel (slabs + free list)
+
+		// =================================================================================
+		// === MEMBER TABLE === Channel_Actions.cpp
+
+		const ChannelMember* _findMember(const Client* client) const;			// Récupère l'entrée d'un client dans la table, NULL si absent
+		bool _hasFlag(const Client* client, int flag) const;					// Vérifie si un client a un flag sur le canal
+		void _setFlag(Client* client, int flag);								// Ajoute un flag (crée l'entrée si besoin)
+		void _clearFlag(const Client* client, int flag);						// Retire un flag (supprime l'entrée si plus aucun flag)
 	
 	public:
 		// =================================================================================
@@ -48,6 +78,11 @@ class Channel
 		Channel(const std::string &name, const std::string& password);
 		~Channel();
 
+		// === MEMORY POOL ===
+		static void* operator new(size_t size);								// Alloue un Channel dans le pool
+		static void operator delete(void* ptr, size_t size);				// Rend le slot d'un Channel au pool
+		static ObjectPool<Channel>& getPool();								// Récupère le pool (réservation, occupation)
+
 		// =================================================================================
 		
 		// === PUBLIC METHODS ===
@@ -75,6 +110,7 @@ class Channel
 		// === CHANNEL INFOS ===
 		time_t getCreationTime() const;										// Récupère le creation time du canal
 		const std::string& getName() const;									// Récupère le nom du canal
+		Symbol getKey() const;												// Récupère le symbole du nom casefoldé du canal (clé des index)
 		std::string getModes() const;										// Récupère les modes du canal
 
 		// === MODES CHECK + GETTER ===
@@ -100,29 +136,30 @@ class Channel
 		bool hasOperators() const;											// Vérifie si le canal a des operators
 
 		// === CLIENTS LISTS ===
-		std::set<const Client*> getClientsList() const;						// Récupère la liste des clients du canal
-		std::set<const Client*> getInvitedList() const;						// Récupère la liste des clients invités sur le canal
-		std::set<const Client*> getOperatorsList() const;					// Récupère la liste des operators du canal
+		const std::vector<ChannelMember>& getMembers() const;				// Récupère la table des membres (sans copie, filtrer sur member_flag)
 		
 		int getConnectedCount() const;										// Récupère le nombre de clients connectés au canal
-		int getChannelClientByNickname(const std::string &nickname,
-											const Client* currClient);		// Récupère le client du canal par son pseudo
+		Client* getChannelClientByNickname(const std::string &nickname,
+											const Client* currClient) const;	// Récupère le client du canal par son pseudo
 		std::string getNicknames() const;									// Récupère la liste des pseudos des clients connectés au canal
 
 		bool isConnected(const Client* client) const;						// Vérifie si un client spécifique est connecté au canal
 		bool isOperator(const Client* client) const;						// Vérifie si un client spécifique est un operator du canal
 		bool isInvited(const Client* client) const;							// Vérifie si un client spécifique est invité sur le canal
+		bool isVoiced(const Client* client) const;							// Vérifie si un client spécifique a la voix sur le canal
 
 		// =================================================================================
 		// === ACTIONS === Channel_Actions.cpp
 		
 		// === CLIENT MANAGER ===
 		void addClient(Client* client);										// Ajoute un client au canal
-		void addClientToInvitedList(const Client* invited,
+		void addClientToInvitedList(Client* invited,
 									const Client* inviter);					// Ajoute un client a la liste d'invitation
+		void removeInvitation(Client* invited);						// Retire l'invitation d'un client
+		void withdrawInvitations();											// Retire toutes les invitations (canal supprimé)
 		void addOperator(Client* client);									// Ajoute un operator au canal
 		void removeOperator(Client* client);								// Retire un operator du canal
-		void removeClient(Client* client, const Client* kicker,
+		void removeClient(Client* client, Client* kicker,
 				const std::string& reason, int reasonCode);					// Retire un client du canal
 		
 		// === MESSAGES ===
@@ -0,0 +1,71 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ChannelRegistry.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 11:02:37 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 11:02:37 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <iostream>				// gestion chaînes de caractères -> std::cout, std::cerr, std::string
+#include <vector>				// container vector
+
+#include "HashTable.hpp"		// table de hachage (index des canaux)
+#include "StringPool.hpp"		// symboles internés (clés des canaux)
+
+// =========================================================================================
+
+class Channel;
+class ChannelRegistry
+{
+	public:
+		typedef HashTable<Symbol, Channel*, IntegerHash> Table;
+		typedef Table::iterator iterator;
+
+	private:
+		// =================================================================================
+
+		// === VARIABLES ===
+
+		// =================================================================================
+
+		ChannelRegistry(const ChannelRegistry& src);
+		ChannelRegistry& operator=(const ChannelRegistry& src);
+
+		Table _table;												// Symbole du nom casefoldé (RFC 1459) -> canal
+
+	public:
+		// =================================================================================
+		// === CHANNEL REGISTRY CONSTRUCTOR / DESTRUCTOR === ChannelRegistry.cpp
+
+		ChannelRegistry();
+		~ChannelRegistry();
+
+		// =================================================================================
+
+		// === PUBLIC METHODS ===
+
+		// =================================================================================
+
+		// === LOOKUP ===
+		Channel* find(const std::string& channelName) const;				// Récupère un canal par son nom (insensible à la casse), NULL si absent
+		bool contains(const std::string& channelName) const;				// Vérifie si un canal existe
+
+		// === REGISTRY MANAGER ===
+		void add(Channel* channel);											// Enregistre un canal sous son nom casefoldé
+		void remove(const Channel* channel);								// Retire un canal du registre (sans le détruire)
+
+		// === CAPACITY ===
+		void reserve(size_t count);											// Prépare l'index pour un nombre de canaux attendu
+
+		// === INFOS ===
+		size_t size() const;												// Récupère le nombre de canaux
+		bool empty() const;													// Vérifie si le registre est vide
+		iterator begin();													// Parcours non ordonné des canaux
+		iterator end();
+};
@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ChannelShards.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <iostream>				// gestion chaînes de caractères -> std::string
+#include <vector>				// container vector
+#include <deque>				// container deque (files d'opérations)
+
+#include "ClientTable.hpp"		// ClientHandle (émetteur d'une opération en attente)
+
+// =========================================================================================
+
+/**
+ * @brief One channel command waiting in the queue of its shard.
+ */
+struct ChannelOperation
+{
+	ClientHandle client;													// Émetteur (ignoré s'il est parti entre-temps)
+	std::string line;														// Ligne de commande reçue, exécutée telle quelle
+	unsigned long rank;														// Rang de l'opération parmi celles de son émetteur
+};
+
+/**
+ * @brief Optional partition of the channels into shards, each one owning a queue of operations.
+ *
+ * A channel belongs to the shard given by the hash of its casefolded name. In sharded
+ * mode, JOIN, PART, PRIVMSG and MODE aimed at a single channel are not run when they
+ * are read: they are posted to the queue of the channel's shard, and the server loop
+ * runs a bounded number of operations per shard and per iteration, in turn. A flood
+ * on one busy channel then only delays its own shard, never the other channels.
+ * Operations of one shard run in arrival order (same order for every member). An operation
+ * also waits for the earlier operations of its sender queued in other shards, and the server
+ * runs the queued operations of a client before any of its other commands: the commands
+ * of a client always take effect in the order it sent them.
+ */
+class ChannelShards
+{
+	private:
+		// =================================================================================
+
+		// === VARIABLES ===
+
+		// =================================================================================
+
+		ChannelShards(const ChannelShards& src);
+		ChannelShards& operator=(const ChannelShards& src);
+
+		std::vector<std::deque<ChannelOperation> > _queues;				// Une file d'opérations par shard (vide si le mode est désactivé)
+		std::vector<unsigned long> _postedByFd, _takenByFd;				// Opérations postées / retirées par émetteur (indexé par fd)
+		size_t _pending, _peakPending;										// Opérations en attente dans tous les shards + pic
+		size_t _next;														// Premier shard servi au prochain tour (tourniquet)
+		bool _running;														// Une opération est en cours d'exécution (pas de réentrée)
+
+		// =================================================================================
+		// === ROUTING === ChannelShards.cpp
+
+		static bool _isRoutedCommand(const std::string& line, size_t length);	// JOIN, PART, PRIVMSG ou MODE (insensible à la casse)
+
+	public:
+		// =================================================================================
+		// === CHANNEL SHARDS CONSTRUCTOR / DESTRUCTOR === ChannelShards.cpp
+
+		ChannelShards();
+		~ChannelShards();
+
+		// =================================================================================
+
+		// === PUBLIC METHODS ===
+
+		// =================================================================================
+
+		// === SETUP ===
+		void init(size_t shardCount);										// Crée les files (0 = mode désactivé, commandes exécutées à la lecture)
+
+		// === ROUTING ===
+		size_t shardOf(const std::string& channelName) const;				// Shard propriétaire d'un canal (nom insensible à la casse)
+		bool route(const std::string& line, size_t& shard) const;			// Vérifie si une ligne vise un seul canal, et lequel de ses shards
+
+		// === QUEUES ===
+		void post(size_t shard, const ClientHandle& client, const std::string& line);	// Ajoute une opération à la file d'un shard
+		bool take(size_t shard, ChannelOperation& operation);				// Retire la plus ancienne opération d'un shard, si son émetteur n'en a pas de plus ancienne
+		size_t nextShard();													// Premier shard à servir ce tour-ci (avance le tourniquet)
+		void setRunning(bool status);										// Marque le début / la fin de l'exécution d'opérations
+
+		// === INFOS ===
+		bool isEnabled() const;												// Vérifie si le mode shardé est actif
+		bool isRunning() const;												// Vérifie si des opérations sont en cours d'exécution
+		size_t getShardCount() const;										// Récupère le nombre de shards
+		size_t getPendingCount() const;										// Récupère le nombre d'opérations en attente
+		size_t getPendingCount(size_t shard) const;							// Récupère le nombre d'opérations en attente d'un shard
+		size_t getPeakPending() const;										// Récupère le pic d'opérations en attente
+		size_t getQueuedFor(int fd) const;									// Récupère le nombre d'opérations en attente d'un émetteur
+};
@@ -25,10 +25,40 @@
 #include <vector>				// container vector
 #include <set>					// container set
 
+#include "StringPool.hpp"		// symboles internés (pseudo, clés des canaux)
+#include "ObjectPool.hpp"		// allocateur par blocs (objets Client)
+
 // =========================================================================================
 
 class Server;
 class Channel;
+class ChannelRegistry;
+
+/**
+ * @brief Cold part of a client: data read on registration or by rare commands (WHOIS, AWAY, INVITE).
+ *
+ * Allocated on first write, so that loop scans over clients only touch the compact hot record.
+ */
+struct ClientDetails
+{
+	std::string username, realName, hostname;										// Nom d'utilisateur + nom réel + nom d'hôte
+	std::string resolvedHost;														// Nom d'hôte confirmé par DNS (inverse + direct), vide sinon
+	std::string awayMessage;														// Message d'absence
+	std::vector<std::string> identNicknameCmd, identUsernameCmd;					// Commande d'identification nickname et username d'Irssi
+	std::map<Symbol, Channel*> channelsInvited;										// Liste des canaux auxquels le client est invité (clé: symbole du nom casefoldé)
+};
+
+/**
+ * @brief Memory held by the connected clients, split between active and hibernating clients.
+ */
+struct ClientMemory
+{
+	size_t activeCount, activeBytes;												// Clients actifs + octets qu'ils occupent
+	size_t hibernatingCount, hibernatingBytes;										// Clients en hibernation + octets qu'ils occupent
+
+	ClientMemory() : activeCount(0), activeBytes(0), hibernatingCount(0), hibernatingBytes(0) {}
+};
+
 class Client
 {
 	private:
@@ -42,19 +72,41 @@ class Client
 		Client(const Client& src);
 		Client& operator=(const Client& src);
 
-		int _clientSocketFd, _port;														// Descripteur de socket du client + port
-		bool _isIrssi, _isIdentified, _authenticated, _rightPassServ;					// Indique si le client est via irssi, si les NICK et USER sont fournis à la connexion, s'il est authentifié, et s'il a le bon mot de passe serveur
-		
-		std::vector<std::string> _identNicknameCmd, _identUsernameCmd;					// Commande d'identification nickname et username d'Irssi
-		std::string _nickname, _username, _realName, _hostname, _clientIp, _usermask;	// Pseudo + nom d'utilisateur + nom réel + nom d'hôte + adresse IP + usermask pour RPL
-		
-		std::string _bufferMessage;														// Buffer de message
-		std::string _awayMessage;														// Message d'absence
-		
-		time_t _signonTime, _lastActivity;												// Timestamp de connexion et dernier moment actif du client
-		bool _isAway, _errorMsgTooLongSent, _pingSent;									// Indique si le client est marqué absent, si une erreur est envoyée car message trop long, et si le serveur attend un PONG
+		// --- Partie chaude : lue à chaque tour de boucle (en tête d'objet, même ligne de cache) ---
+		int _clientSocketFd;															// Descripteur de socket du client
+		mutable unsigned int _flags;													// États du client (cf client_flag : irssi, authentifié, absent, PING envoyé...), un envoi peut signaler la sendq pleine
+		time_t _lastActivity;															// Dernier moment actif du client
+		time_t _wakeTime;																// Dernière sortie d'hibernation (0 si jamais)
+		unsigned long _fanoutStamp;														// Dernière diffusion aux voisins ayant atteint le client (dédoublonnage)
+		Symbol _nicknameKey;															// Symbole du pseudo casefoldé (RFC 1459), clé de l'index des pseudos
+		int _clientPort;																// Port client (écrit à l'accept, occupe le bourrage avant _details)
+		ClientDetails* _details;														// Partie froide, allouée à la première écriture (NULL avant)
+
+		// --- Partie tiède : utilisée pour chaque message reçu ou envoyé ---
+		std::string _nickname, _usermask;												// Pseudo + usermask pour RPL
+		std::string _clientIp;															// Adresse IP client (écrite à l'accept : ne doit pas allouer la partie froide)
+		std::string _bufferMessage;														// Buffer de message (recvq : données reçues sans fin de ligne)
+		mutable std::string _sendQueue;													// File d'envoi (sendq : données que le socket n'a pas encore acceptées)
+		std::map<Symbol, Channel*> _channelsJoined;										// Liste des canaux auxquels le client est connecté (clé: symbole du nom casefoldé)
+		time_t _signonTime;																// Timestamp de connexion
+
+		static ObjectPool<Client> _pool;												// Mémoire de tous les objets Client (slabs + free list)
+		static ObjectPool<ClientDetails> _detailsPool;									// Mémoire des parties froides
+		static size_t _recvQueueTotal, _sendQueueTotal, _queuePeak;						// Octets en attente dans les files de tous les clients + pic
 
-		std::map<std::string, Channel*> _channelsJoined;								// Liste des canaux auxquels le client est connecté
+		// =================================================================================
+		// === FLAGS / COLD RECORD === Client_Attributes.cpp
+
+		bool _hasFlag(int flag) const;													// Vérifie un état du client
+		void _setFlag(int flag, bool status);											// Active ou désactive un état du client
+		ClientDetails& _getDetails();													// Récupère la partie froide (l'alloue si besoin)
+		static const ClientDetails& _emptyDetails();									// Valeurs par défaut tant que la partie froide n'existe pas
+
+		// =================================================================================
+		// === HIBERNATION === Client_Actions.cpp
+
+		static void _shrinkToFit(std::string& str);										// Ramène la capacité d'une chaîne à sa taille
+		static size_t _heapSize(const std::string& str);								// Octets alloués sur le tas par une chaîne (0 si stockée dans l'objet)
 
 	public:
 		// =================================================================================
@@ -63,6 +115,12 @@ class Client
 		Client(int fd);
 		~Client();
 
+		// === MEMORY POOL ===
+		static void* operator new(size_t size);								// Alloue un Client dans le pool
+		static void operator delete(void* ptr, size_t size);				// Rend le slot d'un Client au pool
+		static ObjectPool<Client>& getPool();								// Récupère le pool (réservation, occupation)
+		static const ObjectPool<ClientDetails>& getDetailsPool();			// Récupère le pool des parties froides (occupation)
+
 		// =================================================================================
 		
 		// === PUBLIC METHODS ===
@@ -79,6 +137,7 @@ class Client
 		void setRealName(const std::string &realName);						// Définit le nom réel
 		void setHostname(const std::string &hostname);						// Définit le nom d'hôte
 		void setClientIp(const std::string &clientIp);						// Définit l'adresse IP client
+		void setResolvedHost(const std::string &hostname);					// Définit le nom d'hôte confirmé par DNS
 		void setUsermask();													// Définit le usermask du client pour RPL
 
 		// === AUTHENTICATION INFOS ===
@@ -87,6 +146,8 @@ class Client
 		void setIdentNickCmd(std::vector<std::string> identCmd);			// Définit la commande d'identification nickname d'Irssi
 		void setIdentUsernameCmd(std::vector<std::string> identCmd);		// Définit la commande d'identification username d'Irssi
 		void setServPasswordValidity(bool status);							// Définit si le mot de passe est valide
+		void setHostLookupPending(bool status);								// Définit si le nom d'hôte du client est en cours de recherche DNS
+		void setServerOperator(bool status);								// Définit si le client est opérateur du serveur (OPER)
 		void authenticate();												// Authentifie le client
 		
 		// === ACTIVITY INFOS ===
@@ -95,6 +156,8 @@ class Client
 		void setAwayMessage(const std::string& message);					// Définit le message d'absence du client
 		void setErrorMsgTooLongSent(bool status);							// Définit si le message d'erreur d'un input trop long est déjà envoyé
 		void setPingSent(bool status);										// Définit si le serveur attend un PONG du client
+		void markForDeletion();												// Marque le client pour suppression en fin de boucle
+		bool stampFanout(unsigned long epoch);								// Marque le client comme atteint par une diffusion, false s'il l'était déjà
 
 		// =================================================================================
 		// === CLIENT INFOS GETTERS === Client_Attributes.cpp
@@ -103,10 +166,12 @@ class Client
 		int getFd() const;													// Récupère le descripteur de socket du client
 		int getClientPort() const;											// Récupère le port client
 		const std::string& getNickname() const;								// Récupère le pseudo
+		Symbol getNicknameKey() const;										// Récupère le symbole du pseudo casefoldé
 		const std::string& getUsername() const;								// Récupère le nom d'utilisateur
 		const std::string& getRealName() const;								// Récupère le nom réel
 		const std::string& getHostname() const;								// Récupère le nom d'hôte
 		const std::string& getClientIp() const;								// Récupère l'adresse IP client
+		const std::string& getVisibleHost() const;							// Récupère l'hôte affiché (nom confirmé par DNS, sinon IP)
 		const std::string& getUsermask() const;								// Récupère le usermask du client pour RPL
 
 		// === AUTHENTICATION INFOS ===
@@ -116,42 +181,64 @@ class Client
 		std::vector<std::string> getIdentUsernameCmd() const;				// Récupère la commande d'identification username d'Irssi
 		bool gotValidServPassword() const;									// Vérifie si le client a donné le bon mot de passe du serveur
 		bool isAuthenticated() const;										// Vérifie si le client est authentifié
+		bool isHostLookupPending() const;									// Vérifie si l'enregistrement attend la recherche DNS
+		bool isServerOperator() const;										// Vérifie si le client est opérateur du serveur
 		
 		// === ACTIVITY INFOS ===
 		time_t getSignonTime() const;										// Récupère le timestamp de connexion
 		time_t getLastActivity() const;										// Récupère le dernier moment actif du client
+		time_t getWakeTime() const;											// Récupère la dernière sortie d'hibernation du client
 		time_t getIdleTime() const;											// Récupère le temps d'inactivité du client
 		bool isAway() const;												// Vérifie si le client est absent
 		const std::string& getAwayMessage() const;							// Récupère le message d'absence
 		bool errorMsgTooLongSent() const;									// Vérifie si le message d'erreur d'un input trop long est déjà envoyé
 		bool pingSent() const;												// Dit si le serveur attend un PONG du client		
+		bool isMarkedForDeletion() const;									// Vérifie si le client attend sa suppression
+		bool isHibernating() const;											// Vérifie si le client a rendu la mémoire de ses buffers (inactif)
 		
 		// === RELATED CHANNELS ===
-		std::map<std::string, Channel*>& getChannelsJoined();				// Récupère les canaux auxquels le client est connecté
-		bool isInChannel(const std::string& channelName) const;				// Vérifie si le client est membre d'un canal
+		std::map<Symbol, Channel*>& getChannelsJoined();					// Récupère les canaux auxquels le client est connecté
+		std::map<Symbol, Channel*>& getChannelsInvited();					// Récupère les canaux auxquels le client est invité
+		bool isInChannel(const std::string& channelName) const;				// Vérifie si le client est membre d'un canal (par son nom)
+		bool isInChannel(const Channel* channel) const;						// Vérifie si le client est membre d'un canal
 		bool isOperator(Channel* channel) const;							// Vérifie si le client est un opérateur sur un canal
 		bool isInvited(const Channel* channel) const;						// Vérifie si le client est invité sur un canal
 
-		// === BUFFER ===
-		std::string& getBufferMessage();									// Récupère le buffer de message
+		// === RECEIVE / SEND QUEUES ===
+		void appendToRecvQueue(const char* data);							// Ajoute des données reçues au buffer de message
+		bool extractLine(std::string& line);								// Extrait la prochaine ligne complète du buffer, false s'il n'y en a pas
+		size_t getRecvQueueSize() const;									// Récupère le nombre d'octets reçus en attente d'une fin de ligne
+		bool hasCompleteLine() const;										// Vérifie si le buffer contient une ligne complète (en attente de traitement)
+		size_t getSendQueueSize() const;									// Récupère le nombre d'octets en attente d'envoi
+		bool hasPendingOutput() const;										// Vérifie si des données attendent que le socket soit prêt en écriture
+		bool sendQueueExceeded() const;										// Vérifie si la sendq a dépassé sa limite
+		static size_t getTotalQueued(bool sendQueue);						// Récupère le total des octets en attente (sendq ou recvq) de tous les clients
+		static size_t getPeakQueued();										// Récupère le pic du total des octets en attente (recvq + sendq)
 
 		// =================================================================================
 		// === ACTIONS === Client_Actions.cpp
 
 		// === CHANNEL ACTIONS ===
-		void joinChannel(const std::string& channelName, const std::string& password, std::map<std::string, Channel*>& channels);									// Rejoint un canal (creer et rejoindre ou rejoindre existant)
-		void createChannel(const std::string& channelName, const std::string& password, std::map<std::string, Channel*>& channels);									// Crée un canal
-		void addToChannel(Channel* channel, const std::string& password, const std::string& channelName, std::map<std::string, Channel*>& channels);				// Ajoute un client à un canal
+		void joinChannel(const std::string& channelName, const std::string& password, ChannelRegistry& channels);													// Rejoint un canal (creer et rejoindre ou rejoindre existant)
+		void createChannel(const std::string& channelName, const std::string& password, ChannelRegistry& channels);													// Crée un canal
+		void addToChannel(Channel* channel, const std::string& password);																							// Ajoute un client à un canal
 		void msgAfterJoin(Channel* channel, const std::string& channelName);																						// Send les bons RPL IRC après un join channel
 		bool hasRightPassword(Channel* channel, const std::string& password);																						// Vérifie le mot de passe du canal
 		void passwordSetting(Channel* channel, const std::string& password);																						// Définit le mot de passe du canal
 		void isKickedFromChannel(Channel *channel, Client* kicker, const std::string& reason);																		// Est exclu d'un canal
 		void isInvitedToChannel(Channel *channel, const Client* inviter);
-		void leaveChannel(std::map<std::string, Channel*>::iterator it, std::map<std::string, Channel*>& channels, const std::string& reason, int reasonCode);		// Quitte un canal
-		void leaveAllChannels(std::map<std::string, Channel*>& channels, const std::string& reason, int reasonCode);												// Quitte tous les canaux
-		void deleteChannel(Channel* channel, std::map<std::string, Channel*>& channels);																			// Supprime un canal
+		void leaveChannel(Channel* channel, ChannelRegistry& channels, const std::string& reason, int reasonCode);													// Quitte un canal
+		void leaveAllChannels(ChannelRegistry& channels, const std::string& reason, int reasonCode);																// Quitte tous les canaux
+		void deleteChannel(Channel* channel, ChannelRegistry& channels);																							// Supprime un canal
+		void withdrawInvitations();																																	// Retire le client des canaux qui l'ont invité
 				
 		// === SEND MESSAGES (TO CLIENTS OR CHANNEL) ===
 		void sendMessage(const std::string &message, Client* sender) const;						// Le serveur envoie un message au client
+		void flushSendQueue() const;															// Envoie ce que le socket accepte de la sendq
 		void sendToAll(Channel* channel, const std::string &message, bool includeSender);		// Envoie un message formaté irc à tous les clients connectés a un channel
+
+		// === HIBERNATION ===
+		void hibernate();																		// Rend la mémoire des buffers vides et compacte la partie froide
+		void wakeUp();																			// Sort d'hibernation (données reçues)
+		size_t getMemoryFootprint() const;														// Estime la mémoire occupée par le client (objet + tas)
 };
\ No newline at end of file
@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ClientTable.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <vector>				// container vector
+#include <cstddef>				// size_t
+
+// =========================================================================================
+
+class Client;
+
+/**
+ * @brief One slot of the fd-indexed client table.
+ */
+struct ClientSlot
+{
+	Client* client;												// Client associé au fd, NULL si le slot est libre
+	size_t livePos;												// Position du client dans la liste compacte des clients connectés
+	unsigned int generation;									// Incrémenté à chaque libération du slot (invalide les anciens handles)
+
+	ClientSlot() : client(NULL), livePos(0), generation(1) {}
+};
+
+/**
+ * @brief Stable reference to a client: slot index (fd) + slot generation.
+ *
+ * Unlike a raw Client*, a handle can be kept after the client is gone
+ * (file transfers, timers, queues): resolving it then simply returns NULL,
+ * even if the fd has been reused by a new connection.
+ */
+struct ClientHandle
+{
+	int fd;														// Index du slot
+	unsigned int generation;									// Génération du slot au moment de la création du handle
+
+	ClientHandle() : fd(-1), generation(0) {}
+	ClientHandle(int fd, unsigned int generation) : fd(fd), generation(generation) {}
+
+	bool isNull() const { return fd < 0; }
+	bool operator==(const ClientHandle& other) const { return fd == other.fd && generation == other.generation; }
+	bool operator!=(const ClientHandle& other) const { return !(*this == other); }
+};
+
+class ClientTable
+{
+	private:
+		// =================================================================================
+
+		// === VARIABLES ===
+
+		// =================================================================================
+
+		ClientTable(const ClientTable& src);
+		ClientTable& operator=(const ClientTable& src);
+
+		std::vector<ClientSlot> _slots;								// Table dense indexée par fd
+		std::vector<Client*> _live;									// Liste compacte des clients connectés (itération)
+		int _maxFd;													// Plus grand fd occupé, -1 si aucun
+
+	public:
+		// =================================================================================
+		// === CLIENT TABLE CONSTRUCTOR / DESTRUCTOR === ClientTable.cpp
+
+		ClientTable();
+		~ClientTable();
+
+		// =================================================================================
+
+		// === PUBLIC METHODS ===
+
+		// =================================================================================
+
+		// === LOOKUP ===
+		Client* get(int fd) const;											// Récupère le client associé à un fd, NULL si absent
+		ClientHandle getHandle(const Client* client) const;					// Crée un handle stable vers un client
+		Client* resolve(const ClientHandle& handle) const;					// Récupère le client d'un handle, NULL s'il est parti ou en cours de suppression
+
+		// === TABLE MANAGER ===
+		void add(Client* client);											// Range un client dans le slot de son fd
+		void remove(const Client* client);									// Libère le slot d'un client (sans le détruire) et invalide ses handles
+
+		// === CAPACITY ===
+		void reserve(size_t count);											// Prépare la table pour un nombre de clients attendu
+
+		// === INFOS ===
+		size_t size() const;												// Récupère le nombre de clients
+		bool empty() const;													// Vérifie si la table est vide
+		int getMaxFd() const;												// Récupère le plus grand fd occupé, -1 si aucun
+		const std::vector<Client*>& getLiveClients() const;					// Récupère la liste compacte des clients (parcours linéaire)
+};
@@ -29,7 +29,7 @@ class Command
 		// === COMMAND HANDLER === Command.cpp ===
 
 		// === CONSTRUCTOR (INIT COMMAND HANDLERS MAP) / DESTRUCTOR ===
-		Command(Server& server, std::map<int, Client*>::iterator itClient);
+		Command(Server& server, Client* client);
 		~Command();
 
 		// =================================================================================
@@ -49,22 +49,25 @@ class Command
 		// =================================================================================
 
 		// === STATIC MAP : COMMANDS -> HANDLERS ===
-		static std::map<std::string, void (Command::*)()> _fctMap;
+		struct Handler
+		{
+			void (Command::*function)();										// Méthode qui exécute la commande
+			size_t statsId;														// Indice du compteur de la commande (cf ServerStats)
+		};
+		static std::map<std::string, Handler> _fctMap;
 
 		// === SERVER INSTANCE ===
 		Server& _server;
 
 		// === CURRENT CLIENT INFOS ===
-		std::map<int, Client*>::iterator _it;
 		int _clientFd;
 		Client* _client;
 
-		// === REFERENCE TO ALL CLIENTS + ALL CHANNELS ===
-		std::map<int, Client*>& _clients;
-		std::map<std::string, Channel*>& _channels;
+		// === REFERENCE TO ALL CHANNELS ===
+		ChannelRegistry& _channels;
 
-		// === CURRENT INPUT TO VECTOR + ITERATOR ===
-		std::vector<std::string> _vectorInput;
+		// === CURRENT INPUT TO VECTOR + ITERATOR (EMPRUNTÉS À L'ARÈNE DE LA COMMANDE) ===
+		std::vector<std::string>& _vectorInput;
 		std::vector<std::string>::iterator _itInput;
 		
 		// === MODE TOOLS ===
@@ -83,6 +86,8 @@ class Command
 		// === INIT STATIC COMMAND MAP === Command.cpp ===
 
 		static void _initFctMap();
+		static void _addHandler(const std::string& name, void (Command::*function)());
+		void _dispatch(const Handler& handler);
 
 		// =================================================================================
 		// === AUTHENTICATE COMMANDS : Command_Register.cpp ===
@@ -111,9 +116,9 @@ class Command
 
 		// === MODE PARSER ===
 		void _handleMode();
-		bool _validateModeCommand(const std::string& channelName, unsigned int nArgs);
+		bool _validateModeCommand(Channel *channel, const std::string& channelName, unsigned int nArgs);
 		void _validateModeArguments(const Channel *channel, unsigned int nArgs);
-		void _applyChangeMode(const std::string& target);
+		void _applyChangeMode(Channel *channel);
 		void _setOperatorPrivilegeWrapper(Channel *channel);
 		void _setChannelLimitWrapper(Channel *channel);
 		
@@ -140,6 +145,9 @@ class Command
 		void _handleWhowas();
 		void _handleWho();
 		void _setAway();
+		void _sendUserStats();
+		void _becomeOperator();
+		void _sendServerStats();
 		void _quitServer();
 
 		// =================================================================================
@@ -149,5 +157,6 @@ class Command
 		void _sendFile(std::vector<std::string>& args);
 		void _getFile(std::vector<std::string>& args);
 		std::string _getFilename(const std::string& path) const;
+		std::string _getHomePath(const std::string& path) const;
 		void _handleFileError(std::vector<std::string>& args, size_t& argsSize, const std::string& errorMessage);
 };
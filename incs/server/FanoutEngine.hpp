@@ -0,0 +1,97 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FanoutEngine.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <iostream>				// gestion chaînes de caractères -> std::string
+#include <vector>				// container vector
+#include <deque>				// container deque (diffusions en attente)
+#include <map>					// container map
+
+#include "ClientTable.hpp"		// ClientHandle (destinataires et émetteur des diffusions)
+#include "StringPool.hpp"		// Symbol (clé du canal)
+
+// =========================================================================================
+
+class Client;
+struct ChannelMember;
+
+/**
+ * @brief Delivery of channel messages to very large channels, spread over several loop iterations.
+ *
+ * A message to a channel below the threshold is sent to every member at once, as before.
+ * Above it, Channel::sendToAll() hands the message over: the line is stored once with the
+ * list of its recipients (handles, taken when the message is sent), and the server loop
+ * delivers at most fanout::TICK_BUDGET copies per iteration, so one message to a huge
+ * channel never freezes the other clients for a whole iteration.
+ *
+ * Messages of one channel are delivered in the order they were sent: once a channel (or a
+ * sender) has a delivery in progress, its next messages wait behind it whatever the size of
+ * the channel. The sender gets its own copy at once, and is not read again until its
+ * deliveries are over (the server pauses its socket), so its later commands cannot overtake them.
+ */
+class FanoutEngine
+{
+	private:
+		FanoutEngine();
+		FanoutEngine(const FanoutEngine& src);
+		FanoutEngine& operator=(const FanoutEngine& src);
+		~FanoutEngine();
+
+		/**
+		 * @brief One message being delivered to a large channel.
+		 */
+		struct Job
+		{
+			Symbol channel;													// Canal de la diffusion
+			ClientHandle sender;											// Émetteur (peut partir pendant la diffusion)
+			std::string message;											// Ligne formatée une seule fois, partagée par tous les envois
+			std::vector<ClientHandle> recipients;							// Membres au moment de l'envoi
+			size_t next;													// Prochain destinataire à servir
+		};
+
+		static const ClientTable* _clients;									// Table des clients du serveur (NULL : tout est envoyé immédiatement)
+		static size_t _threshold;											// Membres à partir desquels une diffusion est découpée
+		static std::deque<Job> _jobs;										// Diffusions en cours, dans l'ordre d'envoi
+		static std::map<Symbol, size_t> _pendingByChannel;					// Diffusions en cours par canal
+		static std::vector<unsigned int> _pendingBySender;					// Diffusions en cours par émetteur (indexé par fd)
+		static std::vector<ClientHandle> _released;							// Émetteurs dont la dernière diffusion vient de finir
+		static unsigned long _deferredCount, _deferredDeliveries;			// Diffusions découpées + envois faits par la file depuis le lancement
+
+		static void _complete(const Job& job);								// Retire une diffusion terminée de ses compteurs
+
+	public:
+
+		// === SETUP ===
+		static void attach(const ClientTable& clients, size_t threshold);	// Active le découpage (table des clients du serveur + seuil)
+		static void clear();												// Abandonne les diffusions en cours (arrêt du serveur)
+
+		// === POSTING ===
+		static bool mustDefer(Symbol channel, size_t memberCount, const Client* sender);	// Vérifie si un message de canal doit passer par la file
+		static void post(Symbol channel, const Client* sender, const std::string& message,
+			const std::vector<ChannelMember>& members);						// Met en file un message pour les autres membres connectés d'un canal
+
+		// === DELIVERY ===
+		static size_t run(size_t budget);									// Fait au plus budget envois, dans l'ordre des diffusions
+		static void finish(const Client* sender);							// Termine les diffusions d'un émetteur (et celles qui les précèdent)
+		static void takeReleased(std::vector<ClientHandle>& released);		// Récupère les émetteurs à relire (plus aucune diffusion en cours)
+
+		// === INFOS ===
+		static bool empty();												// Vérifie si aucune diffusion n'est en cours
+		static size_t getJobCount();										// Récupère le nombre de diffusions en cours
+		static Symbol getChannel();											// Récupère le canal de la diffusion servie en premier (0 si aucune)
+		static const ClientHandle& getSender(size_t job);					// Récupère l'émetteur d'une diffusion en cours
+		static size_t getPendingFor(const Client* sender);					// Récupère le nombre de diffusions en cours d'un émetteur
+		static size_t getThreshold();										// Récupère le seuil de découpage
+		static unsigned long getDeferredCount();							// Récupère le nombre de diffusions découpées depuis le lancement
+		static unsigned long getDeferredDeliveries();						// Récupère le nombre d'envois faits par la file depuis le lancement
+};
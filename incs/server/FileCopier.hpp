@@ -0,0 +1,91 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FileCopier.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <iostream>				// gestion chaînes de caractères -> std::string
+#include <vector>				// container vector
+#include <deque>				// container deque (copies en cours)
+
+#include "ClientTable.hpp"		// ClientHandle (émetteur et destinataire d'un fichier)
+
+// =========================================================================================
+
+/**
+ * @brief One file copy in progress (GET), and its outcome once finished.
+ */
+struct FileCopy
+{
+	int source, target;														// Fichier envoyé / fichier créé chez le destinataire
+	std::string filename;													// Nom du fichier (messages de fin)
+	ClientHandle sender, receiver;											// Clients prévenus à la fin (s'ils sont encore là)
+	std::string senderNick, receiverNick;									// Pseudos au moment du GET
+	unsigned long bytes;													// Octets copiés
+	bool failed;															// Erreur de lecture ou d'écriture
+};
+
+/**
+ * @brief File copies run by the server loop, a bounded number of bytes per iteration.
+ *
+ * The GET command only opens the two files; the copy itself is posted here and
+ * advanced by run() at each loop iteration, file::CHUNK_SIZE bytes at a time per
+ * copy, in turn, up to file::TICK_BUDGET bytes per iteration. A big file or a slow
+ * disk then delays the transfer itself, never the chat of the other clients.
+ * Finished copies are handed back to the loop (takeFinished()), which notifies
+ * the two clients, as the resolver does for hostname lookups.
+ */
+class FileCopier
+{
+	private:
+		// =================================================================================
+
+		// === VARIABLES ===
+
+		// =================================================================================
+
+		FileCopier(const FileCopier& src);
+		FileCopier& operator=(const FileCopier& src);
+
+		std::deque<FileCopy> _copies;										// Copies en cours, servies à tour de rôle
+		std::vector<FileCopy> _finished;									// Copies terminées, pas encore annoncées
+		unsigned long _bytesCopied;											// Octets copiés depuis le lancement
+
+		// =================================================================================
+		// === COPY === FileCopier.cpp
+
+		bool _step(FileCopy& copy, size_t length);							// Copie un bloc (false : copie terminée ou en échec)
+		static void _close(FileCopy& copy);									// Ferme les deux fichiers d'une copie
+
+	public:
+		// =================================================================================
+		// === FILE COPIER CONSTRUCTOR / DESTRUCTOR === FileCopier.cpp
+
+		FileCopier();
+		~FileCopier();
+
+		// =================================================================================
+
+		// === PUBLIC METHODS ===
+
+		// =================================================================================
+
+		// === COPIES ===
+		void post(const FileCopy& copy);									// Ajoute une copie (fichiers déjà ouverts, fermés à la fin)
+		size_t run(size_t budget);											// Copie au plus budget octets, copies servies à tour de rôle
+		void takeFinished(std::vector<FileCopy>& finished);					// Récupère les copies terminées (à annoncer aux clients)
+		void clear();														// Abandonne les copies en cours (arrêt du serveur)
+
+		// === INFOS ===
+		bool empty() const;													// Vérifie si aucune copie n'est en cours
+		size_t getPendingCount() const;										// Récupère le nombre de copies en cours
+		unsigned long getBytesCopied() const;								// Récupère le nombre d'octets copiés depuis le lancement
+};
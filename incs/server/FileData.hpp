@@ -14,10 +14,13 @@
 
 #include <string>
 
+#include "ClientTable.hpp"
+
 struct FileData
 {
-	std::string path, sender, receiver;
+	std::string path;
+	ClientHandle sender, receiver;
 
 	FileData();
-	FileData(const std::string& path, const std::string& sender, const std::string& receiver);
+	FileData(const std::string& path, const ClientHandle& sender, const ClientHandle& receiver);
 };
\ No newline at end of file
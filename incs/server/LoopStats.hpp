@@ -0,0 +1,132 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LoopStats.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <cstddef>				// size_t
+#include <ctime>				// time_t
+
+#include "irc_config.hpp"		// stats::LOOP_WINDOWS, stats::LoopPhase
+#include "LatencyHistogram.hpp"	// durées des tours et retards de traitement
+#include <string>				// std::string (canal de la phase de fan-out)
+
+// =========================================================================================
+
+/**
+ * @brief One loop iteration: from the return of select() to the end of the iteration.
+ */
+struct LoopTick
+{
+	unsigned long long wakeup;												// Retour de select() (horloge monotone, ns)
+	unsigned long duration;													// Durée de travail du tour (ns)
+	int readyFds;															// Descripteurs prêts rendus par select()
+	unsigned long lag;														// Plus long délai réveil -> traitement d'un descripteur (ns)
+	unsigned long lines, bytesFlushed;										// Lignes reçues traitées / octets écrits sur les sockets
+	int slowestClientFd;													// Client dont le traitement a été le plus long (-1 si aucun)
+	unsigned long slowestClientTime;
+	size_t slowestCommand;													// Commande la plus longue (indice ServerStats, si durée non nulle)
+	int slowestCommandFd;													// Client qui l'a envoyée
+	unsigned long slowestCommandTime;
+	stats::LoopPhase slowestPhase;											// Phase de fin de tour la plus longue (shards, fan-out, copies)
+	std::string slowestPhaseChannel;										// Canal servi en premier par le fan-out, copié (vide si autre phase)
+	unsigned long slowestPhaseTime;
+};
+
+/**
+ * @brief Totals of the iterations of one window (stats::RATE_WINDOW seconds), or of several.
+ */
+struct LoopWindow
+{
+	unsigned long long duration, busy;										// Durée de la fenêtre / temps passé à travailler (ns)
+	unsigned long ticks, slowTicks;											// Tours / tours au-delà du seuil
+	unsigned long maxTick, maxLag;											// Plus long tour / plus long délai réveil -> traitement (ns)
+	unsigned long readyFds, maxReadyFds;									// Descripteurs prêts au total / au plus en un tour
+	unsigned long lines, bytesFlushed;										// Lignes traitées / octets écrits
+
+	LoopWindow() : duration(0), busy(0), ticks(0), slowTicks(0), maxTick(0), maxLag(0),
+		readyFds(0), maxReadyFds(0), lines(0), bytesFlushed(0) {}
+};
+
+/**
+ * @brief Instrumentation of the select() loop: iteration time and loop lag.
+ *
+ * Each iteration is timed from the return of select() (the wakeup) to its end.
+ * Every ready descriptor is stamped when the loop gets to it: the gap since the
+ * wakeup is how long a ready client waited behind the others, and its worst value
+ * per iteration is the loop lag. The time spent on each client, on each phase run after
+ * the descriptors (channel shards, fan-out, file copies) and the slowest command are kept
+ * for the iteration in progress, so a slow iteration can be blamed on someone or something.
+ *
+ * Iterations are summed into windows of stats::RATE_WINDOW seconds, and the last
+ * stats::LOOP_WINDOWS windows are kept (rolling minute). The whole history of the
+ * iteration times and lags also goes to two log-linear histograms.
+ *
+ * Costs two reads of the monotonic clock per ready descriptor, and a few per iteration.
+ */
+class LoopStats
+{
+	private:
+		LoopStats();
+		LoopStats(const LoopStats& src);
+		LoopStats& operator=(const LoopStats& src);
+		~LoopStats();
+
+		static LoopTick _tick;												// Tour en cours (puis dernier tour terminé)
+		static unsigned long long _dispatchStart;							// Début du traitement du descripteur en cours
+		static unsigned long long _phaseStart;								// Début de la phase de fin de tour en cours
+		static std::string _phaseChannel;									// Canal de la phase en cours, copié à son début
+		static unsigned long _linesBase, _bytesBase;						// Compteurs ServerStats au début du tour
+
+		static LatencyHistogram _tickTime, _lagTime;						// Durées des tours / délais réveil -> traitement (ns)
+		static LoopWindow _current;											// Fenêtre en cours
+		static LoopWindow _windows[stats::LOOP_WINDOWS];					// Dernières fenêtres terminées (anneau)
+		static size_t _windowIndex, _windowCount;							// Prochaine case de l'anneau / fenêtres terminées gardées
+		static unsigned long long _windowStart;								// Début de la fenêtre en cours (ns)
+
+		static unsigned long _slowThreshold;								// Durée d'un tour lent (ns)
+		static unsigned long _slowTicks;									// Tours lents depuis le lancement
+		static time_t _lastWarning;											// Dernier avertissement de tour lent
+		static unsigned long _unreported;									// Tours lents non signalés depuis (limite d'avertissements)
+		static unsigned long _unreportedBefore;								// Tours lents non signalés avant le dernier avertissement
+
+		static void _closeWindow(unsigned long long now);					// Range la fenêtre en cours dans l'anneau
+
+	public:
+		// === SETUP ===
+		static void start(unsigned long slowThreshold);						// Remet les mesures à zéro, seuil d'un tour lent en ns
+
+		// === LOOP ===
+		static void beginTick(int readyFds);								// Retour de select() : début du tour
+		static void beginDispatch();										// Début du traitement d'un descripteur prêt
+		static void endDispatch(int fd);									// Fin du traitement d'un descripteur prêt
+		static void beginPhase(const std::string& channel);					// Début d'une phase de fin de tour (shards, fan-out, copies), canal servi en premier pour le fan-out
+		static void endPhase(stats::LoopPhase phase);						// Fin de la phase
+		static void noteCommand(size_t id, int fd, unsigned long time)		// Garde la commande la plus longue du tour
+		{
+			if (time <= _tick.slowestCommandTime)
+				return;
+			_tick.slowestCommand = id;
+			_tick.slowestCommandFd = fd;
+			_tick.slowestCommandTime = time;
+		}
+		static bool endTick(time_t now);									// Fin du tour (true : tour lent à signaler)
+
+		// === INFOS ===
+		static const LoopTick& getTick();									// Récupère le dernier tour terminé
+		static LoopWindow getWindows(size_t count);							// Récupère le total des count dernières fenêtres terminées
+		static unsigned long getLag();										// Récupère la jauge de retard (pire délai de la dernière fenêtre)
+		static const LatencyHistogram& getTickTime();						// Récupère les durées des tours
+		static const LatencyHistogram& getLagTime();						// Récupère les délais réveil -> traitement (pire par tour)
+		static unsigned long getSlowThreshold();							// Récupère la durée d'un tour lent (ns)
+		static unsigned long getSlowTicks();								// Récupère le nombre de tours lents depuis le lancement
+		static unsigned long getUnreported();								// Récupère les tours lents non signalés avant celui-ci
+};
@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MetricsEndpoint.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <iostream>				// gestion chaînes de caractères -> std::string
+#include <vector>				// container vector (connexions HTTP)
+#include <ctime>				// time_t
+#include <sys/select.h>			// fd_set
+
+// =========================================================================================
+
+/**
+ * @brief One HTTP connection to the metrics endpoint.
+ */
+struct MetricsConnection
+{
+	int fd;
+	std::string request;													// Octets reçus (ligne de requête + en-têtes)
+	std::string response;													// Réponse complète à envoyer
+	size_t sent;															// Octets de la réponse déjà envoyés
+	time_t since;															// Heure de connexion (abandon après metrics::TIMEOUT)
+	bool waiting;															// Requête GET /metrics valide, attend le texte des métriques
+};
+
+/**
+ * @brief Minimal HTTP endpoint serving GET /metrics, driven by the select() loop.
+ *
+ * Optional (metrics::PORT_ENV), and bound to 127.0.0.1 only: it is meant for a local
+ * scraper, not for the IRC clients. Each connection sends one request and gets one
+ * response, then is closed (HTTP/1.1 with Connection: close). The sockets are
+ * non-blocking and watched by the same select() as the clients; a request asking
+ * for the metrics is only marked as waiting, and the loop renders the text once for
+ * every waiting scraper (answer()), as the resolver hands its answers back.
+ */
+class MetricsEndpoint
+{
+	private:
+		// =================================================================================
+
+		// === VARIABLES ===
+
+		// =================================================================================
+
+		MetricsEndpoint(const MetricsEndpoint& src);
+		MetricsEndpoint& operator=(const MetricsEndpoint& src);
+
+		int _fd;															// Socket d'écoute (-1 si désactivé)
+		std::vector<MetricsConnection> _connections;						// Connexions HTTP en cours
+		unsigned long _scrapes;												// Réponses /metrics envoyées depuis le lancement
+
+		// =================================================================================
+		// === HTTP === MetricsEndpoint.cpp
+
+		bool _read(MetricsConnection& connection);							// Lit la requête (false : connexion à fermer)
+		void _parse(MetricsConnection& connection);							// Analyse une requête complète (GET /metrics ou erreur)
+		void _respond(MetricsConnection& connection, const std::string& status, const std::string& body);
+		bool _write(MetricsConnection& connection);							// Envoie la suite de la réponse (false : connexion à fermer)
+
+	public:
+		// =================================================================================
+		// === METRICS ENDPOINT CONSTRUCTOR / DESTRUCTOR === MetricsEndpoint.cpp
+
+		MetricsEndpoint();
+		~MetricsEndpoint();
+
+		// =================================================================================
+
+		// === PUBLIC METHODS ===
+
+		// =================================================================================
+
+		// === SETUP ===
+		bool open(int port);												// Écoute sur 127.0.0.1:port (false en cas d'erreur)
+		void close();														// Ferme les connexions et le socket d'écoute
+
+		// === LOOP ===
+		void watch(fd_set& readFds, fd_set& writeFds) const;				// Ajoute les connexions aux ensembles de select()
+		void accept(time_t now);											// Accepte les connexions en attente
+		void run(const fd_set& readFds, const fd_set& writeFds);			// Lit les requêtes, envoie les réponses, ferme les connexions terminées
+		void answer(const std::string& metrics);							// Répond aux requêtes GET /metrics en attente
+		void checkTimeouts(time_t now);										// Ferme les connexions trop lentes
+
+		// === INFOS ===
+		int getFd() const;													// Récupère le socket d'écoute (-1 si désactivé)
+		int getMaxFd() const;												// Récupère le plus grand descripteur utilisé (-1 si aucun)
+		bool isEnabled() const;												// Vérifie si l'endpoint écoute
+		bool hasWaiting() const;											// Vérifie si une requête attend les métriques
+		size_t getConnectionCount() const;									// Récupère le nombre de connexions HTTP en cours
+		unsigned long getScrapeCount() const;								// Récupère le nombre de réponses /metrics envoyées
+};
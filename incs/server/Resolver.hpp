@@ -0,0 +1,134 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Resolver.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <iostream>				// gestion chaînes de caractères -> std::string
+#include <vector>				// container vector
+#include <map>					// container map
+#include <ctime>				// time_t
+#include <netinet/in.h>			// sockaddr_in, in_addr
+
+#include "ClientTable.hpp"		// ClientHandle (clients en attente d'une réponse)
+
+// =========================================================================================
+
+/**
+ * @brief Outcome of a reverse lookup, handed back to the server loop.
+ */
+struct HostLookup
+{
+	std::string ip;															// Adresse IP recherchée
+	std::string hostname;													// Nom confirmé (inverse + direct), vide en cas d'échec
+	std::vector<ClientHandle> clients;										// Clients qui attendaient cette réponse
+};
+
+/**
+ * @brief Non-blocking reverse DNS resolver driven by the select() loop.
+ *
+ * A PTR query is sent for the IP of a new client, then an A query for the name
+ * found (forward confirmation): the name is kept only if it resolves back to the IP.
+ * Queries go through one UDP socket watched by select(), answers and timeouts
+ * are processed between two loop iterations, so the loop never waits for DNS.
+ * Results are cached per IP for the TTL of the records, and /etc/hosts is read
+ * once at startup like the "files" source of the C library.
+ */
+class Resolver
+{
+	private:
+		// =================================================================================
+
+		// === VARIABLES ===
+
+		// =================================================================================
+
+		/**
+		 * @brief One query in flight (PTR first, then A for the forward confirmation).
+		 */
+		struct Query
+		{
+			std::string ip, hostname;										// IP recherchée + nom obtenu par la requête PTR
+			in_addr address;												// IP binaire (comparée aux enregistrements A)
+			int type;														// Type de la requête en cours (PTR ou A)
+			std::string packet;												// Requête encodée (renvoyée sans réponse)
+			time_t startedAt, sentAt;										// Début de la recherche + dernier envoi
+			unsigned int ttl;												// Plus petit TTL des enregistrements reçus
+			std::vector<ClientHandle> clients;								// Clients en attente
+		};
+
+		/**
+		 * @brief Cached outcome for one IP.
+		 */
+		struct CacheEntry
+		{
+			std::string hostname;											// Nom confirmé, vide pour un échec (cache négatif)
+			time_t expiresAt;												// Fin de validité
+		};
+
+		Resolver(const Resolver& src);
+		Resolver& operator=(const Resolver& src);
+
+		int _fd;															// Socket UDP connecté au serveur DNS, -1 si aucun
+		unsigned short _nextId;												// Identifiant de la prochaine requête
+		std::map<unsigned short, Query> _queries;							// Requêtes en cours (clé: identifiant DNS)
+		std::map<std::string, CacheEntry> _cache;							// Résultats récents (clé: IP)
+		std::map<std::string, std::string> _hosts;							// Entrées IPv4 de /etc/hosts (IP -> premier nom)
+		std::vector<HostLookup> _results;									// Recherches terminées, pas encore relevées par le serveur
+
+		// =================================================================================
+		// === SETUP === Resolver.cpp
+
+		void _loadHosts();													// Lit les entrées IPv4 de /etc/hosts
+		bool _findNameserver(sockaddr_in& nameserver) const;				// Adresse du serveur DNS (variable d'environnement ou resolv.conf)
+
+		// === QUERIES ===
+		void _send(Query& query, time_t now);								// Envoie (ou renvoie) une requête
+		void _startQuery(Query& query, int type, const std::string& name, time_t now);		// Encode et envoie une requête sous un nouvel identifiant
+		void _finish(unsigned short id, const std::string& hostname);		// Termine une recherche : cache + résultat pour le serveur
+		void _cacheResult(const std::string& ip, const std::string& hostname, unsigned int ttl);	// Met un résultat en cache (taille bornée)
+
+		// =================================================================================
+		// === DNS MESSAGES === Resolver_Packet.cpp
+
+		static std::string _buildQuery(unsigned short id, const std::string& name, int type);	// Encode une requête DNS
+		static std::string _reverseName(const std::string& ip);				// a.b.c.d -> d.c.b.a.in-addr.arpa
+		static bool _readName(const unsigned char* msg, size_t len, size_t& pos, std::string& name);	// Décode un nom (avec compression)
+		static bool _isValidHostname(const std::string& name);				// Vérifie qu'un nom peut servir d'hôte IRC
+		void _handleReply(const unsigned char* msg, size_t len);			// Traite une réponse reçue
+
+	public:
+		// =================================================================================
+		// === RESOLVER CONSTRUCTOR / DESTRUCTOR === Resolver.cpp
+
+		Resolver();
+		~Resolver();
+
+		// =================================================================================
+
+		// === PUBLIC METHODS ===
+
+		// =================================================================================
+
+		// === SETUP ===
+		void init();														// Lit /etc/hosts et ouvre le socket vers le serveur DNS
+
+		// === LOOKUP ===
+		bool lookup(const std::string& ip, const ClientHandle& client, std::string& hostname);	// Cherche le nom d'une IP, true si la réponse est immédiate
+		void readReplies();													// Lit les réponses disponibles sur le socket
+		void checkTimeouts(time_t now);										// Renvoie ou abandonne les requêtes sans réponse
+		void takeResults(std::vector<HostLookup>& results);					// Récupère les recherches terminées
+
+		// === INFOS ===
+		int getFd() const;													// Récupère le socket à surveiller, -1 si aucun
+		size_t getPendingCount() const;										// Récupère le nombre de recherches en cours
+		size_t getCacheSize() const;										// Récupère le nombre d'IP en cache
+};
@@ -18,9 +18,32 @@
 // === FILES STRUCT ===
 #include "FileData.hpp"
 
+// === LOOKUP INDEXES ===
+#include "HashTable.hpp"
+#include "ChannelRegistry.hpp"
+#include "ClientTable.hpp"
+
+// === REVERSE DNS ===
+#include "Resolver.hpp"
+
+// === CHANNEL SHARDS + FAN-OUT ===
+#include "ChannelShards.hpp"
+#include "FanoutEngine.hpp"
+
+// === FILE TRANSFERS ===
+#include "FileCopier.hpp"
+
+// === METRICS ENDPOINT ===
+#include "MetricsEndpoint.hpp"
+
+// === NAMESPACES ===
+#include "irc_config.hpp"		// stats::Disconnect
+
 // =========================================================================================
 
 class Client;
+struct ClientMemory;
+struct LoopTick;
 class Channel;
 class Server
 {
@@ -39,14 +62,30 @@ class Server
 		std::string _password, _localIp, _timeCreationStr;						// Mot de passe serveur + adresse IP locale + date et heure de création du serveur
 		int _serverSocketFd, _port, _maxFd;										// Descripteur du socket du serveur + port + descripteur maximum pour select()
 		fd_set _readFds;														// Ensemble des descripteurs surveillés
+		std::string _operName, _operPassword;									// Identifiants de OPER (mot de passe vide = aucun opérateur possible)
+		std::string _latencyFile;												// Fichier des histogrammes de durée (vide = pas d'export)
 		
 		// === CONTAINERS -> CLIENTS + CHANNELS ===
-		std::map<int, Client*> _clients;										// Liste des clients connectés
-		std::vector<std::map<int, Client*>::iterator> _clientsToDelete;			// Liste des clients à supprimer (stocke les iterateurs map des clients)
-		std::map<std::string, Channel*> _channels;								// Liste des canaux
+		ClientTable _clients;													// Table des clients connectés (indexée par fd)
+		std::vector<Client*> _clientsToDelete;									// Liste des clients à supprimer (sans doublon, cf Client::isMarkedForDeletion())
+		ChannelRegistry _channels;												// Registre des canaux (nom casefoldé RFC 1459 -> canal)
+		HashTable<Symbol, Client*, IntegerHash> _nicknames;						// Index symbole du pseudo (casefoldé RFC 1459) -> client
+		unsigned long _fanoutEpoch;												// Numéro de la diffusion aux voisins en cours (dédoublonnage)
+		ChannelShards _shards;													// Files d'opérations par shard de canaux (mode optionnel)
+
+		// === REVERSE DNS ===
+		Resolver _resolver;														// Recherche non bloquante des noms d'hôte des clients
+
+		// === USER STATS (TENUES À JOUR À CHAQUE CHANGEMENT D'ÉTAT) ===
+		int _authenticatedCount;												// Nombre de clients authentifiés
+		int _maxClientCount, _maxAuthenticatedCount;							// Pics de clients connectés et authentifiés depuis le lancement
 
 		// === FILES TO SEND ===
 		std::map<std::string, FileData>	_files;									// Liste des fichiers à envoyer avec DCC SEND
+		FileCopier _fileCopier;													// Copies de fichiers (GET) avancées par blocs à chaque tour de boucle
+
+		// === METRICS ENDPOINT ===
+		MetricsEndpoint _metrics;												// GET /metrics sur un port local (optionnel)
 
 
 		// =================================================================================
@@ -63,14 +102,28 @@ class Server
 		void _setSignal();														// Paramétrage du signal
 		void _setLocalIp();														// Récupère l'adresse IP locale
 		void _setServerSocket();												// Paramétrage du socket serveur
+		void _reserveCapacity();												// Réserve pools et index pour la population attendue
+		void _initStats();														// Lit les identifiants des opérateurs et le fichier des durées, lance les compteurs
+		void _initMetrics();													// Ouvre l'endpoint des métriques si un port est donné par l'environnement
 		
 		// === START LOOP ===
 		void _start();															// Démarre le serveur
 		
 		// === HANDLE MESSAGES ===
-		void _handleMessage(std::map<int, Client*>::iterator it);				// Gère la lecture des messages d'un client
-		void _processCommand(std::map<int, Client*>::iterator it, 
-											std::string message);				// Traite l'entrée du client
+		void _handleMessage(Client* client);									// Gère la lecture des messages d'un client
+		void _processLines(Client* client);										// Traite les lignes complètes de la recvq d'un client
+		void _processCommand(Client* client, std::string message);				// Traite l'entrée du client (ou la confie au shard de son canal)
+		void _executeCommand(Client* client, const std::string& message);		// Exécute une commande et renvoie l'erreur éventuelle au client
+
+		// === CHANNEL SHARDS ===
+		void _initChannelShards();												// Active le mode shardé si demandé par l'environnement
+		void _runChannelShards(size_t budget);									// Exécute au plus budget opérations par shard, à tour de rôle
+		void _runQueuedOperations(const Client* client);						// Exécute les opérations en attente d'un client (ordre de ses commandes)
+
+		// === LARGE CHANNELS FAN-OUT ===
+		void _initFanout();														// Active l'envoi découpé des grands canaux (seuil éventuel de l'environnement)
+		void _pauseFanoutSenders(fd_set& readFds);								// Ne lit pas les émetteurs dont une diffusion est en cours
+		void _resumeFanoutSenders();											// Reprend les lignes en attente des émetteurs dont les diffusions sont finies
 		
 		// === CLEAN ===
 		void _clean();															// Nettoie le serveur avant fermeture
@@ -81,9 +134,35 @@ class Server
 		void _acceptNewClient();												// Accepte une nouvelle connexion client
 		void _addClient(int clientFd);											// Ajoute un client à la liste
 		void _checkActivity();													// Vérifie l'activité des clients
+		void _checkSendQueues(fd_set& writeFds);								// Surveille les sendq (écriture en attente, dépassement)
 		void _disconnectClient(int fd, const std::string& reason);				// Déconnecte un client du serveur
-		void _deleteClient(std::map<int, Client*>::iterator it);				// Supprime un client de la liste
+		void _deleteClient(Client* client);										// Supprime un client de la liste
 		void _lateClientDeletion();												// Supprime les clients de la liste en différé
+
+		// === HOSTNAME LOOKUP ===
+		void _startHostLookup(Client* client);									// Lance la recherche DNS inverse d'un nouveau client
+		void _setClientHost(Client* client, const std::string& hostname);		// Applique le résultat d'une recherche à un client
+		void _applyHostLookups();												// Distribue les recherches terminées (et termine les enregistrements en attente)
+
+		// === FILE TRANSFERS ===
+		void _applyFileCopies();												// Prévient les clients des copies de fichiers terminées
+
+		// === METRICS ENDPOINT ===
+		void _serveMetrics(const fd_set& readFds, const fd_set& writeFds);		// Lit les requêtes HTTP, répond aux GET /metrics
+
+		// === LOOP INSTRUMENTATION ===
+		void _reportSlowTick();													// Signale un tour de boucle trop long (client ou phase, et commande en cause)
+		std::string _describeFd(int fd);										// Nomme un descripteur de la boucle (pseudo du client, socket serveur...)
+		std::string _describePhase(const LoopTick& tick);						// Nomme la phase de fin de tour la plus longue (shards, fan-out, copies)
+
+		// =================================================================================
+		// === SERVER STATS === Server_Infos.cpp
+
+		void _sendTrafficStats(Client* client);									// Envoie les débits, connexions, départs et canaux (STATS t)
+		void _sendMemoryStats(Client* client);									// Envoie l'occupation mémoire et l'état des files (STATS z)
+		void _sendLatencyStats(Client* client);									// Envoie les durées d'exécution par commande, exporte les histogrammes (STATS l)
+		void _sendLoopStats(Client* client);									// Envoie les durées des tours de boucle et le retard de traitement (STATS e)
+		std::string _renderMetrics();											// Écrit les compteurs au format texte de Prometheus (GET /metrics)
 	
 	public:
 		// =================================================================================
@@ -114,26 +193,36 @@ class Server
 		int getPort() const;													// Récupère le port du serveur;
 		int getMaxFd();															// Récupère le descripteur maximum pour select()
 		const std::string& getServerPassword() const;							// Récupère le mot de passe du serveur
-		std::map<std::string, Channel*>& getChannels();							// Récupère la liste des canaux
+		ChannelRegistry& getChannels();											// Récupère le registre des canaux
 		int getChannelCount() const;											// Récupère le nombre de canaux
+		const std::string& getOperatorName() const;								// Récupère le nom attendu par OPER
+		const std::string& getOperatorPassword() const;							// Récupère le mot de passe de OPER (vide si aucun)
+		void sendServerStats(Client* client, char query);						// Envoie un rapport STATS à un opérateur
 
 		// =================================================================================
 		// === CLIENT MANAGER === Server_Clients.cpp
 
 		// === GETTERS ===
-		std::map<int, Client*>& getClients();															// Récupère la liste des clients
+		ClientTable& getClients();																		// Récupère la table des clients
 		int getTotalClientCount() const;																// Récupère le nombre total de clients
-		int getClientCount(bool authenticated);															// Récupère le nombre de clients authentifiés ou non
-		int getClientByNickname(const std::string& nickname, Client* currClient);						// Récupère le client par son pseudo
+		int getClientCount(bool authenticated) const;													// Récupère le nombre de clients authentifiés ou non
+		int getMaxClientCount(bool authenticated) const;												// Récupère le pic de clients (authentifiés ou tous)
+		ClientMemory getClientMemory() const;															// Mesure la mémoire des clients (actifs / en hibernation)
+		Client* getClientByNickname(const std::string& nickname, Client* currClient);					// Récupère le client par son pseudo
 		
 		// === ACTIONS ===
+		void setClientNickname(Client* client, const std::string& nickname);							// Change le pseudo d'un client et met à jour l'index
+		void authenticateClient(Client* client);														// Authentifie un client et met à jour les compteurs
+		void completeRegistration(Client* client);														// Termine l'enregistrement d'un client (usermask, accueil)
 		void greetClient(Client* client);																// Accueille un client
-		void broadcastToClients(const std::string &message);											// Envoie un message à tous les clients connectés
-		void prepareClientToLeave(std::map<int, Client*>::iterator it, const std::string& reason);		// Prépare un client à quitter le serveur
+		void sendUserStats(Client* client);																// Envoie les statistiques d'utilisateurs (LUSERS)
+		void sendToNeighbors(Client* client, const std::string& message, bool includeSelf);			// Envoie un message une seule fois à chaque client partageant un canal
+		void prepareClientToLeave(Client* client, const std::string& reason, stats::Disconnect type);							// Prépare un client à quitter le serveur
 		
 		// === FILES TO SEND ===
 		std::map<std::string, FileData>& getFiles();													// Récupère la liste des fichiers à envoyer
-		void addFile(const std::string& filename, const std::string& path, const std::string& sender,
-																		const std::string& receiver);	// Ajoute un fichier à la liste
+		void addFile(const std::string& filename, const std::string& path, const Client* sender,
+																		const Client* receiver);		// Ajoute un fichier à la liste
 		void removeFile(const std::string& filename);													// Supprime un fichier de la liste
+		void startFileCopy(const FileCopy& copy);														// Confie une copie de fichier (GET) à la boucle
 };
\ No newline at end of file
@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ServerStats.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <string>				// std::string
+#include <vector>				// container vector (compteurs par commande)
+#include <ctime>				// time_t, clock_gettime()
+
+#include "irc_config.hpp"		// stats::Disconnect
+#include "LatencyHistogram.hpp"	// durées d'exécution par commande
+
+// =========================================================================================
+
+/**
+ * @brief Lines and bytes going through the client sockets.
+ */
+struct Traffic
+{
+	unsigned long linesIn, linesOut;										// Lignes reçues / messages mis en file d'envoi
+	unsigned long bytesIn, bytesOut;										// Octets lus / écrits sur les sockets
+
+	Traffic() : linesIn(0), linesOut(0), bytesIn(0), bytesOut(0) {}
+};
+
+/**
+ * @brief Number of times a command was dispatched, and how long it took to run.
+ */
+struct CommandStats
+{
+	std::string name;
+	unsigned long calls;
+	LatencyHistogram latency;												// Durées d'exécution (ns)
+};
+
+/**
+ * @brief Live counters of the server, read by the STATS command.
+ *
+ * The hot path only increments integers (inline methods below): a line read,
+ * a message queued, bytes written, a command dispatched. Nothing is formatted
+ * until an operator asks for a report. Commands are numbered once, when the
+ * command map is built (registerCommand()), so counting one is an index access.
+ *
+ * The rates are averaged over stats::RATE_WINDOW seconds by tick(), called
+ * once per loop iteration (one comparison, except when a window ends).
+ *
+ * Each dispatch is also timed with the monotonic clock (Timer) and recorded in the
+ * log-linear histogram of its command: the percentiles show which commands are slow
+ * (JOIN on a big channel, WHO, MODE...), not only which ones are frequent.
+ * The loop iteration times are kept by LoopStats.
+ */
+class ServerStats
+{
+	private:
+		ServerStats();
+		ServerStats(const ServerStats& src);
+		ServerStats& operator=(const ServerStats& src);
+		~ServerStats();
+
+		static time_t _startTime, _windowStart;								// Lancement du serveur / début de la fenêtre des débits
+		static Traffic _traffic;											// Totaux depuis le lancement
+		static Traffic _windowBase;											// Totaux au début de la fenêtre en cours
+		static Traffic _rates;												// Débits par seconde de la dernière fenêtre terminée
+		static unsigned long _accepts;										// Connexions acceptées depuis le lancement
+		static unsigned long _disconnects[stats::DISCONNECT_REASONS];		// Départs par raison depuis le lancement
+		static std::vector<CommandStats> _commands;							// Appels par commande (indice donné par registerCommand())
+
+	public:
+		// === SETUP ===
+		static void start(time_t now);										// Remet les compteurs à zéro au lancement du serveur
+		static size_t registerCommand(const std::string& name);				// Numérote une commande (même numéro si déjà connue)
+
+		// === HOT PATH (INCRÉMENTS SEULS) ===
+		static void countLineIn() { _traffic.linesIn++; }
+		static void countLineOut() { _traffic.linesOut++; }
+		static void countBytesIn(size_t bytes) { _traffic.bytesIn += bytes; }
+		static void countBytesOut(size_t bytes) { _traffic.bytesOut += bytes; }
+		static void countAccept() { _accepts++; }
+		static void countCommand(size_t id) { _commands[id].calls++; }
+		static void countDisconnect(stats::Disconnect reason)				// Compte un départ pour sa raison (l'arrêt du serveur n'est pas compté)
+		{
+			if (reason != stats::DISCONNECT_SHUTDOWN)
+				_disconnects[reason]++;
+		}
+		static void recordLatency(size_t id, unsigned long ns) { _commands[id].latency.record(ns); }
+		static unsigned long long clockNs();								// Horloge monotone, en nanosecondes
+
+		// Chronomètre une commande, de sa construction à sa destruction (horloge monotone)
+		class Timer
+		{
+			private:
+				Timer(const Timer& src);
+				Timer& operator=(const Timer& src);
+
+				size_t _id;
+				int _fd;														// Client qui a envoyé la commande (cf LoopStats)
+				unsigned long long _start;
+
+			public:
+				Timer(size_t id, int fd);
+				~Timer();
+		};
+
+		// === RATES ===
+		static void tick(time_t now);										// Termine la fenêtre des débits si elle a assez duré
+
+		// === INFOS ===
+		static time_t getUptime(time_t now);								// Récupère le temps écoulé depuis le lancement
+		static const Traffic& getTraffic();									// Récupère les totaux depuis le lancement
+		static const Traffic& getRates();									// Récupère les débits par seconde
+		static unsigned long getAccepts();									// Récupère le nombre de connexions acceptées
+		static unsigned long getDisconnects(stats::Disconnect reason);		// Récupère le nombre de départs pour une raison
+		static const std::vector<CommandStats>& getCommands();				// Récupère les compteurs par commande
+		static bool getProcessMemory(unsigned long& resident, unsigned long& size);	// Lit la mémoire du processus (octets résidents / virtuels)
+
+		// === EXPORT ===
+		static bool writeLatencies(const std::string& path);				// Écrit les histogrammes de durée dans un fichier
+};
@@ -0,0 +1,38 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AllocCounter.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 17:05:12 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 17:05:12 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <cstddef>				// size_t
+
+// =========================================================================================
+
+/**
+ * @brief Counts the heap allocations of the process.
+ *
+ * The global operator new / operator delete are replaced (AllocCounter.cpp) to
+ * count every call before forwarding it to malloc() / free(). Reading the counter
+ * before and after a piece of code gives the number of allocations it made.
+ */
+class AllocCounter
+{
+	private:
+		AllocCounter();
+		AllocCounter(const AllocCounter& src);
+		AllocCounter& operator=(const AllocCounter& src);
+		~AllocCounter();
+
+	public:
+		static unsigned long allocations;						// Appels à operator new depuis le lancement
+		static unsigned long deallocations;						// Appels à operator delete (pointeur non nul)
+		static unsigned long bytes;								// Octets demandés à operator new depuis le lancement
+};
@@ -0,0 +1,116 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   EpochReclaimer.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <vector>				// container vector (objets retirés)
+#include <cstddef>				// size_t
+
+// =========================================================================================
+
+/**
+ * @brief Epoch-based deferred reclamation of Client and Channel objects.
+ *
+ * Deleting a client or a channel is split in two steps. The loop first unlinks it
+ * (registries, invitations) and hands it to retire(): from then on no new reader can
+ * find it, but a reader that found it before may still be using it. The object is only
+ * destroyed by collect(), at the end of a loop iteration, once every reader that could
+ * have seen it has left its critical section.
+ *
+ * Readers are threads other than the loop (none in the server today). Each one claims
+ * a slot with registerReader(), then wraps each traversal in a Guard: the slot records
+ * the epoch seen when the traversal started. The global epoch only moves forward when
+ * every pinned reader has seen the current one, and an object retired during epoch E
+ * is destroyed once the epoch reaches E + 2. Pinning costs two atomic stores and a load,
+ * without lock. retire() and collect() are for the loop thread only.
+ *
+ * Without any pinned reader, collect() destroys everything retired during the iteration.
+ */
+class EpochReclaimer
+{
+	private:
+		EpochReclaimer();
+		EpochReclaimer(const EpochReclaimer& src);
+		EpochReclaimer& operator=(const EpochReclaimer& src);
+		~EpochReclaimer();
+
+		/**
+		 * @brief State of one reader, alone on its cache line (no false sharing between readers).
+		 */
+		struct Slot
+		{
+			unsigned long claimed;											// 1 si un thread lecteur occupe le slot
+			unsigned long pinned;											// Époque vue en entrant en section critique (0 = hors section)
+			char padding[64 - 2 * sizeof(unsigned long)];
+		};
+
+		/**
+		 * @brief One object waiting for the readers to quiesce.
+		 */
+		struct Retired
+		{
+			void* object;
+			void (*destroy)(void*);											// delete avec le bon type (destructeur + operator delete du pool)
+			unsigned long epoch;											// Époque du retrait
+		};
+
+		static unsigned long _epoch;										// Époque globale (commence à 1, 0 marque un lecteur hors section)
+		static Slot _slots[];												// Slots des lecteurs (reclaim::MAX_READERS)
+		static std::vector<Retired> _retired;								// Objets retirés, dans l'ordre (époques croissantes)
+		static unsigned long _retiredCount, _freedCount;					// Objets retirés / détruits depuis le lancement
+
+		template <typename T>
+		static void _destroy(void* object)
+		{
+			delete static_cast<T*>(object);
+		}
+		static void _retire(void* object, void (*destroy)(void*));			// Ajoute un objet à la liste des retirés
+		static bool _tryAdvance();											// Avance l'époque si tous les lecteurs ont vu la courante
+
+	public:
+
+		/**
+		 * @brief Critical section of a reader: objects seen inside stay valid until it ends.
+		 */
+		class Guard
+		{
+			private:
+				Guard(const Guard& src);
+				Guard& operator=(const Guard& src);
+
+				int _slot;
+
+			public:
+				explicit Guard(int slot);
+				~Guard();
+		};
+
+		// === READERS (ANY THREAD) ===
+		static int registerReader();										// Réserve un slot de lecteur (-1 si tous sont pris)
+		static void unregisterReader(int slot);								// Libère un slot (le lecteur doit être hors section)
+		static void pin(int slot);											// Entre en section critique
+		static void unpin(int slot);										// Sort de section critique
+
+		// === LOOP THREAD ===
+		template <typename T>
+		static void retire(T* object)										// Détruit un objet déjà détaché, quand plus aucun lecteur ne peut le voir
+		{
+			_retire(object, &_destroy<T>);
+		}
+		static size_t collect();											// Détruit les objets que plus aucun lecteur ne peut voir (fin de tour de boucle)
+
+		// === INFOS ===
+		static unsigned long getEpoch();									// Récupère l'époque globale
+		static size_t getPendingCount();									// Récupère le nombre d'objets retirés pas encore détruits
+		static unsigned long getRetiredCount();								// Récupère le nombre d'objets retirés depuis le lancement
+		static unsigned long getFreedCount();								// Récupère le nombre d'objets détruits depuis le lancement
+};
@@ -0,0 +1,216 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HashTable.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 10:12:04 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 10:12:04 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <string>				// std::string
+#include <vector>				// container vector
+#include <cstddef>				// size_t
+
+// =========================================================================================
+
+// === HASH FUNCTIONS ===
+
+/**
+ * @brief FNV-1a hash for strings (keys already casefolded by the caller).
+ */
+struct StringHash
+{
+	size_t operator()(const std::string& key) const
+	{
+		size_t hash = 2166136261u;
+		for (std::string::size_type i = 0; i < key.size(); ++i)
+		{
+			hash ^= static_cast<unsigned char>(key[i]);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+};
+
+/**
+ * @brief Integer mixer (splitmix-style finalizer) for small integer or pointer keys.
+ */
+struct IntegerHash
+{
+	size_t operator()(unsigned long key) const
+	{
+		key ^= key >> 16;
+		key *= 0x45d9f3bUL;
+		key ^= key >> 16;
+		return static_cast<size_t>(key);
+	}
+};
+
+struct PointerHash
+{
+	size_t operator()(const void* key) const
+	{
+		return IntegerHash()(reinterpret_cast<unsigned long>(key) >> 3);
+	}
+};
+
+// =========================================================================================
+
+/**
+ * @brief Open addressing hash table (linear probing, backward-shift deletion).
+ *
+ * C++98 has no std::unordered_map: this table gives O(1) average lookups
+ * with all entries stored in one contiguous vector. The capacity is always
+ * a power of two and the load factor stays under 3/4.
+ *
+ * @note Erasing while iterating is not supported (backward-shift deletion moves entries).
+ */
+template <typename Key, typename Value, typename Hash>
+class HashTable
+{
+	public:
+		struct Entry
+		{
+			Key key;
+			Value value;
+			bool used;
+
+			Entry() : key(), value(), used(false) {}
+		};
+
+		// === ITERATOR (SKIPS EMPTY SLOTS) ===
+		class iterator
+		{
+			public:
+				iterator() : _entries(NULL), _index(0) {}
+				iterator(std::vector<Entry>* entries, size_t index) : _entries(entries), _index(index) { _skip(); }
+
+				Entry& operator*() const { return (*_entries)[_index]; }
+				Entry* operator->() const { return &(*_entries)[_index]; }
+				iterator& operator++() { ++_index; _skip(); return *this; }
+				bool operator==(const iterator& other) const { return _index == other._index; }
+				bool operator!=(const iterator& other) const { return _index != other._index; }
+
+			private:
+				std::vector<Entry>* _entries;
+				size_t _index;
+
+				void _skip() { while (_index < _entries->size() && !(*_entries)[_index].used) ++_index; }
+		};
+
+		HashTable() : _size(0) {}
+
+		// === LOOKUP ===
+		Value* find(const Key& key)
+		{
+			if (_size == 0)
+				return NULL;
+			for (size_t i = _hash(key) & _mask(); ; i = (i + 1) & _mask())
+			{
+				if (!_entries[i].used)
+					return NULL;
+				if (_entries[i].key == key)
+					return &_entries[i].value;
+			}
+		}
+		const Value* find(const Key& key) const
+		{
+			return const_cast<HashTable*>(this)->find(key);
+		}
+		bool contains(const Key& key) const
+		{
+			return find(key) != NULL;
+		}
+
+		// === INSERT (OR REPLACE) ===
+		void insert(const Key& key, const Value& value)
+		{
+			if ((_size + 1) * 4 > _entries.size() * 3)
+				_rehash(_entries.empty() ? 16 : _entries.size() * 2);
+
+			size_t i = _hash(key) & _mask();
+			while (_entries[i].used && !(_entries[i].key == key))
+				i = (i + 1) & _mask();
+
+			if (!_entries[i].used)
+			{
+				_entries[i].key = key;
+				_entries[i].used = true;
+				++_size;
+			}
+			_entries[i].value = value;
+		}
+
+		// === ERASE ===
+		bool erase(const Key& key)
+		{
+			if (_size == 0)
+				return false;
+
+			size_t i = _hash(key) & _mask();
+			while (_entries[i].used && !(_entries[i].key == key))
+				i = (i + 1) & _mask();
+			if (!_entries[i].used)
+				return false;
+
+			// On décale les entrées suivantes du cluster pour ne pas casser les chaînes de sondage
+			size_t hole = i;
+			for (size_t j = (i + 1) & _mask(); _entries[j].used; j = (j + 1) & _mask())
+			{
+				size_t home = _hash(_entries[j].key) & _mask();
+				if (((j - home) & _mask()) >= ((j - hole) & _mask()))
+				{
+					_entries[hole] = _entries[j];
+					hole = j;
+				}
+			}
+			_entries[hole] = Entry();
+			--_size;
+			return true;
+		}
+
+		// === CAPACITY ===
+		void reserve(size_t count)
+		{
+			size_t capacity = 16;
+			while (capacity * 3 < count * 4)
+				capacity *= 2;
+			if (capacity > _entries.size())
+				_rehash(capacity);
+		}
+		void clear()
+		{
+			_entries.clear();
+			_size = 0;
+		}
+		size_t size() const { return _size; }
+		bool empty() const { return _size == 0; }
+		size_t bucketCount() const { return _entries.size(); }
+
+		// === ITERATION ===
+		iterator begin() { return iterator(&_entries, 0); }
+		iterator end() { return iterator(&_entries, _entries.size()); }
+
+	private:
+		std::vector<Entry> _entries;
+		size_t _size;
+		Hash _hash;
+
+		size_t _mask() const { return _entries.size() - 1; }
+
+		void _rehash(size_t capacity)
+		{
+			std::vector<Entry> old;
+			old.swap(_entries);
+			_entries.resize(capacity);
+			_size = 0;
+			for (size_t i = 0; i < old.size(); ++i)
+				if (old[i].used)
+					insert(old[i].key, old[i].value);
+		}
+};
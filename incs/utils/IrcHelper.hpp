@@ -45,20 +45,21 @@ class IrcHelper
 		static bool isValidName(const std::string& name, int type);
 		static std::string formatUsername(const std::string& username);
 
+		// === CASEMAPPING HELPER ===
+		static std::string toIrcLower(const std::string& name);
+
 		// === MESSAGES HELPER ===
-		static std::string sanitizeIrcMessage(std::string msg, const std::string& cmd, const std::string& nickname);
+		static const std::string& sanitizeIrcMessage(const std::string& msg, const std::string& cmd, const std::string& nickname);
 
 		// === CHANNEL HELPER ===
-		static int isRightChannel(const Client& client, const std::string& channelName, std::map<std::string, Channel*>& channels, int opt);
+		static int isRightChannel(const Client& client, const std::string& channelName, const Channel* channel, int opt);
 		static bool isValidChannelName(const std::string& channelName);
 		static std::string fixChannelMask(std::string channelName);
-		static bool channelExists(const std::string& channelName, std::map<std::string, Channel*>& channels);
-		static bool clientExists(int clientFd);
 		
 		// === MODE HELPER ===
 		static int findCharBeforeIndex(const std::string& str, char target1, char target2, size_t startPos);
 		static size_t getExpectedArgCount(std::string mode);
-		static std::map<char, std::string> mapModesToArgs(std::vector<std::string> args);
+		static std::map<char, std::string> mapModesToArgs(const std::vector<std::string>& args);
 		static void assertNoDuplicate(std::string &str, char c, size_t i);
 		static bool noChangeToMake(char modeSign, bool modeEnabled);
 		static bool isValidLimit(std::string &limit);
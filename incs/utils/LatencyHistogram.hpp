@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LatencyHistogram.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <vector>				// container vector (compteurs des buckets)
+#include <ostream>				// std::ostream (export de la distribution)
+#include <cstddef>				// size_t
+
+// =========================================================================================
+
+/**
+ * @brief Log-linear histogram of durations in nanoseconds (HDR-style).
+ *
+ * Each power of two is split into SUB_COUNT linear buckets, so any value is
+ * kept with a relative error under 1 / SUB_COUNT (6.25 %), from 1 ns up to
+ * 2^MAX_BITS ns (about 18 minutes; longer values land in the last bucket).
+ * Recording a value costs a bit scan and an increment, without allocation:
+ * the buckets are allocated once, by the constructor.
+ *
+ * Copyable: kept by value in the per-command counters (cf ServerStats).
+ */
+class LatencyHistogram
+{
+	private:
+		static const int SUB_BITS = 4;										// Buckets linéaires par puissance de deux : 2^SUB_BITS
+		static const unsigned long SUB_COUNT = 1UL << SUB_BITS;
+		static const int MAX_BITS = 40;										// Plus grande puissance de deux suivie
+
+		std::vector<unsigned long> _buckets;								// Nombre de valeurs par bucket
+		unsigned long _count, _max;											// Nombre de valeurs + plus grande valeur exacte
+		unsigned long long _sum;											// Somme des valeurs (moyenne)
+
+		static size_t _indexOf(unsigned long value);						// Bucket d'une valeur
+		static unsigned long _highestOf(size_t index);						// Plus grande valeur d'un bucket
+
+	public:
+		LatencyHistogram();
+		~LatencyHistogram();
+
+		// === RECORD ===
+		void record(unsigned long value);									// Ajoute une durée (ns)
+		void reset();														// Vide l'histogramme
+
+		// === INFOS ===
+		unsigned long getCount() const;										// Récupère le nombre de valeurs
+		unsigned long getMax() const;										// Récupère la plus grande valeur (exacte)
+		unsigned long getMean() const;										// Récupère la moyenne
+		unsigned long long getSum() const;									// Récupère la somme des valeurs
+		unsigned long getPercentile(double percentile) const;				// Récupère la valeur sous laquelle tombe ce pourcentage des valeurs
+
+		// === EXPORT ===
+		void write(std::ostream& out) const;								// Écrit la distribution (un bucket non vide par ligne)
+};
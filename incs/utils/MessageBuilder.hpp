@@ -14,6 +14,7 @@
 
 #include <iostream>			// gestion chaînes de caractères -> std::cout, std::cerr, std::string
 #include <sstream>			// gestion flux -> std::ostringstream
+#include <iomanip>			// format flux -> std::fixed, std::setprecision
 #include <ctime> 			// gestion temps -> std::time_t, std::tm
 #include <vector>			// container vector
 
@@ -69,6 +70,7 @@ class MessageBuilder
 		static std::string ircTimeCreation(const std::string& nickname, const std::string& serverCreationTime);
 		static std::string ircInfos(const std::string& nickname);
 		static std::string ircGlobalUserList(const std::string& nickname, int userCount, int knownCount, int unknownCount, int channelCount);
+		static std::string ircUserCountPeak(const std::string& nickname, int userCount, int maxUserCount, int knownCount, int maxKnownCount);
 		static std::string ircNoNicknameGiven(const std::string& nickname);
 		static std::string ircErroneusNickname(const std::string& nickname, const std::string& enteredNickname);
 		static std::string ircNicknameTaken(const std::string& nickname, const std::string& enteredNickname);
@@ -76,10 +78,11 @@ class MessageBuilder
 		static std::string ircAlreadyRegistered(const std::string& nickname);
 
 		// === RPL MESSAGES ===
-		static std::string ircMsgToChannel(const std::string& nickname, const std::string& channelName, const std::string& message);
-		static std::string ircMsgToClient(const std::string& nickname, const std::string& receiverName, const std::string& message);
-		static std::string ircClientJoinChannel(const std::string& usermask, const std::string& channelName);
-		static std::string ircOpeChangedMode(const std::string& usermask, const std::string& channelName, const std::string& changedMode, const std::string& parameter);
+		// (chemin chaud : écrits dans une chaîne fournie par l'appelant, réutilisable d'une commande à l'autre)
+		static const std::string& ircMsgToChannel(std::string& out, const std::string& nickname, const std::string& channelName, const std::string& message);
+		static const std::string& ircMsgToClient(std::string& out, const std::string& nickname, const std::string& receiverName, const std::string& message);
+		static const std::string& ircClientJoinChannel(std::string& out, const std::string& usermask, const std::string& channelName);
+		static const std::string& ircOpeChangedMode(std::string& out, const std::string& usermask, const std::string& channelName, const std::string& changedMode, const std::string& parameter);
 		static std::string ircTopicMessage(const std::string& usermask, const std::string& channelName, const std::string& topic);
 		static std::string ircClientKickUser(const std::string& usermask, const std::string& channelName, const std::string& kickedUser, const std::string& reason);
 		static std::string ircClientPartChannel(const std::string& usermask, const std::string& channelName, const std::string& reason);
@@ -141,6 +144,32 @@ class MessageBuilder
 		static std::string ircBannedList(const std::string &nickname, const std::string &channel, const std::string &who, time_t time_channel);
 		static std::string ircEndOfBannedList(const std::string &nickname, const std::string &channel);
 
+		// === RPL SERVER STATS (OPERATORS) ===
+		static std::string ircYoureOper(const std::string& nickname);
+		static std::string ircNoOperHost(const std::string& nickname);
+		static std::string ircNoPrivileges(const std::string& nickname);
+		static std::string ircStatsCommand(const std::string& nickname, const std::string& command, unsigned long calls);
+		static std::string ircStatsUptime(const std::string& nickname, time_t uptime);
+		static std::string ircStatsTraffic(const std::string& nickname, const std::string& label, unsigned long inRate, unsigned long inTotal, unsigned long outRate, unsigned long outTotal);
+		static std::string ircStatsConnections(const std::string& nickname, unsigned long accepts, int online, int peak);
+		static std::string ircStatsDisconnections(const std::string& nickname, unsigned long quit, unsigned long timeout, unsigned long sendq, unsigned long recvq, unsigned long closed);
+		static std::string ircStatsChannels(const std::string& nickname, int channelCount, const std::string& largestName, int largestCount);
+		static std::string ircStatsPool(const std::string& nickname, const std::string& type, size_t inUse, size_t peak, size_t capacity, size_t slabCount);
+		static std::string ircStatsQueues(const std::string& nickname, size_t recvQueued, size_t sendQueued, size_t peak);
+		static std::string ircStatsClientMemory(const std::string& nickname, size_t activeCount, size_t activeBytes, size_t hibernatingCount, size_t hibernatingBytes);
+		static std::string ircStatsAllocations(const std::string& nickname, unsigned long allocations, unsigned long deallocations, unsigned long bytes);
+		static std::string ircStatsResolver(const std::string& nickname, size_t pending, size_t cacheSize);
+		static std::string ircStatsShards(const std::string& nickname, size_t shardCount, size_t pending, size_t peak);
+		static std::string ircStatsFanout(const std::string& nickname, size_t threshold, size_t jobs, unsigned long deferred, unsigned long deliveries);
+		static std::string ircStatsReclaimer(const std::string& nickname, unsigned long epoch, size_t pending, unsigned long retired, unsigned long freed);
+		static std::string ircStatsFileCopies(const std::string& nickname, size_t pending, unsigned long bytes);
+		static std::string ircStatsLatency(const std::string& nickname, const std::string& command, unsigned long calls, unsigned long p50, unsigned long p99, unsigned long p999, unsigned long max);
+		static std::string ircStatsMetrics(const std::string& nickname, size_t connections, unsigned long scrapes);
+		static std::string ircStatsLoop(const std::string& nickname, unsigned long ticks, unsigned long slowTicks, unsigned long threshold, unsigned long lag);
+		static std::string ircStatsLoopWindow(const std::string& nickname, unsigned long long duration, unsigned long long busy, unsigned long ticks, unsigned long maxTick, unsigned long readyFds, unsigned long maxReadyFds, unsigned long lines, unsigned long bytesFlushed, unsigned long maxLag);
+		static std::string ircStatsLoopTimes(const std::string& nickname, const std::string& label, unsigned long count, unsigned long p50, unsigned long p99, unsigned long p999, unsigned long max);
+		static std::string ircEndOfStats(const std::string& nickname, char query);
+
 		
 		// =========================================================================================
 
@@ -160,10 +189,20 @@ class MessageBuilder
 
 		// === SETTINGS ===
 		static std::string msgSignalCaught(const std::string& signalType);
+		static std::string msgPoolOccupancy(const std::string& type, size_t inUse, size_t peak, size_t capacity, size_t slabCount);
+		static std::string msgQueueMemory(size_t recvQueued, size_t sendQueued, size_t peak);
+		static std::string msgClientMemory(size_t activeCount, size_t activeBytes, size_t hibernatingCount, size_t hibernatingBytes);
+		static std::string msgChannelShards(size_t shardCount, size_t pending, size_t peak);
+		static std::string msgFanout(size_t threshold, unsigned long deferred, unsigned long deliveries);
+		static std::string msgLatencyFile(const std::string& path, bool written);
+		static std::string msgMetricsEndpoint(int port);
+		static std::string msgSlowTick(unsigned long duration, unsigned long threshold, int readyFds, unsigned long lines, unsigned long bytesFlushed, unsigned long lag, unsigned long unreported);
+		static std::string msgSlowTickCulprits(const std::string& work, unsigned long workTime, const std::string& command, const std::string& commandClient, unsigned long commandTime);
 		
 		// === CLIENTS ===
 		static std::string msgClientConnected(const std::string& clientIp, int port, int socket, const std::string& nickname);
 		static std::string msgClientDisconnected(const std::string& clientIp, int port, int socket, const std::string& nickname);
+		static std::string msgClientIsServerOperator(const std::string& nickname);
 
 		// === CHANNELS ===
 		static std::string msgClientCreatedChannel(const std::string& nickname, const std::string& channelName, const std::string& password);
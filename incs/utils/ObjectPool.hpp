@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ObjectPool.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 15:47:30 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 15:47:30 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <vector>				// container vector
+#include <new>					// ::operator new / ::operator delete
+#include <cstddef>				// size_t
+
+// =========================================================================================
+
+/**
+ * @brief Slab allocator with a free list for objects of one type.
+ *
+ * Memory is taken from the system by slabs of several slots and never given
+ * back before the pool is destroyed: a freed slot goes to the free list and is
+ * reused by the next allocation. Connect/disconnect or join/part churn therefore
+ * reuses the same memory instead of fragmenting the heap, and the footprint is
+ * bounded by the peak population. The pool only manages raw memory, objects are
+ * constructed and destroyed by the class operator new / operator delete using it.
+ */
+template <typename T>
+class ObjectPool
+{
+	private:
+		// Un slot libre sert de maillon de la free list, un slot occupé contient l'objet
+		union Slot
+		{
+			Slot* next;
+			char storage[sizeof(T)];
+			long double alignLongDouble;
+			long alignLong;
+			void* alignPointer;
+		};
+
+		ObjectPool(const ObjectPool& src);
+		ObjectPool& operator=(const ObjectPool& src);
+
+		std::vector<Slot*> _slabs;									// Blocs alloués
+		Slot* _freeList;											// Premier slot libre
+		size_t _capacity, _inUse, _peak;							// Slots alloués, occupés, et pic d'occupation
+
+		void _grow(size_t count)
+		{
+			Slot* slab = static_cast<Slot*>(::operator new(count * sizeof(Slot)));
+			_slabs.push_back(slab);
+
+			// Chaînage des nouveaux slots en tête de la free list
+			for (size_t i = count; i > 0; --i)
+			{
+				slab[i - 1].next = _freeList;
+				_freeList = &slab[i - 1];
+			}
+			_capacity += count;
+		}
+
+	public:
+		ObjectPool() : _freeList(NULL), _capacity(0), _inUse(0), _peak(0) {}
+		~ObjectPool()
+		{
+			for (size_t i = 0; i < _slabs.size(); ++i)
+				::operator delete(_slabs[i]);
+		}
+
+		// === CAPACITY ===
+		void reserve(size_t count)
+		{
+			if (count > _capacity)
+				_grow(count - _capacity);
+		}
+
+		// === ALLOCATION ===
+		void* allocate()
+		{
+			// Pool plein : nouveau bloc de la taille de la capacité actuelle (croissance géométrique)
+			if (!_freeList)
+				_grow(_capacity < 16 ? 16 : _capacity);
+
+			Slot* slot = _freeList;
+			_freeList = slot->next;
+			if (++_inUse > _peak)
+				_peak = _inUse;
+			return slot;
+		}
+		void deallocate(void* ptr)
+		{
+			if (!ptr)
+				return;
+			Slot* slot = static_cast<Slot*>(ptr);
+			slot->next = _freeList;
+			_freeList = slot;
+			--_inUse;
+		}
+
+		// === INFOS ===
+		size_t capacity() const { return _capacity; }
+		size_t inUse() const { return _inUse; }
+		size_t peak() const { return _peak; }
+		size_t slabCount() const { return _slabs.size(); }
+};
@@ -0,0 +1,65 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ScratchArena.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 17:05:12 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 17:05:12 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <string>				// std::string
+#include <vector>				// container vector
+#include <deque>				// container deque (adresses stables à l'ajout)
+#include <cstddef>				// size_t
+
+// =========================================================================================
+
+/**
+ * @brief Per-command arena of temporary strings and token lists.
+ *
+ * Parsing a command and building its replies needs many short-lived strings.
+ * Instead of allocating and freeing them for every command, they are borrowed
+ * from this arena and all given back at once by reset(), which runs at the end
+ * of every command (Command::~Command()) and of every loop iteration.
+ * Borrowed objects keep the capacity they reached, so a steady stream of
+ * commands reuses the same memory without calling malloc().
+ *
+ * A borrowed string or list must not be kept after the end of the command:
+ * anything stored in a client or a channel is copied into its own std::string.
+ */
+class ScratchArena
+{
+	private:
+		ScratchArena();
+		ScratchArena(const ScratchArena& src);
+		ScratchArena& operator=(const ScratchArena& src);
+		~ScratchArena();
+
+		static std::deque<std::string> _strings;							// Chaînes de l'arène
+		static std::deque<std::vector<std::string> > _lists;				// Listes de tokens de l'arène
+		static std::vector<std::string> _spareTokens;						// Chaînes libres réutilisées comme tokens (capacité conservée)
+		static size_t _usedStrings, _usedLists;								// Nombre d'objets prêtés depuis le dernier reset
+
+		static void _pushToken(std::vector<std::string>& tokens, const std::string& s, size_t pos, size_t length);
+
+	public:
+
+		// === BORROWING ===
+		static std::string& string();										// Prête une chaîne vide jusqu'au prochain reset
+		static std::vector<std::string>& tokens();							// Prête une liste vide jusqu'au prochain reset
+
+		// === TOKENIZER ===
+		static std::vector<std::string>& split(const std::string& s, int opt);					// Découpe comme Utils::getTokens() dans une liste prêtée
+		static void split(const std::string& s, int opt, std::vector<std::string>& tokens);	// Découpe dans une liste déjà prêtée
+
+		// === RESET ===
+		static void reset();												// Rend tous les objets prêtés (fin de commande, fin de tour de boucle)
+
+		// === INFOS ===
+		static size_t footprint();											// Nombre d'objets (chaînes + listes + tokens libres) gardés par l'arène
+};
@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   StringPool.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 15:04:12 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 15:04:12 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <string>				// std::string
+#include <vector>				// container vector
+
+#include "HashTable.hpp"		// table de hachage (chaîne -> symbole)
+
+// =========================================================================================
+
+typedef unsigned int Symbol;	// Identifiant d'une chaîne internée, 0 = aucun symbole
+
+/**
+ * @brief Interning pool for identifiers (casefolded nicknames and channel names).
+ *
+ * Each distinct string is stored once and designated by a small integer symbol:
+ * indexes and membership maps compare and hash symbols instead of strings.
+ * Symbols are reference counted, an identifier released by all its users
+ * (nickname change, channel destroyed) frees its slot for a future string.
+ */
+class StringPool
+{
+	private:
+		struct Entry
+		{
+			std::string str;
+			unsigned int refs;
+
+			Entry() : refs(0) {}
+		};
+
+		StringPool();
+		StringPool(const StringPool& src);
+		StringPool& operator=(const StringPool& src);
+		~StringPool();
+
+		static HashTable<std::string, Symbol, StringHash> _symbols;		// Chaîne -> symbole
+		static std::vector<Entry> _entries;								// Symbole -> chaîne (l'indice 0 est réservé)
+		static std::vector<Symbol> _freeSymbols;						// Symboles libérés, réutilisables
+
+	public:
+
+		// === INTERNING ===
+		static Symbol intern(const std::string& str);
+		static void release(Symbol symbol);
+
+		// === LOOKUP ===
+		static Symbol find(const std::string& str);
+		static const std::string& str(Symbol symbol);
+
+		// === INFOS ===
+		static size_t size();
+};
@@ -0,0 +1,223 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ClientLayoutBench.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 16:32:08 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 16:32:08 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <iostream>				// std::cout
+#include <sstream>				// std::ostringstream
+#include <vector>				// container vector
+#include <map>					// container map
+#include <cstdlib>				// std::atoi
+#include <ctime>				// time()
+#include <sys/time.h>			// gettimeofday()
+
+#include "Client.hpp"
+#include "ObjectPool.hpp"
+#include "StringPool.hpp"
+
+// === NAMESPACES ===
+#include "irc_config.hpp"
+
+// =========================================================================================
+
+/**
+ * @file ClientLayoutBench.cpp
+ * @brief Compares an activity scan over clients with the former and the current Client layout.
+ *
+ * LegacyClient stores the fields of Client inline, as before the hot/cold split (all strings,
+ * vectors and booleans in the object). Both kinds of objects are allocated from an ObjectPool
+ * and filled with the same data, so only the layout differs. Clients are filled like the
+ * server does it: address and port at accept, then the registration fields; the bench fails
+ * if the accept step allocated a cold record.
+ * The scan reads what Server::_checkActivity() reads: the deletion flag, the last activity,
+ * the hibernation flag and wake-up time, and the PING flag.
+ *
+ * Usage: ./bin/bench/ClientLayoutBench [clients] [passes]
+ */
+
+// =========================================================================================
+
+// === FORMER CLIENT LAYOUT ===
+
+class LegacyClient
+{
+	private:
+		int _clientSocketFd, _port;
+		bool _isIrssi, _isIdentified, _authenticated, _rightPassServ;
+		std::vector<std::string> _identNicknameCmd, _identUsernameCmd;
+		std::string _nickname, _username, _realName, _hostname, _clientIp, _usermask;
+		Symbol _nicknameKey;
+		std::string _bufferMessage;
+		std::string _awayMessage;
+		time_t _signonTime, _lastActivity;
+		bool _isAway, _errorMsgTooLongSent, _pingSent;
+		bool _markedForDeletion, _isHibernating;
+		time_t _wakeTime;
+		unsigned long _fanoutStamp;
+		std::map<Symbol, Channel*> _channelsJoined;
+		std::map<Symbol, Channel*> _channelsInvited;
+
+	public:
+		static ObjectPool<LegacyClient> pool;
+
+		LegacyClient(int fd, const std::string& nickname) :
+			_clientSocketFd(fd), _port(0), _isIrssi(false), _isIdentified(false), _authenticated(true), _rightPassServ(true),
+			_nickname(nickname), _username("~" + nickname), _realName("Real name of " + nickname),
+			_hostname("host-" + nickname + ".example.org"), _clientIp("127.0.0.1"),
+			_usermask(nickname + "!~" + nickname + "@127.0.0.1"), _nicknameKey(0),
+			_signonTime(time(NULL)), _lastActivity(time(NULL)),
+			_isAway(false), _errorMsgTooLongSent(false), _pingSent(false), _markedForDeletion(false),
+			_isHibernating(false), _wakeTime(0), _fanoutStamp(0) {}
+
+		static void* operator new(size_t size) { (void) size; return pool.allocate(); }
+		static void operator delete(void* ptr) { pool.deallocate(ptr); }
+
+		// Accesseurs hors ligne, comme ceux de Client (définis dans Client_Attributes.cpp)
+		time_t getLastActivity() const __attribute__((noinline));
+		bool pingSent() const __attribute__((noinline));
+		bool isMarkedForDeletion() const __attribute__((noinline));
+		bool isHibernating() const __attribute__((noinline));
+		time_t getWakeTime() const __attribute__((noinline));
+};
+
+ObjectPool<LegacyClient> LegacyClient::pool;
+
+time_t LegacyClient::getLastActivity() const { return _lastActivity; }
+bool LegacyClient::pingSent() const { return _pingSent; }
+bool LegacyClient::isMarkedForDeletion() const { return _markedForDeletion; }
+bool LegacyClient::isHibernating() const { return _isHibernating; }
+time_t LegacyClient::getWakeTime() const { return _wakeTime; }
+
+
+// =========================================================================================
+
+// === BENCH HELPERS ===
+
+static double nowMs()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+static std::string makeNickname(int i)
+{
+	std::ostringstream stream;
+	stream << "user" << i;
+	return stream.str();
+}
+
+/**
+ * @brief Activity scan as done by Server::_checkActivity(), on any client type.
+ *
+ * @return The number of clients that would hibernate or receive a PING (to keep the scan observable).
+ */
+template <typename T>
+static size_t scanActivity(const std::vector<T*>& clients, time_t now)
+{
+	size_t toWatch = 0;
+	for (typename std::vector<T*>::const_iterator it = clients.begin(); it != clients.end(); ++it)
+	{
+		const T* client = *it;
+		if (client->isMarkedForDeletion())
+			continue;
+		time_t idleTime = now - client->getLastActivity();
+		if (!client->isHibernating() && idleTime > server::HIBERNATE_DELAY
+			&& now - client->getWakeTime() > server::HIBERNATE_DELAY)
+			toWatch++;
+		if (!client->pingSent() && idleTime > server::PING_INTERVAL)
+			toWatch++;
+	}
+	return toWatch;
+}
+
+template <typename T>
+static double timeScans(const std::vector<T*>& clients, int passes, size_t& checksum)
+{
+	time_t now = time(NULL) + 300;
+	double start = nowMs();
+	for (int pass = 0; pass < passes; ++pass)
+		checksum += scanActivity(clients, now);
+	return nowMs() - start;
+}
+
+
+// =========================================================================================
+
+// === MAIN ===
+
+int main(int argc, char **argv)
+{
+	int clientCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+	int passes = argc > 2 ? std::atoi(argv[2]) : 200;
+	if (clientCount <= 0 || passes <= 0)
+	{
+		std::cerr << "Usage: " << argv[0] << " [clients] [passes]" << std::endl;
+		return 1;
+	}
+
+	// Même population pour les deux dispositions
+	std::vector<LegacyClient*> legacyClients;
+	std::vector<Client*> clients;
+	LegacyClient::pool.reserve(clientCount);
+	Client::getPool().reserve(clientCount);
+	for (int i = 0; i < clientCount; ++i)
+	{
+		legacyClients.push_back(new LegacyClient(i + 4, makeNickname(i)));
+
+		// Comme Server::_acceptNewClient() : adresse et port seulement
+		Client* client = new Client(i + 4);
+		client->setClientIp("127.0.0.1");
+		client->setClientPort(40000 + i % 20000);
+		clients.push_back(client);
+	}
+
+	// L'accept ne doit pas allouer de partie froide
+	size_t coldAtAccept = Client::getDetailsPool().inUse();
+	if (coldAtAccept != 0)
+	{
+		std::cerr << "FAIL: " << coldAtAccept << " cold records allocated at accept" << std::endl;
+		return 1;
+	}
+
+	// Puis l'enregistrement (NICK, USER) écrit les champs froids
+	for (int i = 0; i < clientCount; ++i)
+	{
+		std::string nickname = makeNickname(i);
+		Client* client = clients[i];
+		client->setNickname(nickname);
+		client->setUsername("~" + nickname);
+		client->setRealName("Real name of " + nickname);
+		client->setHostname("host-" + nickname + ".example.org");
+		client->setUsermask();
+		client->authenticate();
+	}
+
+	size_t checksum = 0;
+	timeScans(legacyClients, 1, checksum);	// Chauffe
+	timeScans(clients, 1, checksum);
+	double legacyMs = timeScans(legacyClients, passes, checksum);
+	double currentMs = timeScans(clients, passes, checksum);
+
+	double scanned = static_cast<double>(clientCount) * passes;
+	std::cout << "clients: " << clientCount << ", passes: " << passes
+		<< ", cold records at accept: " << coldAtAccept << std::endl;
+	std::cout << "legacy  layout: sizeof " << sizeof(LegacyClient) << " B, "
+		<< legacyMs << " ms, " << (scanned / legacyMs / 1000.0) << " M clients/s" << std::endl;
+	std::cout << "hot/cold layout: sizeof " << sizeof(Client) << " B (+ " << sizeof(ClientDetails) << " B cold), "
+		<< currentMs << " ms, " << (scanned / currentMs / 1000.0) << " M clients/s" << std::endl;
+	std::cout << "speedup: " << (legacyMs / currentMs) << "x (checksum " << checksum << ")" << std::endl;
+
+	for (size_t i = 0; i < legacyClients.size(); ++i)
+		delete legacyClients[i];
+	for (size_t i = 0; i < clients.size(); ++i)
+		delete clients[i];
+	return 0;
+}
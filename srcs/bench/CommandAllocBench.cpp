@@ -0,0 +1,194 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CommandAllocBench.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 17:05:12 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 17:05:12 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <iostream>				// std::cout
+#include <sstream>				// std::ostringstream
+#include <vector>				// container vector
+#include <cstdlib>				// std::atoi
+#include <sys/socket.h>			// socketpair()
+#include <sys/time.h>			// gettimeofday()
+#include <fcntl.h>				// fcntl() -> O_NONBLOCK
+#include <unistd.h>				// read(), close()
+
+#include "Server.hpp"
+#include "Client.hpp"
+#include "Command.hpp"
+#include "AllocCounter.hpp"
+#include "EpochReclaimer.hpp"
+
+// =========================================================================================
+
+/**
+ * @file CommandAllocBench.cpp
+ * @brief Counts the heap allocations made by steady-state IRC commands.
+ *
+ * A Server instance is created (its socket is bound but its loop never runs) and
+ * registered clients are attached to it through socket pairs: commands are executed
+ * exactly as Server::_processCommand() does, and everything sent to the clients is
+ * read back and discarded on the other end of the pairs.
+ * For each scenario, the command is repeated to reach a steady state, then the
+ * global allocation counter (AllocCounter) is read around a measured run.
+ *
+ * Usage: ./bin/bench/CommandAllocBench [port] [iterations]
+ */
+
+// =========================================================================================
+
+// === BENCH HELPERS ===
+
+static std::vector<int> peers;	// Extrémités des paires de sockets côté "client réseau"
+
+static double nowUs()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+static void drainPeers()
+{
+	char buffer[65536];
+	for (size_t i = 0; i < peers.size(); ++i)
+		while (read(peers[i], buffer, sizeof(buffer)) > 0)
+			;
+}
+
+/**
+ * @brief Executes one command line for a client, as Server::_processCommand() does,
+ *        then destroys what it deleted, as the end of a loop iteration does.
+ */
+static void runCommand(Server& server, Client* client, const std::string& line)
+{
+	try
+	{
+		Command handler(server, client);
+		handler.manageCommand(line);
+	}
+	catch (const std::exception &e)
+	{
+		client->sendMessage(e.what(), NULL);
+	}
+	EpochReclaimer::collect();
+}
+
+static Client* addClient(Server& server, const std::string& nickname)
+{
+	int fds[2];
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1)
+		throw std::runtime_error("socketpair() failed");
+	fcntl(fds[0], F_SETFL, O_NONBLOCK);
+	fcntl(fds[1], F_SETFL, O_NONBLOCK);
+	peers.push_back(fds[1]);
+
+	Client* client = new Client(fds[0]);
+	server.getClients().add(client);
+	server.setClientNickname(client, nickname);
+	client->setUsername(nickname);
+	client->setRealName("Bench " + nickname);
+	client->setClientIp("127.0.0.1");
+	client->setUsermask();
+	server.authenticateClient(client);
+	return client;
+}
+
+/**
+ * @brief Runs a cycle of command lines until a steady state, then measures it.
+ */
+static void measure(Server& server, Client* client, const std::string& name,
+	const std::vector<std::string>& cycle, int iterations)
+{
+	for (int i = 0; i < 200; ++i)
+	{
+		runCommand(server, client, cycle[i % cycle.size()]);
+		if (i % 32 == 0)
+			drainPeers();
+	}
+	drainPeers();
+
+	unsigned long mallocs = 0;
+	double elapsed = 0;
+	for (int i = 0; i < iterations; ++i)
+	{
+		unsigned long before = AllocCounter::allocations;
+		double start = nowUs();
+		runCommand(server, client, cycle[i % cycle.size()]);
+		elapsed += nowUs() - start;
+		mallocs += AllocCounter::allocations - before;
+
+		// La lecture côté pair ne compte pas dans la mesure
+		if (i % 32 == 0)
+			drainPeers();
+	}
+	drainPeers();
+
+	std::cout << "  " << name << ": " << static_cast<double>(mallocs) / iterations << " allocations/command, "
+		<< elapsed / iterations << " us/command" << std::endl;
+}
+
+static std::vector<std::string> makeCycle(const std::string& first, const std::string& second)
+{
+	std::vector<std::string> cycle;
+	cycle.push_back(first);
+	if (!second.empty())
+		cycle.push_back(second);
+	return cycle;
+}
+
+
+// =========================================================================================
+
+// === MAIN ===
+
+int main(int argc, char **argv)
+{
+	std::string port = argc > 1 ? argv[1] : "6798";
+	int iterations = argc > 2 ? std::atoi(argv[2]) : 20000;
+	if (iterations <= 0)
+	{
+		std::cerr << "Usage: " << argv[0] << " [port] [iterations]" << std::endl;
+		return 1;
+	}
+
+	try
+	{
+		Server server(port, "bench42");
+
+		// Un canal de 8 membres, alice en est l'opératrice
+		std::vector<Client*> clients;
+		const char* nicknames[] = {"alice", "bob", "carol", "dave", "erin", "frank", "grace", "heidi"};
+		for (size_t i = 0; i < sizeof(nicknames) / sizeof(*nicknames); ++i)
+		{
+			clients.push_back(addClient(server, nicknames[i]));
+			runCommand(server, clients.back(), "JOIN #bench");
+		}
+		drainPeers();
+		Client* alice = clients[0];
+
+		std::cout << "\nsteady-state allocations (" << iterations << " commands per scenario):" << std::endl;
+		measure(server, alice, "PRIVMSG #bench (8 members)", makeCycle("PRIVMSG #bench :hello everyone, how are you?", ""), iterations);
+		measure(server, alice, "PRIVMSG bob", makeCycle("PRIVMSG bob :hello bob, how are you?", ""), iterations);
+		measure(server, alice, "JOIN #bench (already in)", makeCycle("JOIN #bench", ""), iterations);
+		measure(server, clients[1], "JOIN / PART #other", makeCycle("JOIN #other", "PART #other"), iterations);
+		measure(server, alice, "MODE #bench +t / -t", makeCycle("MODE #bench +t", "MODE #bench -t"), iterations);
+		measure(server, alice, "MODE #bench (query)", makeCycle("MODE #bench", ""), iterations);
+		std::cout << std::endl;
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	for (size_t i = 0; i < peers.size(); ++i)
+		close(peers[i]);
+	return 0;
+}
@@ -0,0 +1,306 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   EpochReclaimerBench.cpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <iostream>				// std::cout, std::cerr
+#include <string>				// std::string
+#include <vector>				// container vector
+#include <cstdlib>				// std::atoi
+#include <stdexcept>			// std::runtime_error
+#include <ctime>				// clock_gettime()
+#include <pthread.h>			// threads lecteurs, rwlock
+#include <sched.h>				// sched_yield()
+#include <unistd.h>				// sysconf()
+
+#include "EpochReclaimer.hpp"
+
+// =========================================================================================
+
+/**
+ * @file EpochReclaimerBench.cpp
+ * @brief Stress test of the deferred reclamation (EpochReclaimer), against a read-write lock.
+ *
+ * A registry of REGISTRY_SIZE pointers to records stands for the client table. The main
+ * thread plays the server loop: it replaces records one by one, retires the old ones and
+ * calls collect() every TICK replacements, as at the end of a loop iteration. R reader
+ * threads traverse the whole registry inside a Guard, without lock, and check every record
+ * they find: a record destroyed while a reader could still see it is reported (its
+ * destructor overwrites its tag), or caught by the sanitizer.
+ *
+ * The reference run protects the same registry with a pthread read-write lock (writer
+ * preferred): readers take it shared, the loop takes it exclusive to replace a record and
+ * deletes the old one at once.
+ *
+ * Build with `make bench-tsan` to run it under ThreadSanitizer. The results are printed
+ * as a single JSON object; the exit status is 1 if a reader saw a destroyed record.
+ *
+ * Usage: ./bin/bench/EpochReclaimerBench [replacements] [max readers]
+ */
+
+// =========================================================================================
+
+// === REGISTRY UNDER TEST ===
+
+static const size_t REGISTRY_SIZE = 256;
+static const int TICK = 64;
+static const unsigned long ALIVE = 0xA11CEUL;
+static const unsigned long DEAD = 0xDEADUL;
+
+/**
+ * @brief A registry entry: its tag says if it is still alive, its checksum if it is intact.
+ */
+struct Record
+{
+	unsigned long tag;
+	unsigned long id;
+	unsigned long checksum;
+	std::string name;
+
+	explicit Record(unsigned long id) : tag(ALIVE), id(id), checksum(id * 7 + 3), name(32, 'r') {}
+	~Record()
+	{
+		__atomic_store_n(&tag, DEAD, __ATOMIC_RELAXED);
+	}
+};
+
+static bool isIntact(const Record* record)
+{
+	return __atomic_load_n(&record->tag, __ATOMIC_RELAXED) == ALIVE
+		&& record->checksum == record->id * 7 + 3 && record->name.size() == 32;
+}
+
+/**
+ * @brief State shared by the loop thread and the readers of one run.
+ */
+struct Shared
+{
+	Record* registry[REGISTRY_SIZE];
+	pthread_rwlock_t lock;
+	int stop;
+	int started;
+};
+
+struct ReaderArgs
+{
+	Shared* shared;
+	bool useLock;
+	unsigned long traversals;
+	unsigned long violations;
+};
+
+/**
+ * @brief Result of one run (one scheme, one number of readers).
+ */
+struct RunResult
+{
+	std::string scheme;
+	int readers;
+	unsigned long replacements;
+	double seconds;
+	unsigned long traversals;
+	unsigned long violations;
+	size_t peakPending;
+};
+
+static double now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+// =========================================================================================
+
+// === THREADS ===
+
+/**
+ * @brief Reader thread: traverses the registry again and again until the loop stops.
+ */
+static void* readRegistry(void* data)
+{
+	ReaderArgs* args = static_cast<ReaderArgs*>(data);
+	Shared* shared = args->shared;
+
+	int slot = -1;
+	if (!args->useLock && (slot = EpochReclaimer::registerReader()) == -1)
+		return NULL;
+	__atomic_add_fetch(&shared->started, 1, __ATOMIC_RELEASE);
+
+	while (!__atomic_load_n(&shared->stop, __ATOMIC_ACQUIRE))
+	{
+		if (args->useLock)
+			pthread_rwlock_rdlock(&shared->lock);
+		else
+			EpochReclaimer::pin(slot);
+
+		for (size_t i = 0; i < REGISTRY_SIZE; ++i)
+		{
+			Record* record = __atomic_load_n(&shared->registry[i], __ATOMIC_ACQUIRE);
+			if (!record)
+				continue;
+			if (!isIntact(record))
+				args->violations++;
+		}
+
+		if (args->useLock)
+			pthread_rwlock_unlock(&shared->lock);
+		else
+			EpochReclaimer::unpin(slot);
+		args->traversals++;
+	}
+
+	if (!args->useLock)
+		EpochReclaimer::unregisterReader(slot);
+	return NULL;
+}
+
+/**
+ * @brief Runs R readers against the loop thread replacing records.
+ */
+static RunResult run(bool useLock, int readers, unsigned long replacements)
+{
+	Shared shared;
+	shared.stop = 0;
+	shared.started = 0;
+
+	// Priorité à l'écrivain : sinon des lecteurs qui se relaient affament la boucle (verrou par défaut de la glibc)
+	pthread_rwlockattr_t attr;
+	pthread_rwlockattr_init(&attr);
+	pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+	pthread_rwlock_init(&shared.lock, &attr);
+	pthread_rwlockattr_destroy(&attr);
+	for (size_t i = 0; i < REGISTRY_SIZE; ++i)
+		shared.registry[i] = new Record(i);
+
+	std::vector<pthread_t> threads(readers);
+	std::vector<ReaderArgs> args(readers);
+	for (int i = 0; i < readers; ++i)
+	{
+		args[i].shared = &shared;
+		args[i].useLock = useLock;
+		args[i].traversals = 0;
+		args[i].violations = 0;
+		if (pthread_create(&threads[i], NULL, &readRegistry, &args[i]) != 0)
+			throw std::runtime_error("pthread_create() failed");
+	}
+	while (__atomic_load_n(&shared.started, __ATOMIC_ACQUIRE) < readers)
+		sched_yield();
+
+	RunResult result;
+	result.scheme = useLock ? "rwlock_delete" : "epoch_retire";
+	result.readers = readers;
+	result.replacements = replacements;
+	result.peakPending = 0;
+
+	// Boucle du serveur : remplace les entrées, retire les anciennes, collecte à chaque « tour »
+	double begin = now();
+	for (unsigned long n = 0; n < replacements; ++n)
+	{
+		size_t index = n % REGISTRY_SIZE;
+		Record* fresh = new Record(REGISTRY_SIZE + n);
+		if (useLock)
+		{
+			pthread_rwlock_wrlock(&shared.lock);
+			Record* old = shared.registry[index];
+			__atomic_store_n(&shared.registry[index], fresh, __ATOMIC_RELEASE);
+			pthread_rwlock_unlock(&shared.lock);
+			delete old;
+			continue;
+		}
+		Record* old = __atomic_exchange_n(&shared.registry[index], fresh, __ATOMIC_ACQ_REL);
+		EpochReclaimer::retire(old);
+		if (n % TICK == TICK - 1)
+		{
+			if (EpochReclaimer::getPendingCount() > result.peakPending)
+				result.peakPending = EpochReclaimer::getPendingCount();
+			EpochReclaimer::collect();
+		}
+	}
+	result.seconds = now() - begin;
+
+	__atomic_store_n(&shared.stop, 1, __ATOMIC_RELEASE);
+	result.traversals = 0;
+	result.violations = 0;
+	for (int i = 0; i < readers; ++i)
+	{
+		pthread_join(threads[i], NULL);
+		result.traversals += args[i].traversals;
+		result.violations += args[i].violations;
+	}
+
+	// Plus aucun lecteur : tout ce qui reste retiré est détruit
+	while (EpochReclaimer::getPendingCount() > 0)
+		EpochReclaimer::collect();
+	for (size_t i = 0; i < REGISTRY_SIZE; ++i)
+		delete shared.registry[i];
+	pthread_rwlock_destroy(&shared.lock);
+	return result;
+}
+
+static void printResult(const RunResult& result, bool last)
+{
+	std::cout << "    {\"scheme\": \"" << result.scheme << "\", \"readers\": " << result.readers
+		<< ", \"replacements\": " << result.replacements << ", \"seconds\": " << result.seconds
+		<< ", \"ns_per_replacement\": " << (result.replacements ? result.seconds * 1e9 / result.replacements : 0)
+		<< ", \"reader_traversals_per_second\": " << (result.seconds > 0 ? result.traversals / result.seconds : 0)
+		<< ", \"peak_pending\": " << result.peakPending
+		<< ", \"violations\": " << result.violations
+		<< "}" << (last ? "" : ",") << std::endl;
+}
+
+
+// =========================================================================================
+
+// === MAIN ===
+
+int main(int argc, char **argv)
+{
+	int replacements = argc > 1 ? std::atoi(argv[1]) : 200000;
+	int maxReaders = argc > 2 ? std::atoi(argv[2]) : 8;
+	if (replacements <= 0 || maxReaders <= 0)
+	{
+		std::cerr << "Usage: " << argv[0] << " [replacements] [max readers]" << std::endl;
+		return 1;
+	}
+
+	std::vector<RunResult> results;
+	unsigned long violations = 0;
+	try
+	{
+		for (int readers = 1; readers <= maxReaders; readers *= 2)
+		{
+			results.push_back(run(false, readers, replacements));
+			results.push_back(run(true, readers, replacements));
+		}
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	std::cout << "{" << std::endl;
+	std::cout << "  \"bench\": \"epoch_reclaimer\"," << std::endl;
+	std::cout << "  \"cpus\": " << sysconf(_SC_NPROCESSORS_ONLN) << ", \"registry_size\": " << REGISTRY_SIZE
+		<< ", \"replacements_per_collect\": " << TICK << "," << std::endl;
+	std::cout << "  \"runs\": [" << std::endl;
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		printResult(results[i], i + 1 == results.size());
+		violations += results[i].violations;
+	}
+	std::cout << "  ]," << std::endl;
+	std::cout << "  \"retired\": " << EpochReclaimer::getRetiredCount() << ", \"freed\": " << EpochReclaimer::getFreedCount()
+		<< ", \"final_epoch\": " << EpochReclaimer::getEpoch() << std::endl;
+	std::cout << "}" << std::endl;
+	return violations == 0 ? 0 : 1;
+}
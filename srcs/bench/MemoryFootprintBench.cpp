@@ -0,0 +1,279 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MemoryFootprintBench.cpp                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <iostream>				// std::cout, std::cerr
+#include <fstream>				// std::ifstream, std::ofstream
+#include <vector>				// container vector
+#include <cstdlib>				// std::atoi
+#include <sys/socket.h>			// socketpair()
+#include <sys/resource.h>		// setrlimit() -> RLIMIT_NOFILE
+#include <fcntl.h>				// fcntl() -> O_NONBLOCK
+#include <unistd.h>				// read(), close(), sysconf()
+#ifdef __GLIBC__
+# include <malloc.h>			// mallinfo2() -> octets alloués par malloc
+#endif
+
+#include "Server.hpp"
+#include "Client.hpp"
+#include "Channel.hpp"
+#include "Command.hpp"
+#include "AllocCounter.hpp"
+
+// =========================================================================================
+
+/**
+ * @file MemoryFootprintBench.cpp
+ * @brief Measures the memory used per connection, per channel and per channel membership.
+ *
+ * A Server instance is created (its socket is bound but its loop never runs) and N
+ * registered clients are attached to it through socket pairs, exactly as in
+ * CommandAllocBench. Channels and memberships are then created with real JOIN commands,
+ * so Client, Channel and Server objects are the production ones.
+ *
+ * A snapshot (resident set size, heap bytes in use, live allocations) is taken after
+ * each phase, and the difference between two snapshots is divided by the number of
+ * entities created in the phase. The last phase puts every client into hibernation.
+ * Server logs are silenced; the results are printed as a single JSON object
+ * so that runs can be compared by scripts.
+ *
+ * Usage: ./bin/bench/MemoryFootprintBench [port] [clients] [channels] [joins per client]
+ */
+
+// =========================================================================================
+
+// === BENCH HELPERS ===
+
+static std::vector<int> peers;	// Extrémités des paires de sockets côté "client réseau"
+
+/**
+ * @brief Memory state of the process at one point of the bench.
+ */
+struct Snapshot
+{
+	std::string phase;
+	long rssBytes;						// Mémoire résidente (/proc/self/statm)
+	long heapBytes;						// Octets alloués par malloc et pas encore libérés (glibc)
+	long liveAllocations;				// Allocations C++ pas encore libérées (AllocCounter)
+};
+
+static long residentBytes()
+{
+	long pages = 0, resident = 0;
+	std::ifstream statm("/proc/self/statm");
+	if (!(statm >> pages >> resident))
+		return 0;
+	return resident * sysconf(_SC_PAGESIZE);
+}
+
+static long heapBytes()
+{
+#ifdef __GLIBC__
+	struct mallinfo2 info = mallinfo2();
+	return static_cast<long>(info.uordblks + info.hblkhd);
+#else
+	return 0;
+#endif
+}
+
+static Snapshot takeSnapshot(const std::string& phase)
+{
+	Snapshot snapshot;
+	snapshot.phase = phase;
+	snapshot.rssBytes = residentBytes();
+	snapshot.heapBytes = heapBytes();
+	snapshot.liveAllocations = static_cast<long>(AllocCounter::allocations - AllocCounter::deallocations);
+	return snapshot;
+}
+
+static void drainPeers()
+{
+	char buffer[65536];
+	for (size_t i = 0; i < peers.size(); ++i)
+		while (read(peers[i], buffer, sizeof(buffer)) > 0)
+			;
+}
+
+/**
+ * @brief Executes one command line for a client, as Server::_processCommand() does.
+ */
+static void runCommand(Server& server, Client* client, const std::string& line)
+{
+	try
+	{
+		Command handler(server, client);
+		handler.manageCommand(line);
+	}
+	catch (const std::exception &e)
+	{
+		client->sendMessage(e.what(), NULL);
+	}
+}
+
+static Client* addClient(Server& server, const std::string& nickname)
+{
+	int fds[2];
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1)
+		throw std::runtime_error("socketpair() failed");
+	fcntl(fds[0], F_SETFL, O_NONBLOCK);
+	fcntl(fds[1], F_SETFL, O_NONBLOCK);
+	peers.push_back(fds[1]);
+
+	Client* client = new Client(fds[0]);
+	server.getClients().add(client);
+	client->setClientPort(40000 + fds[0]);
+	server.setClientNickname(client, nickname);
+	client->setUsername("~" + nickname);
+	client->setRealName("Real name of " + nickname);
+	client->setHostname("localhost");
+	client->setClientIp("127.0.0.1");
+	client->setUsermask();
+	server.authenticateClient(client);
+	return client;
+}
+
+// Les noms de canaux n'acceptent que des lettres : l'index est écrit en base 26
+static std::string lettered(const std::string& prefix, size_t i)
+{
+	std::string name = prefix;
+	do
+	{
+		name += static_cast<char>('a' + i % 26);
+		i /= 26;
+	} while (i);
+	return name;
+}
+
+/**
+ * @brief Prints the cost of one entity between two snapshots, as a JSON object.
+ */
+static void printPerEntity(std::ostream& out, const std::string& name, const Snapshot& before,
+	const Snapshot& after, size_t count, bool last)
+{
+	double n = count ? static_cast<double>(count) : 1.0;
+	out << "    \"" << name << "\": {\"count\": " << count
+		<< ", \"rss_bytes\": " << (after.rssBytes - before.rssBytes) / n
+		<< ", \"heap_bytes\": " << (after.heapBytes - before.heapBytes) / n
+		<< ", \"allocations\": " << (after.liveAllocations - before.liveAllocations) / n
+		<< "}" << (last ? "" : ",") << std::endl;
+}
+
+
+// =========================================================================================
+
+// === MAIN ===
+
+int main(int argc, char **argv)
+{
+	std::string port = argc > 1 ? argv[1] : "6799";
+	int clientCount = argc > 2 ? std::atoi(argv[2]) : 5000;
+	int channelCount = argc > 3 ? std::atoi(argv[3]) : 500;
+	int joinsPerClient = argc > 4 ? std::atoi(argv[4]) : 4;
+	if (clientCount <= 0 || channelCount <= 0 || joinsPerClient < 0 || joinsPerClient > channelCount)
+	{
+		std::cerr << "Usage: " << argv[0] << " [port] [clients] [channels] [joins per client <= channels]" << std::endl;
+		return 1;
+	}
+
+	// Deux descripteurs par client (paire de sockets)
+	struct rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max)
+	{
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+	}
+
+	// Les logs du serveur partent dans /dev/null : seule la sortie JSON reste sur stdout
+	std::ofstream devNull("/dev/null");
+	std::streambuf* stdoutBuffer = std::cout.rdbuf(devNull.rdbuf());
+	std::ostream out(stdoutBuffer);
+	int status = 0;
+
+	try
+	{
+		Server server(port, "bench42");
+		std::vector<Snapshot> snapshots;
+		snapshots.push_back(takeSnapshot("server"));
+
+		// 1. Connexions : N clients enregistrés, sans canal
+		std::vector<Client*> clients;
+		for (int i = 0; i < clientCount; ++i)
+			clients.push_back(addClient(server, lettered("user", i)));
+		drainPeers();
+		snapshots.push_back(takeSnapshot("clients"));
+
+		// 2. Canaux : chaque canal est créé par un client (un membre, opérateur)
+		for (int i = 0; i < channelCount; ++i)
+		{
+			runCommand(server, clients[i % clientCount], "JOIN " + lettered("#chan", i));
+			if (i % 64 == 0)
+				drainPeers();
+		}
+		drainPeers();
+		snapshots.push_back(takeSnapshot("channels"));
+
+		// 3. Adhésions : chaque client rejoint K canaux existants
+		size_t membershipsBefore = 0, membershipsAfter = 0;
+		for (int i = 0; i < clientCount; ++i)
+			membershipsBefore += clients[i]->getChannelsJoined().size();
+		for (int i = 0; i < clientCount; ++i)
+		{
+			for (int k = 0; k < joinsPerClient; ++k)
+				runCommand(server, clients[i], "JOIN " + lettered("#chan", (i + k * 7 + 1) % channelCount));
+			if (i % 16 == 0)
+				drainPeers();
+		}
+		drainPeers();
+		for (int i = 0; i < clientCount; ++i)
+			membershipsAfter += clients[i]->getChannelsJoined().size();
+		snapshots.push_back(takeSnapshot("memberships"));
+
+		// 4. Hibernation de tous les clients (buffers vides rendus, partie froide compactée)
+		for (int i = 0; i < clientCount; ++i)
+			clients[i]->hibernate();
+		snapshots.push_back(takeSnapshot("hibernation"));
+
+		ClientMemory memory = server.getClientMemory();
+
+		out << "{" << std::endl;
+		out << "  \"bench\": \"memory_footprint\"," << std::endl;
+		out << "  \"clients\": " << clientCount << ", \"channels\": " << server.getChannelCount()
+			<< ", \"memberships\": " << membershipsAfter << "," << std::endl;
+		out << "  \"sizeof\": {\"Client\": " << sizeof(Client) << ", \"ClientDetails\": " << sizeof(ClientDetails)
+			<< ", \"Channel\": " << sizeof(Channel) << "}," << std::endl;
+		out << "  \"phases\": [" << std::endl;
+		for (size_t i = 0; i < snapshots.size(); ++i)
+			out << "    {\"phase\": \"" << snapshots[i].phase << "\", \"rss_bytes\": " << snapshots[i].rssBytes
+				<< ", \"heap_bytes\": " << snapshots[i].heapBytes << ", \"live_allocations\": "
+				<< snapshots[i].liveAllocations << "}" << (i + 1 < snapshots.size() ? "," : "") << std::endl;
+		out << "  ]," << std::endl;
+		out << "  \"per_entity\": {" << std::endl;
+		printPerEntity(out, "client", snapshots[0], snapshots[1], clientCount, false);
+		printPerEntity(out, "channel", snapshots[1], snapshots[2], channelCount, false);
+		printPerEntity(out, "membership", snapshots[2], snapshots[3], membershipsAfter - membershipsBefore, false);
+		printPerEntity(out, "hibernated_client", snapshots[3], snapshots[4], clientCount, true);
+		out << "  }," << std::endl;
+		out << "  \"client_footprint\": {\"hibernating\": " << memory.hibernatingCount << ", \"hibernating_bytes\": "
+			<< memory.hibernatingBytes << ", \"active\": " << memory.activeCount << ", \"active_bytes\": "
+			<< memory.activeBytes << "}" << std::endl;
+		out << "}" << std::endl;
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << e.what() << std::endl;
+		status = 1;
+	}
+
+	std::cout.rdbuf(stdoutBuffer);
+	for (size_t i = 0; i < peers.size(); ++i)
+		close(peers[i]);
+	return status;
+}
@@ -12,6 +12,10 @@
 
 #include "Channel.hpp"
 
+// === OTHER CLASSES ===
+#include "Client.hpp"
+#include "IrcHelper.hpp"
+
 // =========================================================================================
 
 // === CONSTUCTOR / DESTRUCTOR ===
@@ -21,16 +25,79 @@
 Channel::Channel(const std::string &name, const std::string& password) :
 	_name(name),
 	_password(password),
+	_key(StringPool::intern(IrcHelper::toIrcLower(name))),
 	_topic(""),
 	_channelTimestamp(time(0)),
+	_connectedCount(0),
+	_operatorsCount(0),
+	_invitedCount(0),
 	_isInviteOnly(false),
 	_isSettableTopic(false),
 	_clientsLimit(-1) {}
 
-Channel::~Channel() {}
+/**
+ * @brief Destroys the channel.
+ *
+ * A channel is only destroyed once it has no connected clients, but invited
+ * clients may still reference it: the channel is removed from their list of
+ * invitations so that no client keeps a dangling pointer to it (already done
+ * by Client::deleteChannel(), which defers the destruction).
+ * The symbol of its name is then released from the string pool.
+ */
+Channel::~Channel()
+{
+	withdrawInvitations();
+	StringPool::release(_key);
+}
 
 // ========================================= PRIVATE =======================================
 
 Channel::Channel() {}
 Channel::Channel(const Channel& src) {(void) src;}
-Channel & Channel::operator=(const Channel& src) {(void) src; return *this;}
\ No newline at end of file
+Channel & Channel::operator=(const Channel& src) {(void) src; return *this;}
+
+
+// =========================================================================================
+
+// === MEMORY POOL ===
+
+ObjectPool<Channel> Channel::_pool;
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Allocates the memory of a channel from the channel pool.
+ *
+ * Channels are created and destroyed on every join/part of a lone user:
+ * reusing pooled slots keeps this churn from fragmenting the heap.
+ *
+ * @param size The size requested by new (sizeof(Channel)).
+ * @return A pointer to an uninitialized slot.
+ */
+void* Channel::operator new(size_t size)
+{
+	if (size != sizeof(Channel))
+		return ::operator new(size);
+	return _pool.allocate();
+}
+
+/**
+ * @brief Gives the memory of a destroyed channel back to the channel pool.
+ *
+ * @param ptr The slot to release.
+ * @param size The size of the destroyed object.
+ */
+void Channel::operator delete(void* ptr, size_t size)
+{
+	if (size != sizeof(Channel))
+	{
+		::operator delete(ptr);
+		return;
+	}
+	_pool.deallocate(ptr);
+}
+
+ObjectPool<Channel>& Channel::getPool()
+{
+	return _pool;
+}
\ No newline at end of file
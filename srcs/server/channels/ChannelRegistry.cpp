@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ChannelRegistry.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 11:02:37 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 11:02:37 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ChannelRegistry.hpp"
+
+// === OTHER CLASSES ===
+#include "Channel.hpp"
+#include "IrcHelper.hpp"
+
+// =========================================================================================
+
+// === CONSTUCTOR / DESTRUCTOR ===
+
+// ========================================= PUBLIC ========================================
+
+ChannelRegistry::ChannelRegistry() {}
+ChannelRegistry::~ChannelRegistry() {}
+
+// ========================================= PRIVATE =======================================
+
+ChannelRegistry::ChannelRegistry(const ChannelRegistry& src) {(void) src;}
+ChannelRegistry & ChannelRegistry::operator=(const ChannelRegistry& src) {(void) src; return *this;}
+
+
+// =========================================================================================
+
+// === LOOKUP ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Retrieves a channel by its name, using RFC 1459 casemapping.
+ *
+ * The name is casefolded once and resolved to its interned symbol, then the
+ * channel is found with an integer probe, so "#Foo", "#foo" and "#FOO" all
+ * designate the same channel. A name absent from the string pool cannot be a channel.
+ *
+ * @param channelName The name of the channel as typed by the client.
+ * @return A pointer to the channel, or NULL if it does not exist.
+ */
+Channel* ChannelRegistry::find(const std::string& channelName) const
+{
+	Symbol key = StringPool::find(IrcHelper::toIrcLower(channelName));
+	if (!key)
+		return NULL;
+
+	Channel* const* channel = _table.find(key);
+	return channel ? *channel : NULL;
+}
+
+/**
+ * @brief Checks if a channel exists in the registry.
+ *
+ * @param channelName The name of the channel to check for existence.
+ * @return true if the channel exists, false otherwise.
+ */
+bool ChannelRegistry::contains(const std::string& channelName) const
+{
+	return find(channelName) != NULL;
+}
+
+
+// === REGISTRY MANAGER ===
+
+/**
+ * @brief Registers a channel under the symbol of its casefolded name.
+ *
+ * @param channel A pointer to the Channel object to register.
+ */
+void ChannelRegistry::add(Channel* channel)
+{
+	_table.insert(channel->getKey(), channel);
+}
+
+/**
+ * @brief Removes a channel from the registry.
+ *
+ * The Channel object itself is not destroyed, the caller keeps ownership.
+ *
+ * @param channel A pointer to the Channel object to unregister.
+ */
+void ChannelRegistry::remove(const Channel* channel)
+{
+	_table.erase(channel->getKey());
+}
+
+
+// === CAPACITY ===
+
+void ChannelRegistry::reserve(size_t count)
+{
+	_table.reserve(count);
+}
+
+
+// === INFOS ===
+
+size_t ChannelRegistry::size() const
+{
+	return _table.size();
+}
+bool ChannelRegistry::empty() const
+{
+	return _table.empty();
+}
+ChannelRegistry::iterator ChannelRegistry::begin()
+{
+	return _table.begin();
+}
+ChannelRegistry::iterator ChannelRegistry::end()
+{
+	return _table.end();
+}
@@ -0,0 +1,242 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ChannelShards.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ChannelShards.hpp"
+#include "HashTable.hpp"
+#include "IrcHelper.hpp"
+
+#include <cctype>				// toupper()
+
+// === NAMESPACES ===
+#include "commands.hpp"
+
+using namespace commands;
+
+// =========================================================================================
+
+// === CONSTUCTOR / DESTRUCTOR ===
+
+// ========================================= PUBLIC ========================================
+
+ChannelShards::ChannelShards() : _pending(0), _peakPending(0), _next(0), _running(false) {}
+ChannelShards::~ChannelShards() {}
+
+// ========================================= PRIVATE =======================================
+
+ChannelShards::ChannelShards(const ChannelShards& src) {(void) src;}
+ChannelShards & ChannelShards::operator=(const ChannelShards& src) {(void) src; return *this;}
+
+
+// =========================================================================================
+
+// === SETUP ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Creates one empty operation queue per shard.
+ *
+ * @param shardCount The number of shards, 0 to disable the sharded mode
+ *                   (channel commands are then run as soon as they are read).
+ */
+void ChannelShards::init(size_t shardCount)
+{
+	_queues.clear();
+	_queues.resize(shardCount);
+	_pending = 0;
+	_next = 0;
+}
+
+
+// =========================================================================================
+
+// === ROUTING ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Gives the shard owning a channel.
+ *
+ * The name is casefolded first (RFC 1459), so "#Foo" and "#foo" always land in the same shard.
+ *
+ * @param channelName The name of the channel as typed by the client.
+ * @return The index of the shard.
+ */
+size_t ChannelShards::shardOf(const std::string& channelName) const
+{
+	if (_queues.empty())
+		return 0;
+	return StringHash()(IrcHelper::toIrcLower(channelName)) % _queues.size();
+}
+
+/**
+ * @brief Checks if a command line is a channel operation handled by a shard.
+ *
+ * Only JOIN, PART, PRIVMSG and MODE whose first parameter is a single channel
+ * ("#name", no comma list) are routed: a command touching several channels,
+ * or a user, runs at once.
+ *
+ * @param line The command line received from the client.
+ * @param shard Receives the shard owning the targeted channel.
+ * @return true if the line must be posted to a shard.
+ */
+bool ChannelShards::route(const std::string& line, size_t& shard) const
+{
+	if (_queues.empty())
+		return false;
+
+	size_t commandEnd = line.find(' ');
+	if (commandEnd == std::string::npos || !_isRoutedCommand(line, commandEnd))
+		return false;
+
+	size_t targetStart = line.find_first_not_of(' ', commandEnd);
+	if (targetStart == std::string::npos || line[targetStart] != '#')
+		return false;
+	size_t targetEnd = line.find(' ', targetStart);
+	if (targetEnd == std::string::npos)
+		targetEnd = line.size();
+	if (line.find(',', targetStart) < targetEnd)
+		return false;
+
+	shard = shardOf(line.substr(targetStart, targetEnd - targetStart));
+	return true;
+}
+
+// ========================================= PRIVATE =======================================
+
+bool ChannelShards::_isRoutedCommand(const std::string& line, size_t length)
+{
+	static const std::string* routed[] = {&JOIN, &PART, &PRIVMSG, &MODE};
+
+	for (size_t i = 0; i < sizeof(routed) / sizeof(routed[0]); ++i)
+	{
+		const std::string& command = *routed[i];
+		if (command.size() != length)
+			continue;
+		size_t c = 0;
+		while (c < length && std::toupper(static_cast<unsigned char>(line[c])) == command[c])
+			++c;
+		if (c == length)
+			return true;
+	}
+	return false;
+}
+
+
+// =========================================================================================
+
+// === QUEUES ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Posts an operation at the end of the queue of a shard.
+ *
+ * @param shard The shard owning the targeted channel (cf route()).
+ * @param client A handle to the sender.
+ * @param line The command line, run unchanged when its turn comes.
+ */
+void ChannelShards::post(size_t shard, const ClientHandle& client, const std::string& line)
+{
+	if (_postedByFd.size() <= static_cast<size_t>(client.fd))
+	{
+		_postedByFd.resize(client.fd + 1, 0);
+		_takenByFd.resize(client.fd + 1, 0);
+	}
+
+	_queues[shard].push_back(ChannelOperation());
+	_queues[shard].back().client = client;
+	_queues[shard].back().line = line;
+	_queues[shard].back().rank = _postedByFd[client.fd]++;
+
+	if (++_pending > _peakPending)
+		_peakPending = _pending;
+}
+
+/**
+ * @brief Takes the oldest operation of a shard.
+ *
+ * The operation stays queued while its sender still has an older operation in
+ * another shard: the shard then waits for it (the oldest operation of all is
+ * always ready, so the shards cannot block each other for good).
+ *
+ * @param shard The shard to serve.
+ * @param operation Receives the operation.
+ * @return false if the queue of the shard is empty or its first operation must wait.
+ */
+bool ChannelShards::take(size_t shard, ChannelOperation& operation)
+{
+	std::deque<ChannelOperation>& queue = _queues[shard];
+	if (queue.empty() || queue.front().rank != _takenByFd[queue.front().client.fd])
+		return false;
+
+	operation.client = queue.front().client;
+	operation.line.swap(queue.front().line);
+	operation.rank = queue.front().rank;
+	queue.pop_front();
+
+	_takenByFd[operation.client.fd]++;
+	_pending--;
+	return true;
+}
+
+/**
+ * @brief Gives the shard served first in this round, and moves the turnstile forward
+ *        so that no shard is always served first.
+ */
+size_t ChannelShards::nextShard()
+{
+	size_t shard = _next;
+	_next = (_next + 1) % _queues.size();
+	return shard;
+}
+
+void ChannelShards::setRunning(bool status)
+{
+	_running = status;
+}
+
+
+// =========================================================================================
+
+// === INFOS ===
+
+bool ChannelShards::isEnabled() const
+{
+	return !_queues.empty();
+}
+bool ChannelShards::isRunning() const
+{
+	return _running;
+}
+size_t ChannelShards::getShardCount() const
+{
+	return _queues.size();
+}
+size_t ChannelShards::getPendingCount() const
+{
+	return _pending;
+}
+size_t ChannelShards::getPendingCount(size_t shard) const
+{
+	return _queues[shard].size();
+}
+size_t ChannelShards::getPeakPending() const
+{
+	return _peakPending;
+}
+size_t ChannelShards::getQueuedFor(int fd) const
+{
+	if (fd < 0 || static_cast<size_t>(fd) >= _postedByFd.size())
+		return 0;
+	return _postedByFd[fd] - _takenByFd[fd];
+}
@@ -15,6 +15,7 @@
 // === OTHER CLASSES ===
 #include "Client.hpp"
 #include "MessageBuilder.hpp"
+#include "FanoutEngine.hpp"
 
 // === NAMESPACES ===
 #include "irc_config.hpp"
@@ -31,15 +32,17 @@
  * @brief Adds a client to the channel if they are not already connected.
  * 
  * This function checks if the given client is already connected to the channel.
- * If the client is not connected, it adds the client to the channel's list of
- * connected clients.
+ * If the client is not connected, its entry in the member table gets the JOINED flag.
+ * A pending invitation is consumed by the join.
  * 
  * @param client A pointer to the Client object to be added to the channel.
  */
 void Channel::addClient(Client* client)
 {
-	if (!isConnected(client))
-		_connected.insert(client);
+	if (isConnected(client))
+		return;
+	_setFlag(client, member_flag::JOINED);
+	removeInvitation(client);
 }
 
 /**
@@ -54,19 +57,51 @@ void Channel::addClient(Client* client)
  * @param invited Pointer to the client being invited.
  * @param inviter Pointer to the client who is sending the invitation.
  */
-void Channel::addClientToInvitedList(const Client* invited, const Client* inviter)
+void Channel::addClientToInvitedList(Client* invited, const Client* inviter)
 {
 	if (isInvited(invited))
 	{
 		inviter->sendMessage(MessageBuilder::ircAlreadyInvitedToChannel(invited->getNickname(), _name), NULL);
 		return;
 	}
-	_invited.insert(invited);
+	_setFlag(invited, member_flag::INVITED);
+	invited->getChannelsInvited()[_key] = this;
 	inviter->sendMessage(MessageBuilder::ircInviting(inviter->getNickname(), invited->getNickname(), _name), NULL);
 	invited->sendMessage(MessageBuilder::ircInvitedToChannel(inviter->getNickname(), _name), NULL);
 	std::cout << MessageBuilder::msgIsInvitedToChannel(invited->getNickname(), inviter->getNickname(), _name) << std::endl;
 }
 
+/**
+ * @brief Removes the invitation of a client to the channel, if any.
+ *
+ * The INVITED flag is cleared (the entry disappears from the member table if it
+ * was the only flag) and the channel is removed from the client's invitations.
+ *
+ * @param invited Pointer to the invited client.
+ */
+void Channel::removeInvitation(Client* invited)
+{
+	if (!isInvited(invited))
+		return;
+	invited->getChannelsInvited().erase(_key);
+	_clearFlag(invited, member_flag::INVITED);
+}
+
+/**
+ * @brief Removes every pending invitation to the channel.
+ *
+ * Called when the channel is deleted: invited clients may still reference it,
+ * so the channel is removed from their list of invitations right away,
+ * before it is handed to the EpochReclaimer.
+ */
+void Channel::withdrawInvitations()
+{
+	// Parcours à rebours : une entrée sans flag est remplacée par la dernière de la table
+	for (size_t i = _members.size(); i-- > 0;)
+		if (_members[i].flags & member_flag::INVITED)
+			removeInvitation(_members[i].client);
+}
+
 /**
  * @brief Adds a client as an operator to the channel.
  *
@@ -81,7 +116,7 @@ void Channel::addOperator(Client* client)
 {
 	if (isOperator(client))
 		return;
-	_operators.insert(client);
+	_setFlag(client, member_flag::OPERATOR);
 	std::cout << MessageBuilder::msgClientOperatorAdded(client->getNickname(), _name) << std::endl;
 }
 
@@ -98,7 +133,7 @@ void Channel::removeOperator(Client* client)
 {
 	if (!isOperator(client))
 		return;
-	_operators.erase(client);
+	_clearFlag(client, member_flag::OPERATOR);
 	std::cout << MessageBuilder::msgClientOperatorRemoved(client->getNickname(), _name) << std::endl;
 }
 
@@ -114,14 +149,16 @@ void Channel::removeOperator(Client* client)
  * @param kickerName Name of the client who kicked the target client. If empty, the client left voluntarily.
  * @param reason Reason for the client leaving or being kicked.
  */
-void Channel::removeClient(Client* client, const Client* kicker, const std::string& reason, int reasonCode)
+void Channel::removeClient(Client* client, Client* kicker, const std::string& reason, int reasonCode)
 {
 	if (!isConnected(client))
 		return;
 
 	if (kicker && reasonCode == leaving_code::KICKED)
 	{
-		sendToAll(MessageBuilder::ircClientKickUser(kicker->getUsermask(), _name, client->getNickname(), reason), client, true);
+		// Le KICK part de l'opérateur (ordre de ses messages, pause de sa lecture pendant un envoi découpé),
+		// la victime, encore membre, le reçoit comme les autres
+		sendToAll(MessageBuilder::ircClientKickUser(kicker->getUsermask(), _name, client->getNickname(), reason), kicker, true);
 		std::cout << MessageBuilder::msgClientKickedFromChannel(client->getNickname(), kicker->getNickname(), _name, reason) << std::endl;
 	}
 	if (reasonCode == leaving_code::LEFT)
@@ -130,20 +167,20 @@ void Channel::removeClient(Client* client, const Client* kicker, const std::stri
 		client->sendMessage(MessageBuilder::ircCurrentNotInChannel(client->getNickname(), _name), NULL);
 		std::cout << MessageBuilder::msgClientLeftChannel(client->getNickname(), _name, reason) << std::endl;
 	}
+	// Le QUIT a déjà été envoyé une seule fois à tous les voisins (cf Server::sendToNeighbors())
 	if (reasonCode == leaving_code::QUIT_SERV)
 	{
-		sendToAll(MessageBuilder::ircClientQuitServer(client->getUsermask(), reason), client, false);
 		std::cout << MessageBuilder::msgClientLeftChannel(client->getNickname(), _name, reason) << std::endl;
 	}
 
-	// On supprime le client des clients connectes au canal
-	_connected.erase(client);
-
 	// On l'enleve des operateurs s'il est operateur
 	removeOperator(client);
 
+	// On supprime son entrée de la table des membres
+	_clearFlag(client, member_flag::JOINED | member_flag::VOICE);
+
 	// On retire le canal des canaux du clients
-	client->getChannelsJoined().erase(_name);
+	client->getChannelsJoined().erase(_key);
 }
 
 
@@ -162,10 +199,14 @@ void Channel::removeClient(Client* client, const Client* kicker, const std::stri
  * @param includeSender A boolean flag indicating whether the sender should also
  *                      receive the message. If false, the sender will not receive
  *                      the message.
+ *
+ * A channel of fanout::THRESHOLD members or more gets the message through the
+ * FanoutEngine, over several loop iterations (see FanoutEngine); the sender still
+ * gets its own copy at once.
  */
 void Channel::sendToAll(const std::string &message, Client* sender, bool includeSender)
 {
-	if (!sender->isInChannel(_name))
+	if (!sender->isInChannel(this))
 	{
 		if (_isInviteOnly && isInvited(sender) == false)
 		{
@@ -176,10 +217,109 @@ void Channel::sendToAll(const std::string &message, Client* sender, bool include
 		return;
 	}
 
-	for (std::set<const Client*>::iterator it = _connected.begin(); it != _connected.end(); ++it)
+	// Grand canal (ou diffusion déjà en cours sur ce canal ou de cet émetteur) :
+	// envoi découpé entre plusieurs tours de boucle, sauf la copie de l'émetteur
+	if (FanoutEngine::mustDefer(_key, _connectedCount, sender))
+	{
+		if (includeSender)
+			sender->sendMessage(message, sender);
+		FanoutEngine::post(_key, sender, message, _members);
+		return;
+	}
+
+	for (std::vector<ChannelMember>::const_iterator it = _members.begin(); it != _members.end(); ++it)
 	{
-		if (includeSender == false && *it == sender)
+		if (!(it->flags & member_flag::JOINED) || (includeSender == false && it->client == sender))
 			continue;
-		(*it)->sendMessage(message, sender);
+		it->client->sendMessage(message, sender);
+	}
+}
+
+
+// ========================================= PRIVATE =======================================
+
+// === MEMBER TABLE ===
+
+/**
+ * @brief Retrieves the entry of a client in the member table.
+ *
+ * @param client The client to look for.
+ * @return A pointer to the member entry, or NULL if the client has no flag on the channel.
+ */
+const ChannelMember* Channel::_findMember(const Client* client) const
+{
+	const size_t* index = _memberIndex.find(client);
+	return index ? &_members[*index] : NULL;
+}
+
+bool Channel::_hasFlag(const Client* client, int flag) const
+{
+	const ChannelMember* member = _findMember(client);
+	return member && (member->flags & flag);
+}
+
+/**
+ * @brief Sets a flag for a client, creating its member entry if needed.
+ *
+ * The JOINED, OPERATOR and INVITED counters are kept up to date so that
+ * counts and emptiness checks never walk the table.
+ *
+ * @param client The client to flag.
+ * @param flag One of the member_flag values.
+ */
+void Channel::_setFlag(Client* client, int flag)
+{
+	size_t* index = _memberIndex.find(client);
+	if (!index)
+	{
+		_memberIndex.insert(client, _members.size());
+		_members.push_back(ChannelMember(client, 0));
+		index = _memberIndex.find(client);
+	}
+
+	int& flags = _members[*index].flags;
+	if ((flag & member_flag::JOINED) && !(flags & member_flag::JOINED))
+		++_connectedCount;
+	if ((flag & member_flag::OPERATOR) && !(flags & member_flag::OPERATOR))
+		++_operatorsCount;
+	if ((flag & member_flag::INVITED) && !(flags & member_flag::INVITED))
+		++_invitedCount;
+	flags |= flag;
+}
+
+/**
+ * @brief Clears one or several flags of a client.
+ *
+ * If the entry has no flag left, it is removed from the table by moving the
+ * last entry into its slot (swap and pop), so the table stays contiguous.
+ *
+ * @param client The client to unflag.
+ * @param flag A combination of member_flag values.
+ */
+void Channel::_clearFlag(const Client* client, int flag)
+{
+	size_t* index = _memberIndex.find(client);
+	if (!index)
+		return;
+
+	size_t pos = *index;
+	int& flags = _members[pos].flags;
+	if (flag & flags & member_flag::JOINED)
+		--_connectedCount;
+	if (flag & flags & member_flag::OPERATOR)
+		--_operatorsCount;
+	if (flag & flags & member_flag::INVITED)
+		--_invitedCount;
+	flags &= ~flag;
+	if (flags)
+		return;
+
+	// Plus aucun flag: on retire l'entrée en déplaçant la dernière à sa place
+	_memberIndex.erase(client);
+	if (pos != _members.size() - 1)
+	{
+		_members[pos] = _members.back();
+		_memberIndex.insert(_members[pos].client, pos);
 	}
+	_members.pop_back();
 }
\ No newline at end of file
@@ -20,6 +20,7 @@
 
 // === NAMESPACES ===
 #include "bot_config.hpp"
+#include "irc_config.hpp"
 
 using namespace bot_config;
 
@@ -104,6 +105,10 @@ const std::string& Channel::getName() const
 {
 	return _name;
 }
+Symbol Channel::getKey() const
+{
+	return _key;
+}
 /**
  * @brief Retrieves the current mode settings of the channel as a formatted string.
  * 
@@ -187,96 +192,101 @@ bool Channel::isFull() const
 }
 bool Channel::hasClients() const
 {
-	return !_connected.empty();
+	return _connectedCount > 0;
 }
 bool Channel::hasOperators() const
 {
-	return !_operators.empty();
+	return _operatorsCount > 0;
 }
 bool Channel::hasInvitedClients() const
 {
-	return !_invited.empty();
+	return _invitedCount > 0;
 }
 
 
 // === CLIENTS LISTS ===
 
-std::set<const Client*> Channel::getClientsList() const
-{
-	return _connected;
-}
-std::set<const Client*> Channel::getInvitedList() const
-{
-	return _invited;
-}
-std::set<const Client*> Channel::getOperatorsList() const
+/**
+ * @brief Gives read-only access to the member table of the channel.
+ *
+ * Nothing is copied: callers iterate the table in place and filter entries
+ * on their member_flag bits (JOINED for connected clients, INVITED, OPERATOR...).
+ *
+ * @return A const reference to the member table.
+ */
+const std::vector<ChannelMember>& Channel::getMembers() const
 {
-	return _operators;
+	return _members;
 }
 
 int Channel::getConnectedCount() const
 {
-	return _connected.size();
+	return _connectedCount;
 }
 /**
- * @brief Retrieves the file descriptor of a client in the channel by their nickname.
+ * @brief Retrieves a client connected to the channel by their nickname.
  *
- * This function iterates through the set of connected clients in the channel and
- * checks if the provided nickname matches any client's nickname, excluding the
- * current client. If a match is found, the file descriptor of the matched client
- * is returned.
+ * This function iterates through the member table of the channel and checks if
+ * the provided nickname matches the nickname of a connected client (RFC 1459 casemapping),
+ * excluding the current client.
  *
  * @param nickname The nickname of the client to search for.
  * @param currClient A pointer to the current client to be excluded from the search.
- * @return The file descriptor of the matched client, or -1 if no match is found.
+ * @return A pointer to the matched client, or NULL if no match is found.
  */
-int Channel::getChannelClientByNickname(const std::string &nickname, const Client* currClient)
+Client* Channel::getChannelClientByNickname(const std::string &nickname, const Client* currClient) const
 {
-	for (std::set<const Client*>::iterator it = _connected.begin(); it != _connected.end(); it++)
+	std::string key = IrcHelper::toIrcLower(nickname);
+	for (std::vector<ChannelMember>::const_iterator it = _members.begin(); it != _members.end(); ++it)
 	{
-		if (currClient && currClient == *it)
+		if (!(it->flags & member_flag::JOINED) || (currClient && currClient == it->client))
 			continue;
-		if (nickname == (*it)->getNickname()) 
-			return (*it)->getFd();
+		if (key == IrcHelper::toIrcLower(it->client->getNickname()))
+			return it->client;
 	}
-	return -1;
+	return NULL;
 }
 /**
  * @brief Retrieves a space-separated string of nicknames of all clients connected to the channel.
  *
- * This function iterates through the set of connected clients and constructs a string
- * containing their nicknames. If a client is an operator, their nickname is prefixed with "@".
+ * This function iterates through the member table and constructs a string containing
+ * the nicknames of connected clients. The operator ("@") and voice ("+") prefixes
+ * are read from the member flags, without any extra lookup.
  *
  * @return A std::string containing the nicknames of all connected clients, separated by spaces.
  */
 std::string Channel::getNicknames() const
 {
 	std::string nicknames;
-	std::set<const Client*>::iterator it = _connected.begin();
-	std::set<const Client*>::iterator end = _connected.end();
-
-	std::string prefix;
 
-	while (it != end)
+	for (std::vector<ChannelMember>::const_iterator it = _members.begin(); it != _members.end(); ++it)
 	{
-		prefix = isOperator(*it) ? "@" : "";
-		nicknames += (prefix + (*it)->getNickname());
-		++it;
-		if (it != end)
+		if (!(it->flags & member_flag::JOINED))
+			continue;
+		if (!nicknames.empty())
 			nicknames += " ";
+		if (it->flags & member_flag::OPERATOR)
+			nicknames += "@";
+		else if (it->flags & member_flag::VOICE)
+			nicknames += "+";
+		nicknames += it->client->getNickname();
 	}
 	return nicknames;
 }
 
 bool Channel::isConnected(const Client* client) const
 {
-	return _connected.find(client) != _connected.end();
+	return _hasFlag(client, member_flag::JOINED);
 }
 bool Channel::isOperator(const Client* client) const
 {
-	return _operators.find(client) != _operators.end();
+	return _hasFlag(client, member_flag::OPERATOR);
 }
 bool Channel::isInvited(const Client* client) const
 {
-	return _invited.find(client) != _invited.end();
+	return _hasFlag(client, member_flag::INVITED);
+}
+bool Channel::isVoiced(const Client* client) const
+{
+	return _hasFlag(client, member_flag::VOICE);
 }
\ No newline at end of file
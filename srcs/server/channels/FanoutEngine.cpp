@@ -0,0 +1,251 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FanoutEngine.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "FanoutEngine.hpp"
+#include "Channel.hpp"
+#include "Client.hpp"
+
+// === NAMESPACES ===
+#include "irc_config.hpp"
+
+// =========================================================================================
+
+// === STATIC MEMBERS ===
+
+const ClientTable* FanoutEngine::_clients = NULL;
+size_t FanoutEngine::_threshold = fanout::THRESHOLD;
+std::deque<FanoutEngine::Job> FanoutEngine::_jobs;
+std::map<Symbol, size_t> FanoutEngine::_pendingByChannel;
+std::vector<unsigned int> FanoutEngine::_pendingBySender;
+std::vector<ClientHandle> FanoutEngine::_released;
+unsigned long FanoutEngine::_deferredCount = 0;
+unsigned long FanoutEngine::_deferredDeliveries = 0;
+
+
+// =========================================================================================
+
+// === SETUP ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Enables the deferred delivery for the channels of a server.
+ *
+ * Until this is called (benchmarks without a server loop), every channel message is sent at once.
+ *
+ * @param clients The client table of the server, used to take and resolve handles.
+ * @param threshold The number of connected members from which a message is delivered in several iterations.
+ */
+void FanoutEngine::attach(const ClientTable& clients, size_t threshold)
+{
+	_clients = &clients;
+	_threshold = threshold ? threshold : 1;
+}
+
+/**
+ * @brief Drops the deliveries in progress and detaches the engine from the server.
+ */
+void FanoutEngine::clear()
+{
+	_jobs.clear();
+	_pendingByChannel.clear();
+	_pendingBySender.clear();
+	_released.clear();
+	_clients = NULL;
+}
+
+
+// =========================================================================================
+
+// === POSTING ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Tells whether a channel message must go through the queue.
+ *
+ * @param channel The key of the channel.
+ * @param memberCount The number of connected members of the channel.
+ * @param sender The client sending the message.
+ * @return true if the channel reaches the threshold, or if the channel or the sender
+ *         already has a delivery in progress (their messages must stay in order).
+ */
+bool FanoutEngine::mustDefer(Symbol channel, size_t memberCount, const Client* sender)
+{
+	if (!_clients)
+		return false;
+	if (memberCount >= _threshold)
+		return true;
+	return !_jobs.empty() && (_pendingByChannel.count(channel) || getPendingFor(sender) > 0);
+}
+
+/**
+ * @brief Queues a channel message for its connected members, the sender excepted.
+ *
+ * The recipients are the members connected when the message is sent: a client joining
+ * later does not get it, a member leaving in the meantime still does (as with an immediate send).
+ * The copy of the sender, if any, is sent by the caller right away.
+ *
+ * @param channel The key of the channel.
+ * @param sender The client sending the message.
+ * @param message The formatted line, copied once into the queue.
+ * @param members The member table of the channel.
+ */
+void FanoutEngine::post(Symbol channel, const Client* sender, const std::string& message,
+	const std::vector<ChannelMember>& members)
+{
+	_jobs.push_back(Job());
+	Job& job = _jobs.back();
+	job.channel = channel;
+	job.sender = _clients->getHandle(sender);
+	job.message = message;
+	job.next = 0;
+
+	job.recipients.reserve(members.size());
+	for (std::vector<ChannelMember>::const_iterator it = members.begin(); it != members.end(); ++it)
+	{
+		if (!(it->flags & member_flag::JOINED) || it->client == sender)
+			continue;
+		job.recipients.push_back(_clients->getHandle(it->client));
+	}
+
+	_pendingByChannel[channel]++;
+	if (!job.sender.isNull())
+	{
+		if (_pendingBySender.size() <= static_cast<size_t>(job.sender.fd))
+			_pendingBySender.resize(job.sender.fd + 1, 0);
+		_pendingBySender[job.sender.fd]++;
+	}
+	_deferredCount++;
+}
+
+
+// =========================================================================================
+
+// === DELIVERY ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Delivers queued messages, oldest first.
+ *
+ * A recipient gone since the message was sent (handle no longer valid) is skipped.
+ *
+ * @param budget The maximum number of copies sent by this call.
+ * @return The number of copies sent.
+ */
+size_t FanoutEngine::run(size_t budget)
+{
+	size_t done = 0;
+	while (!_jobs.empty() && done < budget)
+	{
+		Job& job = _jobs.front();
+		Client* sender = _clients->resolve(job.sender);
+
+		size_t end = job.recipients.size();
+		if (end - job.next > budget - done)
+			end = job.next + (budget - done);
+		done += end - job.next;
+
+		for (; job.next < end; ++job.next)
+		{
+			Client* recipient = _clients->resolve(job.recipients[job.next]);
+			if (recipient)
+				recipient->sendMessage(job.message, sender);
+		}
+
+		if (job.next < job.recipients.size())
+			break;
+		_complete(job);
+		_jobs.pop_front();
+	}
+	_deferredDeliveries += done;
+	return done;
+}
+
+/**
+ * @brief Completes at once every delivery of a client, and those queued before them.
+ *
+ * Used when the client leaves or must run a command right away: its messages reach
+ * everyone before its QUIT or its next reply.
+ *
+ * @param sender The client whose deliveries must be over.
+ */
+void FanoutEngine::finish(const Client* sender)
+{
+	while (getPendingFor(sender) > 0)
+		run(fanout::TICK_BUDGET);
+}
+
+/**
+ * @brief Hands over the senders whose deliveries are all over, so that the server reads them again.
+ *
+ * @param released Receives the handles (its previous content is discarded).
+ */
+void FanoutEngine::takeReleased(std::vector<ClientHandle>& released)
+{
+	released.clear();
+	released.swap(_released);
+}
+
+// ========================================= PRIVATE =======================================
+
+void FanoutEngine::_complete(const Job& job)
+{
+	std::map<Symbol, size_t>::iterator channel = _pendingByChannel.find(job.channel);
+	if (channel != _pendingByChannel.end() && --channel->second == 0)
+		_pendingByChannel.erase(channel);
+
+	if (!job.sender.isNull() && --_pendingBySender[job.sender.fd] == 0)
+		_released.push_back(job.sender);
+}
+
+
+// =========================================================================================
+
+// === INFOS ===
+
+bool FanoutEngine::empty()
+{
+	return _jobs.empty();
+}
+size_t FanoutEngine::getJobCount()
+{
+	return _jobs.size();
+}
+Symbol FanoutEngine::getChannel()
+{
+	return _jobs.empty() ? 0 : _jobs.front().channel;
+}
+const ClientHandle& FanoutEngine::getSender(size_t job)
+{
+	return _jobs[job].sender;
+}
+size_t FanoutEngine::getPendingFor(const Client* sender)
+{
+	if (_jobs.empty() || !sender)
+		return 0;
+	size_t fd = static_cast<size_t>(sender->getFd());
+	return fd < _pendingBySender.size() ? _pendingBySender[fd] : 0;
+}
+size_t FanoutEngine::getThreshold()
+{
+	return _threshold;
+}
+unsigned long FanoutEngine::getDeferredCount()
+{
+	return _deferredCount;
+}
+unsigned long FanoutEngine::getDeferredDeliveries()
+{
+	return _deferredDeliveries;
+}
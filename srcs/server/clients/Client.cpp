@@ -12,6 +12,9 @@
 
 #include "Client.hpp"
 
+// === OTHER CLASSES ===
+#include "Channel.hpp"
+
 // =========================================================================================
 
 // === CONSTUCTOR / DESTRUCTOR ==
@@ -20,20 +23,97 @@
 
 Client::Client(int fd) :
 	_clientSocketFd(fd),
-	_isIrssi(false),
-	_isIdentified(false),
-	_authenticated(false),
-	_rightPassServ(false),
-	_signonTime(time(NULL)),
+	_flags(0),
 	_lastActivity(time(NULL)),
-	_isAway(false),
-	_errorMsgTooLongSent(false),
-	_pingSent(false) {}
+	_wakeTime(0),
+	_fanoutStamp(0),
+	_nicknameKey(0),
+	_clientPort(0),
+	_details(NULL),
+	_signonTime(time(NULL)) {}
+
+/**
+ * @brief Destroys the client.
+ *
+ * Pending invitations are withdrawn so that no channel member table
+ * keeps a pointer to a deleted client, and the symbol of the nickname is released.
+ * The cold record, if any, goes back to its pool.
+ */
+Client::~Client()
+{
+	if (_details)
+	{
+		withdrawInvitations();
+		_details->~ClientDetails();
+		_detailsPool.deallocate(_details);
+	}
+	StringPool::release(_nicknameKey);
 
-Client::~Client() {}
+	// Les données encore en attente quittent les totaux des files
+	_recvQueueTotal -= _bufferMessage.size();
+	_sendQueueTotal -= _sendQueue.size();
+}
 
 // ========================================= PRIVATE =======================================
 
 Client::Client() {}
 Client::Client(const Client& src) {(void) src;}
-Client & Client::operator=(const Client& src) {(void) src; return *this;}
\ No newline at end of file
+Client & Client::operator=(const Client& src) {(void) src; return *this;}
+
+
+// =========================================================================================
+
+// === MEMORY POOL ===
+
+ObjectPool<Client> Client::_pool;
+ObjectPool<ClientDetails> Client::_detailsPool;
+
+// === QUEUE ACCOUNTING ===
+
+size_t Client::_recvQueueTotal = 0;
+size_t Client::_sendQueueTotal = 0;
+size_t Client::_queuePeak = 0;
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Allocates the memory of a client from the client pool.
+ *
+ * Reconnection waves delete and recreate many clients: reusing pooled slots
+ * bounds the memory used to the peak number of clients instead of letting
+ * the heap fragment.
+ *
+ * @param size The size requested by new (sizeof(Client)).
+ * @return A pointer to an uninitialized slot.
+ */
+void* Client::operator new(size_t size)
+{
+	if (size != sizeof(Client))
+		return ::operator new(size);
+	return _pool.allocate();
+}
+
+/**
+ * @brief Gives the memory of a deleted client back to the client pool.
+ *
+ * @param ptr The slot to release.
+ * @param size The size of the deleted object.
+ */
+void Client::operator delete(void* ptr, size_t size)
+{
+	if (size != sizeof(Client))
+	{
+		::operator delete(ptr);
+		return;
+	}
+	_pool.deallocate(ptr);
+}
+
+ObjectPool<Client>& Client::getPool()
+{
+	return _pool;
+}
+const ObjectPool<ClientDetails>& Client::getDetailsPool()
+{
+	return _detailsPool;
+}
\ No newline at end of file
@@ -0,0 +1,177 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ClientTable.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ClientTable.hpp"
+
+// === OTHER CLASSES ===
+#include "Client.hpp"
+
+// =========================================================================================
+
+// === CONSTUCTOR / DESTRUCTOR ===
+
+// ========================================= PUBLIC ========================================
+
+ClientTable::ClientTable() : _maxFd(-1) {}
+ClientTable::~ClientTable() {}
+
+// ========================================= PRIVATE =======================================
+
+ClientTable::ClientTable(const ClientTable& src) {(void) src;}
+ClientTable & ClientTable::operator=(const ClientTable& src) {(void) src; return *this;}
+
+
+// =========================================================================================
+
+// === LOOKUP ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Retrieves the client associated with a file descriptor.
+ *
+ * File descriptors are small integers, so the lookup is a plain array index.
+ *
+ * @param fd The file descriptor of the client.
+ * @return A pointer to the client, or NULL if no client uses this fd.
+ */
+Client* ClientTable::get(int fd) const
+{
+	if (fd < 0 || static_cast<size_t>(fd) >= _slots.size())
+		return NULL;
+	return _slots[fd].client;
+}
+
+/**
+ * @brief Creates a stable handle to a client.
+ *
+ * @param client A pointer to a client stored in the table.
+ * @return A handle made of the client's fd and the current generation of its slot,
+ *         or a null handle if the client is not in the table.
+ */
+ClientHandle ClientTable::getHandle(const Client* client) const
+{
+	if (!client)
+		return ClientHandle();
+
+	int fd = client->getFd();
+	if (get(fd) != client)
+		return ClientHandle();
+	return ClientHandle(fd, _slots[fd].generation);
+}
+
+/**
+ * @brief Resolves a handle back to its client.
+ *
+ * The generation of the slot changes every time a client leaves it, so a handle
+ * taken on a previous occupant of the same fd never resolves to the new one.
+ * Clients marked for deletion are treated as already gone.
+ *
+ * @param handle The handle to resolve.
+ * @return A pointer to the client, or NULL if the handle is stale.
+ */
+Client* ClientTable::resolve(const ClientHandle& handle) const
+{
+	Client* client = get(handle.fd);
+	if (!client || _slots[handle.fd].generation != handle.generation || client->isMarkedForDeletion())
+		return NULL;
+	return client;
+}
+
+
+// === TABLE MANAGER ===
+
+/**
+ * @brief Stores a client in the slot of its file descriptor.
+ *
+ * The table grows to the size of the fd if needed, and the client is appended
+ * to the compact list of connected clients.
+ *
+ * @param client A pointer to the client to add.
+ */
+void ClientTable::add(Client* client)
+{
+	size_t fd = client->getFd();
+	if (fd >= _slots.size())
+		_slots.resize(fd + 1);
+
+	_slots[fd].client = client;
+	_slots[fd].livePos = _live.size();
+	_live.push_back(client);
+
+	if (static_cast<int>(fd) > _maxFd)
+		_maxFd = fd;
+}
+
+/**
+ * @brief Frees the slot of a client.
+ *
+ * The client is removed from the compact list by moving the last client into
+ * its position (swap and pop). The slot generation is incremented, which
+ * invalidates every handle taken on this client.
+ * The Client object itself is not destroyed, the caller keeps ownership.
+ *
+ * @param client A pointer to the client to remove.
+ */
+void ClientTable::remove(const Client* client)
+{
+	size_t fd = client->getFd();
+	if (fd >= _slots.size() || _slots[fd].client != client)
+		return;
+
+	size_t pos = _slots[fd].livePos;
+	if (pos != _live.size() - 1)
+	{
+		_live[pos] = _live.back();
+		_slots[_live[pos]->getFd()].livePos = pos;
+	}
+	_live.pop_back();
+
+	// Les slots ne sont jamais retirés : la génération doit survivre au départ du client
+	_slots[fd].client = NULL;
+	_slots[fd].livePos = 0;
+	++_slots[fd].generation;
+
+	// On redescend jusqu'au prochain slot occupé pour garder getMaxFd() en O(1)
+	if (static_cast<int>(fd) == _maxFd)
+		while (_maxFd >= 0 && !_slots[_maxFd].client)
+			--_maxFd;
+}
+
+
+// === CAPACITY ===
+
+void ClientTable::reserve(size_t count)
+{
+	_slots.reserve(count);
+	_live.reserve(count);
+}
+
+
+// === INFOS ===
+
+size_t ClientTable::size() const
+{
+	return _live.size();
+}
+bool ClientTable::empty() const
+{
+	return _live.empty();
+}
+int ClientTable::getMaxFd() const
+{
+	return _maxFd;
+}
+const std::vector<Client*>& ClientTable::getLiveClients() const
+{
+	return _live;
+}
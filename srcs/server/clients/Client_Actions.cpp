@@ -14,9 +14,13 @@
 
 // === OTHER CLASSES ===
 #include "Channel.hpp"
+#include "ChannelRegistry.hpp"
 #include "Utils.hpp"
 #include "IrcHelper.hpp"
 #include "MessageBuilder.hpp"
+#include "EpochReclaimer.hpp"
+#include "ScratchArena.hpp"
+#include "ServerStats.hpp"
 
 // === NAMESPACES ===
 #include "irc_config.hpp"
@@ -37,9 +41,9 @@
  * 
  * @param channelName The name of the channel to join.
  * @param password The password required to join the channel.
- * @param channels A map of existing channels where the key is the channel name and the value is a pointer to the Channel object.
+ * @param channels The registry of existing channels (case-insensitive lookup).
  */
-void Client::joinChannel(const std::string& channelName, const std::string& password, std::map<std::string, Channel*>& channels)
+void Client::joinChannel(const std::string& channelName, const std::string& password, ChannelRegistry& channels)
 {
 	if (!IrcHelper::isValidChannelName(channelName) || !Utils::isOnlyAlphaNum((channelName).substr(1)))
 	{
@@ -47,14 +51,13 @@ void Client::joinChannel(const std::string& channelName, const std::string& pass
 		return;
 	}
 
-	// Si le canal existe, on peut utiliser it->second (Channel*) pour ajouter le client
-	// (si addToChannel() renvoie false, il y a une erreur),
+	// Si le canal existe, on ajoute directement le client au Channel* trouvé,
 	// sinon on créé d'abord le channel et on ajoute le client ensuite.
-	if (IrcHelper::channelExists(channelName, channels))
+	Channel* channel = channels.find(channelName);
+	if (channel)
 	{
-		std::map<std::string, Channel*>::iterator it = channels.find(channelName); 
-		if (!isInChannel(channelName) )
-			addToChannel(it->second, password, channelName, channels);
+		if (!isInChannel(channel))
+			addToChannel(channel, password);
 		return;
 	}
 	createChannel(channelName, password, channels);
@@ -69,55 +72,49 @@ void Client::joinChannel(const std::string& channelName, const std::string& pass
  *
  * @param channelName The name of the channel to be created.
  * @param password The password for the channel. If empty, the channel will have no password.
- * @param channels A map of existing channels where the key is the channel name and the value is a pointer to the Channel object.
+ * @param channels The registry of existing channels, in which the new channel is registered.
  */
-void Client::createChannel(const std::string& channelName, const std::string& password, std::map<std::string, Channel*>& channels)
+void Client::createChannel(const std::string& channelName, const std::string& password, ChannelRegistry& channels)
 {
 	// Si le canal n'existe pas déjà, on le crée et on l'ajoute
-	if (!IrcHelper::channelExists(channelName, channels))
+	if (!channels.contains(channelName))
 	{
-		channels[channelName] = new Channel(channelName, password);
+		Channel* channel = new Channel(channelName, password);
+		channels.add(channel);
 		if (!password.empty())
 		{
 			if (!IrcHelper::isValidPassword(password, false))
 			{
 				sendMessage(MessageBuilder::ircInvalidPasswordFormat(_nickname, channelName), NULL);
-				deleteChannel(channels[channelName], channels);
+				deleteChannel(channel, channels);
 				return;
 			}
-			channels[channelName]->setPassword(password);
+			channel->setPassword(password);
 		}
 		std::cout << MessageBuilder::msgClientCreatedChannel(_nickname, channelName, password) << std::endl;
-		channels[channelName]->addOperator(this);
-		addToChannel(channels[channelName], password, channelName, channels);
+		channel->addOperator(this);
+		addToChannel(channel, password);
 	}
 }
 
 /**
  * @brief Adds the client to a specified channel if the conditions are met.
  *
- * This function attempts to add the client to the given channel. It first checks if the channel exists
- * and if the client is not already in the channel. If the channel exists and the client is not in it,
- * it verifies the provided password. If the password is correct, the client is added to the channel.
+ * This function attempts to add the client to the given channel, already resolved by the caller.
+ * If the client is not already in the channel, it verifies the invite-only mode, the provided password
+ * and the clients limit. If everything is right, the client is added to the channel.
  * The function also handles sending appropriate messages to the client and other channel members.
  *
  * @param channel A pointer to the Channel object to which the client is to be added.
  * @param password The password required to join the channel.
- * @param channelName The name of the channel.
  */
-void Client::addToChannel(Channel* channel, const std::string& password, const std::string& channelName, std::map<std::string, Channel*>& channels)
+void Client::addToChannel(Channel* channel, const std::string& password)
 {
-	if (!IrcHelper::channelExists(channelName, channels))
+	if (!isInChannel(channel))
 	{
-		sendMessage(MessageBuilder::ircNoSuchChannel(_nickname, channelName), NULL);
-		return;
-	}
-
-	if (!isInChannel(channelName))
-	{
-		if (channel->isInviteOnly() && channels[channelName]->isInvited(this) == false)
+		if (channel->isInviteOnly() && channel->isInvited(this) == false)
 		{
-			sendMessage(MessageBuilder::ircInviteOnly(getNickname(), channelName), NULL);
+			sendMessage(MessageBuilder::ircInviteOnly(getNickname(), channel->getName()), NULL);
 			return;
 		}
 
@@ -129,9 +126,9 @@ void Client::addToChannel(Channel* channel, const std::string& password, const s
 			return ;
 		}
 		channel->addClient(this);
-		_channelsJoined[channelName] = channel;
+		_channelsJoined[channel->getKey()] = channel;
 
-		msgAfterJoin(channel, channelName);
+		msgAfterJoin(channel, channel->getName());
 	}
 }
 
@@ -155,7 +152,7 @@ void Client::addToChannel(Channel* channel, const std::string& password, const s
  */
 void Client::msgAfterJoin(Channel* channel, const std::string& channelName)
 {
-	sendToAll(channel, MessageBuilder::ircClientJoinChannel(_usermask, channelName), false);
+	sendToAll(channel, MessageBuilder::ircClientJoinChannel(ScratchArena::string(), _usermask, channelName), false);
 	sendMessage((MessageBuilder::ircChannelModeIs(_nickname, channelName, channel->getModes())), NULL);
 	sendMessage(MessageBuilder::ircCreationTime(_nickname, channelName, channel->getCreationTime()), NULL);
 
@@ -246,7 +243,7 @@ void Client::isInvitedToChannel(Channel *channel, const Client* inviter)
 {	
 	if (!channel)
 		return;
-	if (!isInChannel(channel->getName()))
+	if (!isInChannel(channel))
 		channel->addClientToInvitedList(this, inviter);
 	else
 		inviter->sendMessage(MessageBuilder::ircAlreadyOnChannel(inviter->getNickname(), _nickname, channel->getName()), NULL);
@@ -255,13 +252,12 @@ void Client::isInvitedToChannel(Channel *channel, const Client* inviter)
 /**
  * @brief Removes the client from the specified channel and deletes the channel if it becomes empty.
  * 
- * @param it Iterator pointing to the channel in the channels map.
- * @param channels Reference to the map of channels.
+ * @param channel Pointer to the channel to leave.
+ * @param channels Reference to the channel registry.
  */
-void Client::leaveChannel(std::map<std::string, Channel*>::iterator it, std::map<std::string, Channel*>& channels, const std::string& reason, int reasonCode)
+void Client::leaveChannel(Channel* channel, ChannelRegistry& channels, const std::string& reason, int reasonCode)
 {
-	Channel* channel = it->second;
-	if (channel && isInChannel(channel->getName()))
+	if (channel && isInChannel(channel))
 	{
 		channel->removeClient(this, NULL, reason, reasonCode);
 
@@ -277,36 +273,51 @@ void Client::leaveChannel(std::map<std::string, Channel*>::iterator it, std::map
  * makes the client leave each one. It uses the leaveChannel function to 
  * handle the process of leaving each channel.
  *
- * @param channels A map of channel names to Channel pointers, representing 
- * all available channels.
+ * @param channels The registry of all available channels.
  */
-void Client::leaveAllChannels(std::map<std::string, Channel*>& channels, const std::string& reason, int reasonCode)
+void Client::leaveAllChannels(ChannelRegistry& channels, const std::string& reason, int reasonCode)
 {
 	while (!_channelsJoined.empty())
-		leaveChannel(_channelsJoined.begin(), channels, reason, reasonCode);
+		leaveChannel(_channelsJoined.begin()->second, channels, reason, reasonCode);
 }
 
 /**
  * @brief Deletes a channel if it has no clients.
  *
  * This function checks if the given channel has no clients. If the channel is empty,
- * it removes the channel from the provided map of channels, prints messages indicating
- * that the channel had no clients and that it has been destroyed, and then deletes the channel.
+ * it removes the channel from the channel registry and from the invitations of its
+ * invited clients, prints messages indicating that the channel had no clients and that
+ * it has been destroyed, and then retires the channel: the EpochReclaimer deletes it
+ * at the end of the loop iteration, once no reader can still use it.
  *
  * @param channel A pointer to the Channel object to be deleted.
- * @param channels A reference to a map of channel names to Channel pointers, from which the channel will be removed.
+ * @param channels A reference to the channel registry, from which the channel will be removed.
  */
-void Client::deleteChannel(Channel* channel, std::map<std::string, Channel*>& channels)
+void Client::deleteChannel(Channel* channel, ChannelRegistry& channels)
 {
 	if (!channel->hasClients())
 	{
 		std::cout << MessageBuilder::msgNoClientInChannel(channel->getName()) << std::endl;
 		std::cout << MessageBuilder::msgChannelDestroyed(channel->getName()) << std::endl;
-		channels.erase(channel->getName());
-		delete channel;
+		channels.remove(channel);
+		channel->withdrawInvitations();
+		EpochReclaimer::retire(channel);
 	}
 }
 
+/**
+ * @brief Removes the client from the invitation list of every channel that invited it.
+ *
+ * Called when the client is deleted, so that no channel member table keeps a pointer to it.
+ */
+void Client::withdrawInvitations()
+{
+	if (!_details)
+		return;
+	while (!_details->channelsInvited.empty())
+		_details->channelsInvited.begin()->second->removeInvitation(this);
+}
+
 
 // === SEND MESSAGES (TO CLIENTS OR CHANNEL) ===
 
@@ -316,20 +327,43 @@ void Client::deleteChannel(Channel* channel, std::map<std::string, Channel*>& ch
  * This function formats the given message using the IRC format and sends it to the client
  * associated with this instance. If the message length exceeds the buffer size, an error
  * message is generated and sent to the sender if provided.
+ * What the socket does not accept right away is kept in the send queue, in order,
+ * and flushed when select() reports the socket writable. A client whose send queue
+ * would exceed server::SENDQ_MAX stops receiving anything: the server disconnects it
+ * at the start of the next loop iteration ("SendQ exceeded").
  *
  * @param message The message to be sent.
  * @param sender The client sending the message, used to send error messages if the message is too long.
  */
 void Client::sendMessage(const std::string &message, Client* sender) const
 {
-	// On formate le message en IRC (ajout du \r\n, si trop long tronqué à 512 caractères)
-	std::string formattedMessage = MessageBuilder::ircFormat(message);
-	if (send(_clientSocketFd, formattedMessage.c_str(), formattedMessage.length(), MSG_NOSIGNAL) == -1)
+	if (_flags & client_flag::SENDQ_EXCEEDED)
+		return;
+
+	// On formate le message en IRC directement dans la file d'envoi (si trop long tronqué à 512 caractères, \r\n compris) :
+	// la file garde sa capacité d'un message à l'autre, aucune chaîne intermédiaire n'est allouée
+	size_t length = message.length() > server::BUFFER_SIZE ? server::BUFFER_SIZE : message.length();
+	size_t formattedLength = length + eol::IRC.length();
+	if (_sendQueue.size() + formattedLength > server::SENDQ_MAX)
 	{
-		perror("send() failed");
+		_flags |= client_flag::SENDQ_EXCEEDED;
+		_sendQueueTotal -= _sendQueue.size();
+		std::string().swap(_sendQueue);
 		return;
 	}
 
+	bool nothingPending = _sendQueue.empty();
+	_sendQueue.append(message, 0, length);
+	_sendQueue.append(eol::IRC);
+	_sendQueueTotal += formattedLength;
+	ServerStats::countLineOut();
+	if (_recvQueueTotal + _sendQueueTotal > _queuePeak)
+		_queuePeak = _recvQueueTotal + _sendQueueTotal;
+
+	// Rien n'attendait : envoi direct (sinon le message attend son tour, select() signalera le socket prêt)
+	if (nothingPending)
+		flushSendQueue();
+
 	// Si le message d'origine a été tronqué car trop long, on prévient le sender (cas PRIVMSG).
 	// Si ce même message est envoyé dans un channel ou à plusieurs personnes,
 	// l'erreur ne sera envoyée qu'une seule fois à l'envoyeur grâce à un booléen qu'on set à true
@@ -340,6 +374,36 @@ void Client::sendMessage(const std::string &message, Client* sender) const
 	}
 }
 
+/**
+ * @brief Sends as much of the send queue as the socket accepts.
+ *
+ * Called when select() reports the socket writable, and once more before the client is deleted.
+ * On a socket error the queue is dropped: the peer is gone and the next read will report it.
+ */
+void Client::flushSendQueue() const
+{
+	if (_sendQueue.empty())
+		return;
+
+	ssize_t bytesSent = send(_clientSocketFd, _sendQueue.data(), _sendQueue.size(), MSG_NOSIGNAL);
+	if (bytesSent == -1)
+	{
+		if (errno == EAGAIN || errno == EWOULDBLOCK)
+			return;
+		perror("send() failed");
+		bytesSent = _sendQueue.size();
+	}
+	else
+		ServerStats::countBytesOut(bytesSent);
+	_sendQueue.erase(0, bytesSent);
+	_sendQueueTotal -= bytesSent;
+
+	// File vidée : on rend la mémoire d'une file qui a beaucoup grossi,
+	// ou de toute file d'un client en hibernation (un PING ou un message de canal ne doit pas le réveiller)
+	if (_sendQueue.empty() && (_sendQueue.capacity() > server::BUFFER_SIZE * 4 || _hasFlag(client_flag::HIBERNATING)))
+		std::string().swap(_sendQueue);
+}
+
 /**
  * @brief Sends a message to all clients in the specified channel.
  *
@@ -353,4 +417,101 @@ void Client::sendMessage(const std::string &message, Client* sender) const
 void Client::sendToAll(Channel* channel, const std::string &message, bool includeSender)
 {
 	channel->sendToAll(message, this, includeSender);
-}
\ No newline at end of file
+}
+
+// === HIBERNATION ===
+
+/**
+ * @brief Puts an idle client into hibernation.
+ *
+ * Buffers keep the capacity their last burst grew them to: an empty receive
+ * or send queue gives its memory back, and the strings of the cold record are
+ * shrunk to their size (Irssi ident commands are only needed during registration).
+ * Nothing is lost: a hibernating client stays fully usable and wakes up
+ * as soon as it sends data.
+ */
+void Client::hibernate()
+{
+	if (_bufferMessage.empty())
+		std::string().swap(_bufferMessage);
+	if (_sendQueue.empty())
+		std::string().swap(_sendQueue);
+
+	_shrinkToFit(_nickname);
+	_shrinkToFit(_usermask);
+	_shrinkToFit(_clientIp);
+	if (_details)
+	{
+		_shrinkToFit(_details->username);
+		_shrinkToFit(_details->realName);
+		_shrinkToFit(_details->hostname);
+		_shrinkToFit(_details->resolvedHost);
+		_shrinkToFit(_details->awayMessage);
+		if (isAuthenticated())
+		{
+			std::vector<std::string>().swap(_details->identNicknameCmd);
+			std::vector<std::string>().swap(_details->identUsernameCmd);
+		}
+	}
+	_setFlag(client_flag::HIBERNATING, true);
+}
+
+/**
+ * @brief Brings a client back from hibernation.
+ *
+ * Buffers grow again on demand, so waking up only clears the state and stamps the time:
+ * the client will not be compacted again before server::HIBERNATE_DELAY of inactivity,
+ * counted from the wakeup (received bytes without a full line do not count as activity).
+ */
+void Client::wakeUp()
+{
+	_setFlag(client_flag::HIBERNATING, false);
+	_wakeTime = time(NULL);
+}
+
+/**
+ * @brief Estimates the memory held by the client.
+ *
+ * Counts the pooled objects (hot and cold records), the heap blocks of their
+ * strings and vectors, and the nodes of the channel maps.
+ *
+ * @return The estimated number of bytes.
+ */
+size_t Client::getMemoryFootprint() const
+{
+	// Noeud d'arbre rouge-noir : couleur + 3 pointeurs, puis la paire clé/valeur
+	const size_t mapNode = 4 * sizeof(void*) + sizeof(std::pair<const Symbol, Channel*>);
+
+	size_t bytes = sizeof(Client) + _heapSize(_nickname) + _heapSize(_usermask) + _heapSize(_clientIp)
+		+ _heapSize(_bufferMessage) + _heapSize(_sendQueue) + _channelsJoined.size() * mapNode;
+	if (!_details)
+		return bytes;
+
+	bytes += sizeof(ClientDetails) + _heapSize(_details->username) + _heapSize(_details->realName)
+		+ _heapSize(_details->hostname) + _heapSize(_details->resolvedHost) + _heapSize(_details->awayMessage)
+		+ _details->channelsInvited.size() * mapNode;
+
+	const std::vector<std::string>* identCmds[2] = {&_details->identNicknameCmd, &_details->identUsernameCmd};
+	for (size_t i = 0; i < 2; i++)
+	{
+		bytes += identCmds[i]->capacity() * sizeof(std::string);
+		for (std::vector<std::string>::const_iterator it = identCmds[i]->begin(); it != identCmds[i]->end(); ++it)
+			bytes += _heapSize(*it);
+	}
+	return bytes;
+}
+
+// ========================================= PRIVATE =======================================
+
+void Client::_shrinkToFit(std::string& str)
+{
+	if (_heapSize(str) > str.size() + 1)
+		std::string(str).swap(str);
+}
+
+size_t Client::_heapSize(const std::string& str)
+{
+	// Une chaîne vide donne la capacité du stockage interne (small string optimization)
+	static const size_t inlineCapacity = std::string().capacity();
+	return str.capacity() > inlineCapacity ? str.capacity() + 1 : 0;
+}
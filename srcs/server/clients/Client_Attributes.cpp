@@ -14,6 +14,11 @@
 
 // === OTHER CLASSES ===
 #include "Channel.hpp"
+#include "IrcHelper.hpp"
+#include "Utils.hpp"
+
+// === NAMESPACES ===
+#include "irc_config.hpp"
 
 // =========================================================================================
 
@@ -27,31 +32,39 @@
 
 void Client::setClientPort(int port)
 {
-	_port = port;
+	_clientPort = port;
 }
 void Client::setNickname(const std::string &nickname)
 {
+	// On interne le nouveau pseudo casefoldé avant de libérer l'ancien symbole
+	Symbol oldKey = _nicknameKey;
+	_nicknameKey = StringPool::intern(IrcHelper::toIrcLower(nickname));
+	StringPool::release(oldKey);
 	_nickname = nickname;
 }
 void Client::setUsername(const std::string &username)
 {
-	_username = username;
+	_getDetails().username = username;
 }
 void Client::setRealName(const std::string &realName)
 {
-	_realName = realName;
+	_getDetails().realName = realName;
 }
 void Client::setHostname(const std::string &hostname)
 {
-	_hostname = hostname;
+	_getDetails().hostname = hostname;
 }
 void Client::setClientIp(const std::string &clientIp)
 {
 	_clientIp = clientIp;
 }
+void Client::setResolvedHost(const std::string &hostname)
+{
+	_getDetails().resolvedHost = hostname;
+}
 void Client::setUsermask()
 {
-	_usermask = _nickname + "!" + _username + "@" + _clientIp;
+	_usermask = _nickname + "!" + getUsername() + "@" + getVisibleHost();
 }
 
 
@@ -59,27 +72,35 @@ void Client::setUsermask()
 
 void Client::setIsIrssi(bool status)
 {
-	_isIrssi = status;
+	_setFlag(client_flag::IRSSI, status);
 }
 void Client::setIdentified(bool status)
 {
-	_isIdentified = status;
+	_setFlag(client_flag::IDENTIFIED, status);
 }
 void Client::setIdentNickCmd(std::vector<std::string> identCmd)
 {
-	_identNicknameCmd = identCmd;
+	_getDetails().identNicknameCmd = identCmd;
 }
 void Client::setIdentUsernameCmd(std::vector<std::string> identCmd)
 {
-	_identUsernameCmd = identCmd;
+	_getDetails().identUsernameCmd = identCmd;
 }
 void Client::setServPasswordValidity(bool status)
 {
-	_rightPassServ = status;
+	_setFlag(client_flag::RIGHT_PASS_SERV, status);
+}
+void Client::setHostLookupPending(bool status)
+{
+	_setFlag(client_flag::HOST_LOOKUP_PENDING, status);
+}
+void Client::setServerOperator(bool status)
+{
+	_setFlag(client_flag::SERVER_OPERATOR, status);
 }
 void Client::authenticate()
 {
-	_authenticated = true;
+	_setFlag(client_flag::AUTHENTICATED, true);
 }
 
 
@@ -91,19 +112,30 @@ void Client::setLastActivity()
 }
 void Client::setIsAway(bool status)
 {
-	_isAway = status;
+	_setFlag(client_flag::AWAY, status);
 }
 void Client::setAwayMessage(const std::string& message)
 {
-	_awayMessage = message;
+	_getDetails().awayMessage = message;
 }
 void Client::setErrorMsgTooLongSent(bool status)
 {
-	_errorMsgTooLongSent = status;
+	_setFlag(client_flag::ERROR_MSG_TOO_LONG_SENT, status);
 }
 void Client::setPingSent(bool status)
 {
-	_pingSent = status;
+	_setFlag(client_flag::PING_SENT, status);
+}
+void Client::markForDeletion()
+{
+	_setFlag(client_flag::MARKED_FOR_DELETION, true);
+}
+bool Client::stampFanout(unsigned long epoch)
+{
+	if (_fanoutStamp == epoch)
+		return false;
+	_fanoutStamp = epoch;
+	return true;
 }
 
 // =========================================================================================
@@ -118,28 +150,38 @@ int Client::getFd() const
 }
 int Client::getClientPort() const
 {
-	return _port;
+	return _clientPort;
 }
 const std::string& Client::getNickname() const
 {
 	return _nickname;
 }
+Symbol Client::getNicknameKey() const
+{
+	return _nicknameKey;
+}
 const std::string& Client::getUsername() const
 {
-	return _username;
+	return (_details ? *_details : _emptyDetails()).username;
 }
 const std::string& Client::getRealName() const
 {
-	return _realName;
+	return (_details ? *_details : _emptyDetails()).realName;
 }
 const std::string& Client::getHostname() const
 {
-	return _hostname;
+	return (_details ? *_details : _emptyDetails()).hostname;
 }
 const std::string& Client::getClientIp() const
 {
 	return _clientIp;
 }
+const std::string& Client::getVisibleHost() const
+{
+	if (!_details || _details->resolvedHost.empty())
+		return _clientIp;
+	return _details->resolvedHost;
+}
 const std::string& Client::getUsermask() const
 {
 	return _usermask;
@@ -150,27 +192,35 @@ const std::string& Client::getUsermask() const
 
 bool Client::isIrssi() const
 {
-	return _isIrssi;
+	return _hasFlag(client_flag::IRSSI);
 }
 bool Client::isIdentified() const
 {
-	return _isIdentified;
+	return _hasFlag(client_flag::IDENTIFIED);
 }
 std::vector<std::string> Client::getIdentNickCmd() const
 {
-	return _identNicknameCmd;
+	return (_details ? *_details : _emptyDetails()).identNicknameCmd;
 }
 std::vector<std::string> Client::getIdentUsernameCmd() const
 {
-	return _identUsernameCmd;
+	return (_details ? *_details : _emptyDetails()).identUsernameCmd;
 }
 bool Client::gotValidServPassword() const
 {
-	return _rightPassServ;
+	return _hasFlag(client_flag::RIGHT_PASS_SERV);
 }
 bool Client::isAuthenticated() const
 {
-	return _authenticated;
+	return _hasFlag(client_flag::AUTHENTICATED);
+}
+bool Client::isHostLookupPending() const
+{
+	return _hasFlag(client_flag::HOST_LOOKUP_PENDING);
+}
+bool Client::isServerOperator() const
+{
+	return _hasFlag(client_flag::SERVER_OPERATOR);
 }
 
 
@@ -184,37 +234,58 @@ time_t Client::getLastActivity() const
 {
 	return _lastActivity;
 }
+time_t Client::getWakeTime() const
+{
+	return _wakeTime;
+}
 time_t Client::getIdleTime() const
 {
 	return time(NULL) - _lastActivity;
 }
 bool Client::isAway() const
 {
-	return _isAway;
+	return _hasFlag(client_flag::AWAY);
 }
 const std::string& Client::getAwayMessage() const
 {
-	return _awayMessage;
+	return (_details ? *_details : _emptyDetails()).awayMessage;
 }
 bool Client::errorMsgTooLongSent() const
 {
-	return _errorMsgTooLongSent;
+	return _hasFlag(client_flag::ERROR_MSG_TOO_LONG_SENT);
 }
 bool Client::pingSent() const
 {
-	return _pingSent;
+	return _hasFlag(client_flag::PING_SENT);
+}
+bool Client::isMarkedForDeletion() const
+{
+	return _hasFlag(client_flag::MARKED_FOR_DELETION);
+}
+bool Client::isHibernating() const
+{
+	return _hasFlag(client_flag::HIBERNATING);
 }
 
 
 // === RELATED CHANNELS ===
 
-std::map<std::string, Channel*>& Client::getChannelsJoined()
+std::map<Symbol, Channel*>& Client::getChannelsJoined()
 {
 	return _channelsJoined;
 }
+std::map<Symbol, Channel*>& Client::getChannelsInvited()
+{
+	return _getDetails().channelsInvited;
+}
 bool Client::isInChannel(const std::string& channelName) const
 {
-	return _channelsJoined.find(channelName) != _channelsJoined.end();
+	Symbol key = StringPool::find(IrcHelper::toIrcLower(channelName));
+	return key && _channelsJoined.find(key) != _channelsJoined.end();
+}
+bool Client::isInChannel(const Channel* channel) const
+{
+	return _channelsJoined.find(channel->getKey()) != _channelsJoined.end();
 }
 bool Client::isOperator(Channel* channel) const
 {
@@ -226,9 +297,104 @@ bool Client::isInvited(const Channel* channel) const
 }
 
 
-// === BUFFER ===
+// === RECEIVE / SEND QUEUES ===
 
-std::string& Client::getBufferMessage()
+void Client::appendToRecvQueue(const char* data)
 {
-	return _bufferMessage;
+	if (_hasFlag(client_flag::HIBERNATING))
+		wakeUp();
+
+	size_t before = _bufferMessage.size();
+	_bufferMessage.append(data);
+	_recvQueueTotal += _bufferMessage.size() - before;
+	if (_recvQueueTotal + _sendQueueTotal > _queuePeak)
+		_queuePeak = _recvQueueTotal + _sendQueueTotal;
+}
+
+/**
+ * @brief Extracts the next complete line from the receive buffer.
+ *
+ * @param line Receives the line, without its \n (and without the \r sent by irssi).
+ * @return true if a line was extracted, false if the buffer holds no \n.
+ */
+bool Client::extractLine(std::string& line)
+{
+	size_t pos = _bufferMessage.find('\n');
+	if (pos == std::string::npos)
+		return false;
+
+	line = Utils::extractAndCleanMessage(_bufferMessage, pos);
+	_recvQueueTotal -= pos + 1;
+	return true;
+}
+
+size_t Client::getRecvQueueSize() const
+{
+	return _bufferMessage.size();
+}
+bool Client::hasCompleteLine() const
+{
+	return _bufferMessage.find('\n') != std::string::npos;
+}
+size_t Client::getSendQueueSize() const
+{
+	return _sendQueue.size();
+}
+bool Client::hasPendingOutput() const
+{
+	return !_sendQueue.empty();
+}
+bool Client::sendQueueExceeded() const
+{
+	return _hasFlag(client_flag::SENDQ_EXCEEDED);
+}
+size_t Client::getTotalQueued(bool sendQueue)
+{
+	return sendQueue ? _sendQueueTotal : _recvQueueTotal;
+}
+size_t Client::getPeakQueued()
+{
+	return _queuePeak;
+}
+
+
+// =========================================================================================
+
+// === FLAGS / COLD RECORD ===
+
+// ========================================= PRIVATE =======================================
+
+bool Client::_hasFlag(int flag) const
+{
+	return (_flags & flag) != 0;
+}
+void Client::_setFlag(int flag, bool status)
+{
+	if (status)
+		_flags |= flag;
+	else
+		_flags &= ~flag;
+}
+
+/**
+ * @brief Retrieves the cold record of the client, allocating it on first use.
+ *
+ * @return A reference to the cold record.
+ */
+ClientDetails& Client::_getDetails()
+{
+	if (!_details)
+		_details = new (_detailsPool.allocate()) ClientDetails();
+	return *_details;
+}
+
+/**
+ * @brief Default values returned by the getters while the cold record does not exist.
+ *
+ * @return A reference to an empty cold record.
+ */
+const ClientDetails& Client::_emptyDetails()
+{
+	static const ClientDetails empty;
+	return empty;
 }
\ No newline at end of file
@@ -15,6 +15,8 @@
 // === OTHER CLASSES ===
 #include "Utils.hpp"
 #include "MessageBuilder.hpp"
+#include "ScratchArena.hpp"
+#include "ServerStats.hpp"
 
 // === NAMESPACES ===
 #include "commands.hpp"
@@ -34,10 +36,11 @@ using namespace commands;
  * @brief A static map that associates command names with member function pointers.
  * 
  * This map stores associations between command strings and corresponding 
- * member functions in the Command class, with the signature `void Command::functionName()`.
+ * member functions in the Command class, with the signature `void Command::functionName()`,
+ * along with the index of the command's counter in ServerStats.
  * It is shared across all instances of the Command class.
  */
-std::map<std::string, void (Command::*)()>Command::_fctMap;
+std::map<std::string, Command::Handler>Command::_fctMap;
 
 /**
  * @brief Initializes the function map (_fctMap) with command handlers.
@@ -52,38 +55,69 @@ void Command::_initFctMap()
 	if (_fctMap.empty())
 	{
 		// === AUTHENTICATE COMMANDS : Command_Auth.cpp ===
-		_fctMap[PASS] 			= &Command::_isRightPassword;
-		_fctMap[NICK] 			= &Command::_setNicknameClient;
-		_fctMap[USER] 			= &Command::_setUsernameClient;
-		_fctMap[CAP] 			= &Command::_handleCapabilities;
+		_addHandler(PASS, 			&Command::_isRightPassword);
+		_addHandler(NICK, 			&Command::_setNicknameClient);
+		_addHandler(USER, 			&Command::_setUsernameClient);
+		_addHandler(CAP, 			&Command::_handleCapabilities);
 		
 		// === CHANNEL COMMANDS : Command_Channel.cpp ===
-		_fctMap[INVITE] 		= &Command::_inviteChannel;
-		_fctMap[JOIN] 			= &Command::_joinChannel;
-		_fctMap[TOPIC] 			= &Command::_setTopic;
-		_fctMap[KICK] 			= &Command::_kickChannel;
-		_fctMap[PART] 			= &Command::_quitChannel;
+		_addHandler(INVITE, 		&Command::_inviteChannel);
+		_addHandler(JOIN, 			&Command::_joinChannel);
+		_addHandler(TOPIC, 			&Command::_setTopic);
+		_addHandler(KICK, 			&Command::_kickChannel);
+		_addHandler(PART, 			&Command::_quitChannel);
 	
 		// === MODE COMMANDS : Command_Mode.cpp ===
-		_fctMap[MODE] 			= &Command::_handleMode;
+		_addHandler(MODE, 			&Command::_handleMode);
 	
 		// === MESSAGE COMMANDS : Command_Message.cpp ===
-		_fctMap[PRIVMSG] 		= &Command::_sendPrivateMessage;
+		_addHandler(PRIVMSG, 		&Command::_sendPrivateMessage);
 	
 		// === LOG COMMANDS : Command_Log.cpp ===
-		_fctMap[PING] 			= &Command::_sendPong;
-		_fctMap[PONG] 			= &Command::_updateActivity;
-		_fctMap[WHO] 			= &Command::_handleWho;
-		_fctMap[WHOIS] 			= &Command::_handleWhois;
-		_fctMap[WHOWAS] 		= &Command::_handleWhowas;
-		_fctMap[AWAY] 			= &Command::_setAway;
-		_fctMap[QUIT] 			= &Command::_quitServer;
+		_addHandler(PING, 			&Command::_sendPong);
+		_addHandler(PONG, 			&Command::_updateActivity);
+		_addHandler(WHO, 			&Command::_handleWho);
+		_addHandler(WHOIS, 			&Command::_handleWhois);
+		_addHandler(WHOWAS, 		&Command::_handleWhowas);
+		_addHandler(AWAY, 			&Command::_setAway);
+		_addHandler(LUSERS, 		&Command::_sendUserStats);
+		_addHandler(OPER, 			&Command::_becomeOperator);
+		_addHandler(STATS, 			&Command::_sendServerStats);
+		_addHandler(QUIT, 			&Command::_quitServer);
 	
 		// === FILE COMMANDS : Command_File.cpp ===
-		_fctMap[DCC] 			= &Command::_handleFile;
+		_addHandler(DCC, 			&Command::_handleFile);
 	}
 }
 
+/**
+ * @brief Adds a command to the function map, with the index of its counter.
+ *
+ * @param name The name of the command.
+ * @param function The member function that runs it.
+ */
+void Command::_addHandler(const std::string& name, void (Command::*function)())
+{
+	Handler handler;
+	handler.function = function;
+	handler.statsId = ServerStats::registerCommand(name);
+	_fctMap[name] = handler;
+}
+
+/**
+ * @brief Counts the command, then runs its handler under a latency timer.
+ *
+ * The timer records on destruction, so a command that throws (IRC error) is measured too.
+ *
+ * @param handler The entry of the command in the function map.
+ */
+void Command::_dispatch(const Handler& handler)
+{
+	ServerStats::countCommand(handler.statsId);
+	ServerStats::Timer timer(handler.statsId, _clientFd);
+	(this->*handler.function)();
+}
+
 
 // ========================================= PUBLIC ========================================
 
@@ -92,21 +126,27 @@ void Command::_initFctMap()
 /**
  * @brief Constructs a Command object associated with a specific client.
  * It also initializes the function map used for command handling.
+ * The token list of the input is borrowed from the per-command arena.
  * 
  * @param server A reference to the Server object managing the IRC server.
- * @param itClient An iterator pointing to a specific element in a map where
- *                 the key is an integer (e.g., client ID) and the value is a
- *                 pointer to a Client object. This iterator is used to
- *                 identify and interact with the corresponding client.
+ * @param client A pointer to the client who sent the command.
  */
-Command::Command(Server& server, std::map<int, Client*>::iterator itClient)
-	: _server(server), _it(itClient), _clientFd(_it->first), _client(_it->second),
-	_clients(_server.getClients()), _channels(_server.getChannels())
+Command::Command(Server& server, Client* client)
+	: _server(server), _clientFd(client->getFd()), _client(client),
+	_channels(_server.getChannels()), _vectorInput(ScratchArena::tokens())
 {
 	_initFctMap();
 }
 
-Command::~Command() {}
+/**
+ * @brief Ends the command: every temporary borrowed from the arena is given back.
+ *
+ * Also runs when the command throws, before the error reply is sent.
+ */
+Command::~Command()
+{
+	ScratchArena::reset();
+}
 
 
 // === COMMAND MANAGER : MAIN METHOD ===
@@ -127,7 +167,7 @@ void Command::manageCommand(const std::string& input)
 	if (input.empty())
 		return;
 		
-	_vectorInput = Utils::getTokens(input, splitter::SENTENCE);	
+	ScratchArena::split(input, splitter::SENTENCE, _vectorInput);
 	_itInput = _vectorInput.begin();
 
 	std::string nickname = _client->isAuthenticated() ? _client->getNickname() : "*";
@@ -144,7 +184,7 @@ void Command::manageCommand(const std::string& input)
 	
 	std::string cmd = *_itInput;
 	
-	std::map<std::string, void (Command::*)()>::iterator itFunction = _fctMap.find(cmd);;
+	std::map<std::string, Handler>::iterator itFunction = _fctMap.find(cmd);
 	if (itFunction == _fctMap.end())
 		throw std::invalid_argument(MessageBuilder::ircUnknownCommand(nickname, input));
 	
@@ -153,5 +193,5 @@ void Command::manageCommand(const std::string& input)
 	if (Utils::paramCheckNeeded(cmd) && Utils::isEmptyOrInvalid(_itInput, _vectorInput))
 		throw std::invalid_argument(MessageBuilder::ircNeedMoreParams(nickname, cmd));
 
-	(this->*itFunction->second)();
+	_dispatch(itFunction->second);
 }
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "Utils.hpp"
 #include "IrcHelper.hpp"
 #include "MessageBuilder.hpp"
+#include "ScratchArena.hpp"
 
 // === NAMESPACES ===
 #include "commands.hpp"
@@ -50,7 +51,7 @@ using namespace server_messages;
  */
 void Command::_inviteChannel()
 {
-	std::vector<std::string> args = Utils::getTokens(*_itInput, splitter::WORD);
+	std::vector<std::string>& args = ScratchArena::split(*_itInput, splitter::WORD);
 	int n_arg = args.size();
 
 	// Si plus de deux arguments apres split, le format est invalide
@@ -63,19 +64,17 @@ void Command::_inviteChannel()
 	std::vector<std::string>::iterator itChannel = ++args.begin();
 	std::string channelName = itChannel != args.end() ? IrcHelper::fixChannelMask(*itChannel) : "";
 
-	if (IrcHelper::channelExists(channelName, _channels) == false) 
+	Channel* channel = _channels.find(channelName);
+	if (!channel)
 		throw std::invalid_argument(MessageBuilder::ircNoSuchChannel(_client->getNickname(), channelName));
 		
-	// Verifie l'existence du client sur le serveur, si non retourne -1
-	int invitedClientFd = _server.getClientByNickname(invitedName, _client);
-	if (IrcHelper::clientExists(invitedClientFd) == false)
+	// Verifie l'existence du client sur le serveur, si non retourne NULL
+	Client* invitedClient = _server.getClientByNickname(invitedName, _client);
+	if (!invitedClient)
 		throw std::invalid_argument(MessageBuilder::ircNoSuchNick(_client->getNickname(), invitedName));
 
-	Channel* channel = _channels[channelName];
-	Client* invitedClient = _clients[invitedClientFd];
-
 	// Verifie que le client qui fait la demande est bien dans le channel concerne
-	if (!_client->isInChannel(channelName))
+	if (!_client->isInChannel(channel))
 		throw std::invalid_argument(MessageBuilder::ircCurrentNotInChannel(_client->getNickname(), channel->getName())); 
 	
 	// Verifie que si le mode "+i" est present, le client faisant la requete est bien operator
@@ -102,7 +101,7 @@ void Command::_inviteChannel()
  */
 void Command::_joinChannel()
 {	
-	std::vector<std::string> args = Utils::getTokens(*_itInput, splitter::WORD);
+	std::vector<std::string>& args = ScratchArena::split(*_itInput, splitter::WORD);
 
 	// Si plus de deux arguments apres split, le format est invalide
 	if (args.size() > 2)
@@ -110,11 +109,11 @@ void Command::_joinChannel()
 
 	// On recupere les channels a join
 	std::vector<std::string>::iterator itArg = args.begin();
-	std::vector<std::string> channelsToJoin = Utils::getTokens(*itArg, splitter::COMMA);
+	std::vector<std::string>& channelsToJoin = ScratchArena::split(*itArg, splitter::COMMA);
 	++itArg;
 
 	// On recupere les mots de passe associes aux channels s'il y en a
-	std::vector<std::string> passwords = (itArg != args.end()) ? Utils::getTokens(*itArg, splitter::COMMA) : std::vector<std::string>();
+	std::vector<std::string>& passwords = (itArg != args.end()) ? ScratchArena::split(*itArg, splitter::COMMA) : ScratchArena::tokens();
 	std::vector<std::string>::iterator itPassword = passwords.begin();
 
 	// On boucle sur tous les channels a join
@@ -151,14 +150,14 @@ void Command::_joinChannel()
  */
 void Command::_setTopic()
 {
-	std::vector<std::string> args = Utils::getTokens(*_itInput, splitter::SENTENCE);
+	std::vector<std::string>& args = ScratchArena::split(*_itInput, splitter::SENTENCE);
 	std::vector<std::string>::iterator itChannel = args.begin();
 	std::string channelName = itChannel != args.end() ? IrcHelper::fixChannelMask(*itChannel) : "";
 
-	if (IrcHelper::channelExists(channelName, _channels) == false) 
+	Channel* channel = _channels.find(channelName);
+	if (!channel)
 		throw std::invalid_argument(MessageBuilder::ircNoSuchChannel(_client->getNickname(), channelName));
-
-	Channel* channel = _channels[channelName];
+	channelName = channel->getName();
 
 	// Si pas de nouveau topic en argument, on send le topic actuel du channel
 	std::vector<std::string>::iterator itTopic = ++args.begin();
@@ -207,7 +206,7 @@ void Command::_setTopic()
  */
 void Command::_kickChannel()
 {
-	std::vector<std::string> args = Utils::getTokens(*_itInput, splitter::SENTENCE);
+	std::vector<std::string>& args = ScratchArena::split(*_itInput, splitter::SENTENCE);
 	std::vector<std::string>::iterator itArg = args.begin();
 
 	// On récupère le nom du channel
@@ -216,25 +215,25 @@ void Command::_kickChannel()
 	if (itArg == args.end())
 		throw std::invalid_argument(MessageBuilder::ircNeedMoreParams(_client->getNickname(), KICK));
 
-	args = Utils::getTokens(*itArg, splitter::WORD);
-	itArg = args.begin();
+	std::vector<std::string>& words = ScratchArena::split(*itArg, splitter::WORD);
+	itArg = words.begin();
 	
 	// On récupère les noms des clients à kicker
-	std::vector<std::string> kickedClients = Utils::getTokens(*itArg, splitter::COMMA);
+	std::vector<std::string>& kickedClients = ScratchArena::split(*itArg, splitter::COMMA);
 	++itArg;
 
 	// On récupère la raison du kick s'il y en a une, sinon on la parametre par defaut
-	std::string reason = Utils::stockVector(itArg, args);
+	std::string reason = Utils::stockVector(itArg, words);
 	reason = Utils::truncateStr(IrcHelper::sanitizeIrcMessage(reason, KICK, _client->getNickname()));
 	if (reason.empty() || Utils::isOnlySpace(reason) == true || ((reason)[0] == ':' && (reason).size() == 1))
 		reason = DEFAULT_KICK_REASON;
 	
 	// Si le channel n'existe pas, on throw une erreur
 	channelName = IrcHelper::fixChannelMask(channelName);
-	if (IrcHelper::channelExists(channelName, _channels) == false) 
+	Channel* channel = _channels.find(channelName);
+	if (!channel)
 		throw std::invalid_argument(MessageBuilder::ircNoSuchChannel(_client->getNickname(), channelName));
-
-	Channel* channel = _channels[channelName];
+	channelName = channel->getName();
 
 	// On boucle sur tous les clients a kick
 	for (std::vector<std::string>::iterator itClient = kickedClients.begin(); itClient != kickedClients.end(); itClient++)
@@ -243,18 +242,16 @@ void Command::_kickChannel()
 		if (!_client->isOperator(channel))
 			throw std::runtime_error(MessageBuilder::ircNotChanOperator(channelName));
 		
-		// On récupère le fd du client à kick et on vérifie s'il est dans le channel,
+		// On récupère le client à kick et on vérifie s'il est dans le channel,
 		// si non erreur et on passe au client suivant
 		std::string kickedNickname = *itClient;
-		int clientFd = channel->getChannelClientByNickname(kickedNickname, NULL);
-		if (IrcHelper::clientExists(clientFd) == false)
+		Client* kickedClient = channel->getChannelClientByNickname(kickedNickname, NULL);
+		if (!kickedClient)
 		{
 			_client->sendMessage(MessageBuilder::ircNotInChannel(_client->getNickname(), channelName, kickedNickname), NULL);
 			continue;
 		}
 
-		Client* kickedClient = _clients[clientFd];
-
 		// Si le client à kicker est operator, on ne le kick pas
 		if (kickedClient->isOperator(channel))
 			continue;
@@ -282,9 +279,9 @@ void Command::_kickChannel()
 void Command::_quitChannel()
 {
 	// On récupère les channels à quitter
-	std::vector<std::string> args = Utils::getTokens(*_itInput, splitter::SENTENCE);
+	std::vector<std::string>& args = ScratchArena::split(*_itInput, splitter::SENTENCE);
 	std::vector<std::string>::iterator itArg = args.begin();
-	std::vector<std::string> channelsToQuit = Utils::getTokens(*itArg, splitter::COMMA);
+	std::vector<std::string>& channelsToQuit = ScratchArena::split(*itArg, splitter::COMMA);
 	++itArg;
 
 	// On récupère la raison du PART s'il y en a une, sinon on la parametre par defaut
@@ -300,9 +297,10 @@ void Command::_quitChannel()
 	for (std::vector<std::string>::iterator itChanToQuit = channelsToQuit.begin(); itChanToQuit != channelsToQuit.end(); itChanToQuit++) //verifie s ils existent bien avant de quit chaque channel
 	{
 		std::string channelNameToQuit = IrcHelper::fixChannelMask(*itChanToQuit);
-		if (IrcHelper::channelExists(channelNameToQuit, _channels) == false)
+		Channel* channel = _channels.find(channelNameToQuit);
+		if (!channel)
 			_client->sendMessage(MessageBuilder::ircNoSuchChannel(_client->getNickname(), channelNameToQuit), NULL);
 		else
-			_client->leaveChannel(_channels.find(channelNameToQuit), _channels, reason, leaving_code::LEFT);
+			_client->leaveChannel(channel, _channels, reason, leaving_code::LEFT);
 	}
 }
\ No newline at end of file
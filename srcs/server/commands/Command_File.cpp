@@ -17,6 +17,7 @@
 #include "Utils.hpp"
 #include "IrcHelper.hpp"
 #include "MessageBuilder.hpp"
+#include "ScratchArena.hpp"
 
 // === NAMESPACES ===
 #include "irc_config.hpp"
@@ -38,7 +39,7 @@ using namespace server_messages;
 // =========================================================================================
 
 FileData::FileData() {}
-FileData::FileData(const std::string& path, const std::string& sender, const std::string& receiver)
+FileData::FileData(const std::string& path, const ClientHandle& sender, const ClientHandle& receiver)
 	: path(path), sender(sender), receiver(receiver) {}
 
 
@@ -53,27 +54,27 @@ FileData::FileData(const std::string& path, const std::string& sender, const std
  * 
  * This function processes input commands to either send or receive files.
  * It validates the command format, ensures the required arguments are present,
- * and changes the working directory to the user's home directory before
- * delegating the operation to the appropriate handler.
+ * and checks that the user's home directory is known (relative paths are taken
+ * from it) before delegating the operation to the appropriate handler.
  * 
  * @throws std::invalid_argument If the command is not SEND_CMD or GET_CMD,
  *                                or if the arguments are missing or insufficient.
- * @throws std::runtime_error If the HOME environment variable is not found or
- *                            the directory change fails.
+ * @throws std::runtime_error If the HOME environment variable is not found.
  */
 void Command::_handleFile()
 {
-	std::vector<std::string> entry = Utils::getTokens(*_itInput, splitter::SENTENCE);
+	std::vector<std::string>& entry = ScratchArena::split(*_itInput, splitter::SENTENCE);
 	Utils::toUpper(entry.front());
 
 	if (entry.front() != SEND_CMD && entry.front() != GET_CMD)
 		throw std::invalid_argument(MessageBuilder::msgFileUsage(entry.front()));
 	
-	std::vector<std::string> args = Utils::getTokens(entry.back(), splitter::WORD);
+	std::vector<std::string>& args = ScratchArena::split(entry.back(), splitter::WORD);
 	if (args.empty() || args.size() < 2)
 		throw std::invalid_argument(MessageBuilder::msgFileUsage(entry.front()));
 	
-	if (chdir(getenv("HOME")) != 0)
+	const char* home = getenv("HOME");
+	if (!home || !*home)
 		throw std::runtime_error(ERR_HOME_NOT_FOUND);
 	
 	entry.front() == SEND_CMD ? _sendFile(args) : _getFile(args);
@@ -88,9 +89,9 @@ void Command::_handleFile()
  * This function handles the process of sending a file from the client to another client.
  * It performs the following steps:
  * 1. Retrieves the receiver's information using the provided nickname.
- * 2. Opens the specified file to be sent.
- * 3. If the file opens successfully, it registers the file for transfer and sends a notification to both the sender and the receiver.
- * 4. If any error occurs during file opening, an error message is sent to the client and the process continues with the next argument.
+ * 2. Checks that the specified file can be read (without opening it).
+ * 3. If it can, it registers the file for transfer and sends a notification to both the sender and the receiver.
+ * 4. If it cannot, an error message is sent to the client and the process continues with the next argument.
  * 
  * @param args A vector of strings containing the arguments required for the file transfer.
  *             The first element is the receiver's nickname, and the second element is the file path.
@@ -99,25 +100,25 @@ void Command::_sendFile(std::vector<std::string>& args)
 {
 	size_t argsSize = args.size();
 	std::string receiver = args[0];
-	int clientFd = _server.getClientByNickname(receiver, _client);
-	if (IrcHelper::clientExists(clientFd) == false)
+	Client* receiverClient = _server.getClientByNickname(receiver, _client);
+	if (!receiverClient)
 		throw std::invalid_argument(MessageBuilder::ircNoSuchNick(_client->getNickname(), receiver));
+	receiver = receiverClient->getNickname();
 
 	while (argsSize >= 2)
 	{
 		std::string path = args[1];
-		std::fstream infile(path.c_str(), std::fstream::in);
-		if (!infile)
+		if (access(_getHomePath(path).c_str(), R_OK) != 0)
 		{
 			_handleFileError(args, argsSize, MessageBuilder::errorMsgOpenFile(path));
 			continue;
 		}
 
 		std::string filename = _getFilename(path);
-		_server.addFile(filename, path, _client->getNickname(), receiver);
+		_server.addFile(filename, _getHomePath(path), _client, receiverClient);
 
 		_client->sendMessage(MessageBuilder::msgRequestSent(filename, receiver), NULL);
-		_clients[clientFd]->sendMessage(MessageBuilder::msgSendFile(filename, _client->getNickname(), _client->getClientIp(), _client->getClientPort()), _client);
+		receiverClient->sendMessage(MessageBuilder::msgSendFile(filename, _client->getNickname(), _client->getClientIp(), _client->getClientPort()), _client);
 		
 		args.erase(args.begin() + 1);
 		argsSize = args.size();
@@ -133,10 +134,11 @@ void Command::_sendFile(std::vector<std::string>& args)
  * This function handles the process of retrieving a file sent by another client. The process includes:
  * 1. Verifying the sender's nickname and ensuring the file exists.
  * 2. Checking if the sender and receiver match the expected roles.
- * 3. Opening the file for reading and writing.
+ * 3. Opening the file for reading and the target file (in the receiver's home directory) for writing.
  * 4. If any errors occur during the file handling, such as file not found or failure to open the file, an error message is sent to the client.
- * 5. If the file is successfully retrieved, it is copied from the source file to the target file.
- * 6. After completion, notifications are sent to both the sender and receiver, and the file is removed from the server's file list.
+ * 5. If both files are open, the file is removed from the server's file list and the copy is handed to
+ *    the server's FileCopier, which copies it a few blocks per loop iteration.
+ * 6. After completion, notifications are sent to both the sender and receiver (Server::_applyFileCopies()).
  * 
  * @param args A vector of strings containing the arguments for the file retrieval command.
  *             The first element is the sender's nickname, and the second element is the filename.
@@ -145,14 +147,15 @@ void Command::_getFile(std::vector<std::string>& args)
 {
 	size_t argsSize = args.size();
 	std::string sender = args[0];
-	int clientFd = _server.getClientByNickname(sender, _client);
-	if (IrcHelper::clientExists(clientFd) == false)
+	Client* senderClient = _server.getClientByNickname(sender, _client);
+	if (!senderClient)
 		throw std::invalid_argument(MessageBuilder::ircNoSuchNick(_client->getNickname(), sender));
+	sender = senderClient->getNickname();
 
 	while (argsSize >= 2)
 	{
 		std::string filename = args[1];
-		std::map<std::string, FileData> files = _server.getFiles();
+		std::map<std::string, FileData>& files = _server.getFiles();
 		std::map<std::string, FileData>::iterator it = files.find(filename);
 		if (it == files.end())
 		{
@@ -160,39 +163,37 @@ void Command::_getFile(std::vector<std::string>& args)
 			continue;
 		}
 
+		// Les handles garantissent que l'envoi vient bien de ces deux clients (et pas d'anciens porteurs des mêmes pseudos)
 		FileData file = it->second;
-		if (file.sender != sender || file.receiver != _client->getNickname() || sender == _client->getNickname())
+		ClientTable& clients = _server.getClients();
+		if (clients.resolve(file.sender) != senderClient || clients.resolve(file.receiver) != _client || senderClient == _client)
 			throw std::invalid_argument(MessageBuilder::ircNoSuchNick(_client->getNickname(), sender));
 
-		std::fstream infile(file.path.c_str(), std::fstream::in);
-		if (!infile)
+		FileCopy copy;
+		copy.source = open(file.path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (copy.source == -1)
 		{
 			_handleFileError(args, argsSize, MessageBuilder::errorMsgOpenFile(file.path));
 			continue;
 		}
 
-		std::fstream outfile(filename.c_str(), std::fstream::out);
-		if (!outfile)
+		copy.target = open(_getHomePath(filename).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+		if (copy.target == -1)
 		{
 			_handleFileError(args, argsSize, MessageBuilder::errorMsgWriteFile(file.path));
-			infile.close();
+			close(copy.source);
 			continue;
 		}
 
-		// Copie ligne par ligne
-		std::string line;
-		while (std::getline(infile, line))
-			outfile << line << std::endl;
-
-		// Fermeture explicite des fichiers
-		infile.close();
-		outfile.close();
-		
-		_client->sendMessage(MessageBuilder::msgFileReceived(filename, file.sender), NULL);
-		_clients[clientFd]->sendMessage(MessageBuilder::msgFileSent(filename, file.receiver), _client);
-
-		// Suppression du fichier
-		_server.removeFile(it->first);
+		// Suppression du fichier de la liste, puis copie par blocs dans la boucle du serveur
+		// (les deux clients sont prévenus à la fin de la copie)
+		_server.removeFile(filename);
+		copy.filename = filename;
+		copy.sender = file.sender;
+		copy.receiver = file.receiver;
+		copy.senderNick = sender;
+		copy.receiverNick = _client->getNickname();
+		_server.startFileCopy(copy);
 
 		args.erase(args.begin() + 1);
 		argsSize = args.size();
@@ -215,6 +216,21 @@ std::string Command::_getFilename(const std::string& path) const
 	return path.substr(pos + 1);
 }
 
+/**
+ * @brief Resolves a path given by a client: a relative path starts from the HOME directory.
+ *
+ * (The server no longer changes its working directory for file commands.)
+ *
+ * @param path The path as typed by the client.
+ * @return The path to open.
+ */
+std::string Command::_getHomePath(const std::string& path) const
+{
+	if (!path.empty() && path[0] == '/')
+		return path;
+	return std::string(getenv("HOME")) + "/" + path;
+}
+
 /**
  * @brief Handles file-related errors during command execution.
  * 
@@ -16,6 +16,7 @@
 #include "Utils.hpp"
 #include "IrcHelper.hpp"
 #include "MessageBuilder.hpp"
+#include "ScratchArena.hpp"
 
 // === NAMESPACES ===
 #include "commands.hpp"
@@ -69,8 +70,8 @@ void Command::_updateActivity()
  * 3. Validates the number of arguments.
  * 4. If the request is for a channel:
  *    - Checks if the channel exists.
- *    - Retrieves the list of clients in the channel.
- *    - Sends information about each client in the channel to the requestor.
+ *    - Walks the channel member table in place (no copy of the member list).
+ *    - Sends information about each connected client to the requestor.
  *    - Sends the end of WHO list message.
  * 5. If the request is for a specific user:
  *    - Checks if the user exists.
@@ -82,7 +83,7 @@ void Command::_updateActivity()
 void Command::_handleWho()
 {
 	std::string requestorNickname = _client->getNickname();
-	std::vector<std::string> args = Utils::getTokens(*_itInput, splitter::WORD);
+	std::vector<std::string>& args = ScratchArena::split(*_itInput, splitter::WORD);
 	int nArg = args.size();
 
 	// Si plus de un argument apres split, le format est invalide
@@ -92,17 +93,20 @@ void Command::_handleWho()
 	// Si le client demande des infos sur un channel, on vérifie son existence
 	// et on affiche les infos de chaque client dans ce channel
 	std::string channelName = IrcHelper::fixChannelMask(*_itInput);
-	if (IrcHelper::channelExists(channelName, _channels))
+	Channel* channel = _channels.find(channelName);
+	if (channel)
 	{
-		Channel* channel = _channels[channelName];
-		std::set<const Client*> clientsList = channel->getClientsList();
+		channelName = channel->getName();
+		const std::vector<ChannelMember>& members = channel->getMembers();
 
-		for (std::set<const Client*>::iterator it = clientsList.begin(); it != clientsList.end(); ++it)
+		for (std::vector<ChannelMember>::const_iterator it = members.begin(); it != members.end(); ++it)
 		{
-			const Client* connected = *it;
-			std::string prefix = channel->isOperator(connected) ? "@" : "";
+			if (!(it->flags & member_flag::JOINED))
+				continue;
+			const Client* connected = it->client;
+			std::string prefix = (it->flags & member_flag::OPERATOR) ? "@" : "";
 			std::string connectedNickname = (prefix + connected->getNickname());
-			_client->sendMessage(MessageBuilder::ircWho(requestorNickname, connectedNickname, connected->getUsername(), connected->getRealName(), connected->getClientIp(), channelName, connected->isAway()), NULL);
+			_client->sendMessage(MessageBuilder::ircWho(requestorNickname, connectedNickname, connected->getUsername(), connected->getRealName(), connected->getVisibleHost(), channelName, connected->isAway()), NULL);
 			if (_client->isAway())
 				_client->sendMessage(MessageBuilder::ircClientIsAway(requestorNickname, connected->getNickname(), connected->getAwayMessage()), NULL);
 		}
@@ -113,12 +117,11 @@ void Command::_handleWho()
 	// Si le client demande des infos sur un utilisateur
 	// On vérifie d'abord que l'utilisateur existe
 	std::string checkedClientNickname = *_itInput;
-	int checkedClientFd = _server.getClientByNickname(checkedClientNickname, NULL);
-	if (IrcHelper::clientExists(checkedClientFd) == false)
+	const Client* checkedClient = _server.getClientByNickname(checkedClientNickname, NULL);
+	if (!checkedClient)
 		throw std::invalid_argument(MessageBuilder::ircNoSuchNick(requestorNickname, checkedClientNickname));
 	
-	const Client* checkedClient = _clients[checkedClientFd];
-	_client->sendMessage(MessageBuilder::ircWho(requestorNickname, checkedClient->getNickname(), checkedClient->getUsername(), checkedClient->getRealName(), checkedClient->getClientIp(), "*", checkedClient->isAway()), NULL);
+	_client->sendMessage(MessageBuilder::ircWho(requestorNickname, checkedClient->getNickname(), checkedClient->getUsername(), checkedClient->getRealName(), checkedClient->getVisibleHost(), "*", checkedClient->isAway()), NULL);
 	if (_client->isAway())
 		_client->sendMessage(MessageBuilder::ircClientIsAway(requestorNickname, checkedClient->getNickname(), checkedClient->getAwayMessage()), NULL);
 	_client->sendMessage(MessageBuilder::ircEndOfWho(requestorNickname, "*"), NULL);
@@ -139,7 +142,7 @@ void Command::_handleWhois()
 	if (Utils::isEmptyOrInvalid(_itInput, _vectorInput))
 		return;
 
-	std::vector<std::string> args = Utils::getTokens(*_itInput, splitter::WORD);
+	std::vector<std::string>& args = ScratchArena::split(*_itInput, splitter::WORD);
 	int nArg = args.size();
 
 	// Si plus de un argument apres split, le format est invalide
@@ -147,12 +150,11 @@ void Command::_handleWhois()
 		throw std::invalid_argument(MessageBuilder::ircNeedMoreParams(requestorNickname, WHOIS));
 	
 	std::string checkedClientNickname = *_itInput;
-	int checkedClientFd = _server.getClientByNickname(checkedClientNickname, NULL);
-	if (IrcHelper::clientExists(checkedClientFd) == false)
+	const Client* checkedClient = _server.getClientByNickname(checkedClientNickname, NULL);
+	if (!checkedClient)
 		throw std::invalid_argument(MessageBuilder::ircNoSuchNick(requestorNickname, checkedClientNickname));
 	
-	const Client* checkedClient = _clients[checkedClientFd];
-	_client->sendMessage(MessageBuilder::ircWhois(requestorNickname, checkedClient->getNickname(), checkedClient->getUsername(), checkedClient->getRealName(), checkedClient->getClientIp()), NULL);
+	_client->sendMessage(MessageBuilder::ircWhois(requestorNickname, checkedClient->getNickname(), checkedClient->getUsername(), checkedClient->getRealName(), checkedClient->getVisibleHost()), NULL);
 	_client->sendMessage(MessageBuilder::ircWhoisIdle(requestorNickname, checkedClient->getNickname(), checkedClient->getIdleTime(), checkedClient->getSignonTime()), NULL);
 	_client->sendMessage(MessageBuilder::ircEndOfWhois(requestorNickname, checkedClient->getNickname()), NULL);
 }
@@ -226,6 +228,62 @@ void Command::_setAway()
 	_client->sendMessage(MessageBuilder::ircAway(nickname), NULL);
 }
 
+/**
+ * @brief Handles the LUSERS command by sending the user statistics of the server.
+ *
+ * Parameters (mask, target server) are ignored: this server is not part of a network.
+ */
+void Command::_sendUserStats()
+{
+	_server.sendUserStats(_client);
+}
+
+/**
+ * @brief Handles the OPER command: OPER <name> <password>.
+ *
+ * The credentials are set by the environment when the server starts (see Server::_initStats()).
+ * Without an operator password, or with another name, nobody can become operator.
+ *
+ * @throws std::invalid_argument if the parameters are missing, or if the credentials are wrong.
+ */
+void Command::_becomeOperator()
+{
+	const std::string& nickname = _client->getNickname();
+	std::vector<std::string>& args = ScratchArena::split(*_itInput, splitter::WORD);
+	if (args.size() != 2)
+		throw std::invalid_argument(MessageBuilder::ircNeedMoreParams(nickname, OPER));
+
+	const std::string& password = _server.getOperatorPassword();
+	if (password.empty() || args[0] != _server.getOperatorName())
+		throw std::invalid_argument(MessageBuilder::ircNoOperHost(nickname));
+	if (args[1] != password)
+		throw std::invalid_argument(MessageBuilder::ircPasswordIncorrect());
+
+	if (_client->isServerOperator())
+		return;
+	_client->setServerOperator(true);
+	_client->sendMessage(MessageBuilder::ircYoureOper(nickname), NULL);
+	std::cout << MessageBuilder::msgClientIsServerOperator(nickname) << std::endl;
+}
+
+/**
+ * @brief Handles the STATS command: STATS [t|m|u|z] (server operators only).
+ *
+ * Without a letter, the traffic report (t) is sent. See Server::sendServerStats().
+ *
+ * @throws std::invalid_argument if the client is not a server operator.
+ */
+void Command::_sendServerStats()
+{
+	if (!_client->isServerOperator())
+		throw std::invalid_argument(MessageBuilder::ircNoPrivileges(_client->getNickname()));
+
+	char query = 't';
+	if (!Utils::isEmptyOrInvalid(_itInput, _vectorInput))
+		query = (*_itInput)[0];
+	_server.sendServerStats(_client, query);
+}
+
 /**
  * @brief Handles the QUIT command for a client, preparing them to leave the server.
  *
@@ -241,7 +299,7 @@ void Command::_quitServer(void)
 {
 	// Si aucune raison n'est fournie, on utilise la raison par défaut
 	if (Utils::isEmptyOrInvalid(_itInput, _vectorInput) || ((*_itInput)[0] == ':' && (*_itInput).size() == 1)) {
-		_server.prepareClientToLeave(_it, DEFAULT_REASON);
+		_server.prepareClientToLeave(_client, DEFAULT_REASON, stats::DISCONNECT_QUIT);
 		return;
 	}
 
@@ -252,5 +310,5 @@ void Command::_quitServer(void)
 		reason = DEFAULT_REASON;
 
 	// Le client quitte le serveur
-	_server.prepareClientToLeave(_it, reason);
+	_server.prepareClientToLeave(_client, reason, stats::DISCONNECT_QUIT);
 }
\ No newline at end of file
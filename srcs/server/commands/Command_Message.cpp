@@ -16,6 +16,7 @@
 #include "Utils.hpp"
 #include "IrcHelper.hpp"
 #include "MessageBuilder.hpp"
+#include "ScratchArena.hpp"
 
 // === NAMESPACES ===
 #include "irc_config.hpp"
@@ -43,18 +44,18 @@ void Command::_sendPrivateMessage()
 	if (Utils::isEmptyOrInvalid(_itInput, _vectorInput))
 		throw std::invalid_argument(MessageBuilder::ircNeedMoreParams(_client->getNickname(), PRIVMSG));
 
-	std::vector<std::string> args = Utils::getTokens(*_itInput, splitter::SENTENCE);
-	std::string targetStr = *args.begin();
-	std::vector<std::string> targets = Utils::getTokens(targetStr, splitter::COMMA);
+	std::vector<std::string>& args = ScratchArena::split(*_itInput, splitter::SENTENCE);
+	const std::string& targetStr = *args.begin();
+	std::vector<std::string>& targets = ScratchArena::split(targetStr, splitter::COMMA);
 	std::vector<std::string>::iterator itTarget = targets.begin();
 
 	if (itTarget == targets.end())
 		throw std::invalid_argument(MessageBuilder::ircNeedMoreParams(_client->getNickname(), PRIVMSG));
 
 	std::vector<std::string>::iterator itMessage = ++args.begin();
-	std::string	message = itMessage != args.end() ? *itMessage : "";
+	std::string& message = itMessage != args.end() ? *itMessage : ScratchArena::string();
 
-	if (IrcHelper::isRightChannel(*_client, *itTarget, _channels, HIDE_ERROR) != channel_error::INVALID_FORMAT)
+	if (IrcHelper::isValidChannelName(*itTarget))
 		_sendToChannel(targets, message);
 	else
 		_sendToClient(targets, message);
@@ -74,23 +75,23 @@ void Command::_sendPrivateMessage()
  */
 void Command::_sendToChannel(std::vector<std::string>& targets, std::string& message)
 {
-	std::string nickname = _client->getNickname();
+	const std::string& nickname = _client->getNickname();
 
 	for (std::vector<std::string>::iterator itTarget = targets.begin(); itTarget != targets.end(); itTarget++)
 	{
 		if (message.empty() || (message[0] == ':' && message.size() == 1) || Utils::isOnlySpace(message) == true)
 			throw std::invalid_argument(MessageBuilder::ircNoTextToSend(nickname));
 
-		std::string formattedMessage = IrcHelper::sanitizeIrcMessage(message, PRIVMSG, nickname);
-		std::string targetName = *itTarget;
+		const std::string& formattedMessage = IrcHelper::sanitizeIrcMessage(message, PRIVMSG, nickname);
+		const std::string& targetName = *itTarget;
 
-		if (IrcHelper::channelExists(targetName, _channels) == false)
+		Channel* channel = _channels.find(targetName);
+		if (!channel)
 		{
 			_client->sendMessage(MessageBuilder::ircNoSuchChannel(nickname, targetName), NULL);
 			continue;
 		}
-		Channel* channel = _channels[targetName];
-		channel->sendToAll(MessageBuilder::ircMsgToChannel(nickname, targetName, formattedMessage), _client, false);
+		channel->sendToAll(MessageBuilder::ircMsgToChannel(ScratchArena::string(), nickname, channel->getName(), formattedMessage), _client, false);
 	}
 }
 
@@ -109,11 +110,11 @@ void Command::_sendToChannel(std::vector<std::string>& targets, std::string& mes
  */
 void Command::_sendToClient(std::vector<std::string>& targets, std::string& message)
 {
-	std::string nickname = _client->getNickname();
+	const std::string& nickname = _client->getNickname();
 
 	for (std::vector<std::string>::iterator itTarget = targets.begin(); itTarget != targets.end(); itTarget++)
 	{
-		std::string targetName = *itTarget;
+		const std::string& targetName = *itTarget;
 		if (message.empty() || (message[0] == ':' && message.size() == 1) || Utils::isOnlySpace(message) == true)
 		{
 			if ((targetName)[0] == ':')
@@ -122,19 +123,18 @@ void Command::_sendToClient(std::vector<std::string>& targets, std::string& mess
 				throw std::invalid_argument(MessageBuilder::ircNoTextToSend(nickname));
 		}
 
-		std::string formattedMessage = IrcHelper::sanitizeIrcMessage(message, PRIVMSG, nickname);
-		int clientFd = _server.getClientByNickname(targetName, NULL);
-		if (IrcHelper::clientExists(clientFd) == false)
+		const std::string& formattedMessage = IrcHelper::sanitizeIrcMessage(message, PRIVMSG, nickname);
+		Client* targetClient = _server.getClientByNickname(targetName, NULL);
+		if (!targetClient)
 		{
 			_client->sendMessage(MessageBuilder::ircNoSuchNick(nickname, targetName), NULL);
 			continue;
 		}
 		
-		Client* targetClient = _clients[clientFd];
 		if (targetClient == _client)
 			continue;
 
-		targetClient->sendMessage(MessageBuilder::ircMsgToClient(nickname, targetName, formattedMessage), _client);			
+		targetClient->sendMessage(MessageBuilder::ircMsgToClient(ScratchArena::string(), nickname, targetName, formattedMessage), _client);			
 		
 		// Si le client visé est absent, l'envoyeur reçoit sa notification d'absence
 		if (targetClient->isAway())
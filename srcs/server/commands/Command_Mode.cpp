@@ -16,6 +16,7 @@
 #include "Utils.hpp"
 #include "IrcHelper.hpp"
 #include "MessageBuilder.hpp"
+#include "ScratchArena.hpp"
 
 // === NAMESPACES ===
 #include "irc_config.hpp"
@@ -52,15 +53,16 @@ using namespace error_display;
 void Command::_handleMode()
 {
 	std::string mode;
-	std::vector<std::string> args = Utils::getTokens(*_itInput, splitter::WORD);
+	std::vector<std::string>& args = ScratchArena::split(*_itInput, splitter::WORD);
 	std::string target = *args.begin();
 	if (args.size() > 1)
 		_mode = *++args.begin();
-	if (_validateModeCommand(target, args.size()) == false)
+	Channel* channel = _channels.find(target);
+	if (_validateModeCommand(channel, target, args.size()) == false)
 		return;	
 	
 	_modeArgs = IrcHelper::mapModesToArgs(args);
-	_applyChangeMode(target);
+	_applyChangeMode(channel);
 }
 
 /**
@@ -71,6 +73,7 @@ void Command::_handleMode()
  * and channel. It ensures that the client has the necessary permissions and
  * that the command is properly formatted.
  * 
+ * @param channel The channel found in the registry for this target, or NULL.
  * @param channelName The name of the channel for which the MODE command is issued.
  * @param nArgs The number of arguments provided with the MODE command.
  * @return true If the MODE command is valid and can proceed.
@@ -88,26 +91,24 @@ void Command::_handleMode()
  * - If the client is not in the channel or is not an operator, an exception is thrown.
  * - The function validates the mode arguments if all checks pass.
  */
-bool Command::_validateModeCommand(const std::string& channelName, unsigned int nArgs)
+bool Command::_validateModeCommand(Channel *channel, const std::string& channelName, unsigned int nArgs)
 {
 	if ((channelName == _client->getNickname() && _mode == "+i")
-		|| (IrcHelper::isRightChannel(*_client, channelName, _channels, PRINT_ERROR) != channel_error::ALL_RIGHT))
+		|| (IrcHelper::isRightChannel(*_client, channelName, channel, PRINT_ERROR) != channel_error::ALL_RIGHT))
 		return false;
 
-	Channel* channel = _channels[channelName];
 	if (nArgs == 1 || _mode == "b")
 	{
-		std::string modeMsg = MessageBuilder::ircChannelModeIs(_client->getNickname(), channelName, channel->getModes());
-		std::string banMsg = MessageBuilder::ircEndOfBannedList(_client->getNickname(), channelName);
+		std::string modeMsg = MessageBuilder::ircChannelModeIs(_client->getNickname(), channel->getName(), channel->getModes());
+		std::string banMsg = MessageBuilder::ircEndOfBannedList(_client->getNickname(), channel->getName());
 		nArgs == 1 ? _client->sendMessage(modeMsg, NULL) : _client->sendMessage(banMsg, NULL);
 		return false;
 	}
 
-	int channelClientFd = channel->getChannelClientByNickname(_client->getNickname(), NULL);
-	if (IrcHelper::clientExists(channelClientFd) == false)
-		throw std::invalid_argument(MessageBuilder::ircCurrentNotInChannel(_client->getNickname(), channelName));
+	if (!channel->isConnected(_client))
+		throw std::invalid_argument(MessageBuilder::ircCurrentNotInChannel(_client->getNickname(), channel->getName()));
 	if (_client->isOperator(channel) == false)
-		throw std::invalid_argument(MessageBuilder::ircNotChanOperator(channelName));
+		throw std::invalid_argument(MessageBuilder::ircNotChanOperator(channel->getName()));
 
 	_validateModeArguments(channel, nArgs);
 	return true ;
@@ -146,7 +147,7 @@ void Command::_validateModeArguments(const Channel *channel, unsigned int nArgs)
  * mode changes to the specified channel. It uses a map of mode characters to handler
  * functions to determine the appropriate action for each mode character.
  *
- * @param channelName The name of the channel to which the mode changes will be applied.
+ * @param channel The channel to which the mode changes will be applied.
  *
  * The function performs the following:
  * - Identifies the mode character and determines whether it is valid.
@@ -167,18 +168,20 @@ void Command::_validateModeArguments(const Channel *channel, unsigned int nArgs)
  * - If an unknown mode character is encountered, an error message is sent to the client
  *   using the MessageBuilder::ircUnknownMode function.
  */
-void Command::_applyChangeMode(const std::string& channelName)
+void Command::_applyChangeMode(Channel *channel)
 {
-	Channel* channel = _channels[channelName];
-
 	typedef void (Command::*ModeHandler)(Channel*);
-	std::map<char, ModeHandler> modeHandlers;
-	
-	modeHandlers['i'] = &Command::_setInviteOnly;
-	modeHandlers['t'] = &Command::_setTopicRestriction;
-	modeHandlers['k'] = &Command::_setPasswordMode;
-	modeHandlers['o'] = &Command::_setOperatorPrivilegeWrapper;
-	modeHandlers['l'] = &Command::_setChannelLimitWrapper;
+	static std::map<char, ModeHandler> modeHandlers;
+
+	// Table construite une seule fois (pas de map allouée à chaque MODE)
+	if (modeHandlers.empty())
+	{
+		modeHandlers['i'] = &Command::_setInviteOnly;
+		modeHandlers['t'] = &Command::_setTopicRestriction;
+		modeHandlers['k'] = &Command::_setPasswordMode;
+		modeHandlers['o'] = &Command::_setOperatorPrivilegeWrapper;
+		modeHandlers['l'] = &Command::_setChannelLimitWrapper;
+	}
 
 	for (std::string::size_type i = 0; i < _mode.size(); ++i)
 	{
@@ -217,17 +220,14 @@ void Command::_applyChangeMode(const std::string& channelName)
  */
 void Command::_setOperatorPrivilegeWrapper(Channel *channel)
 {
-	int serverClientFd = _server.getClientByNickname(_modeArgs.at('o'), NULL);
-	int channelClientFd = channel->getChannelClientByNickname(_modeArgs.at('o'), NULL);
-
-	if (!IrcHelper::clientExists(serverClientFd) || !IrcHelper::clientExists(channelClientFd))
+	Client *newOp = _server.getClientByNickname(_modeArgs.at('o'), NULL);
+	if (!newOp || !channel->isConnected(newOp))
 	{
 		std::string msgNoNick = MessageBuilder::ircNoSuchNick(_client->getNickname(), _modeArgs.at('o'));
 		std::string msgNotInChan = MessageBuilder::ircNotInChannel(_client->getNickname(), channel->getName(), _modeArgs.at('o'));
-		!IrcHelper::clientExists(serverClientFd) ? _client->sendMessage(msgNoNick, NULL) : _client->sendMessage(msgNotInChan, NULL);
+		!newOp ? _client->sendMessage(msgNoNick, NULL) : _client->sendMessage(msgNotInChan, NULL);
 		return;
 	}
-	Client *newOp = _clients[serverClientFd];
 	_setOperatorPrivilege(channel, newOp);
 }
 
@@ -267,7 +267,7 @@ void Command::_setInviteOnly(Channel *channel)
 
 	_modeSign == '+' && !channel->isInviteOnly() ? channel->setInviteOnly(true) : channel->setInviteOnly(false);
 	std::string sign(1, _modeSign);
-	_client->sendToAll(channel, MessageBuilder::ircOpeChangedMode(_client->getUsermask(), channel->getName(), sign + "i", ""), true);
+	_client->sendToAll(channel, MessageBuilder::ircOpeChangedMode(ScratchArena::string(), _client->getUsermask(), channel->getName(), sign + "i", ""), true);
 }
 
 /**
@@ -293,7 +293,7 @@ void Command::_setTopicRestriction(Channel *channel)
 	
 	_modeSign == '+' && !channel->isSettableTopic() ? channel->setSettableTopic(true) : channel->setSettableTopic(false);
 	std::string sign(1, _modeSign);
-	_client->sendToAll(channel, MessageBuilder::ircOpeChangedMode(_client->getUsermask(), channel->getName(), sign + "t", ""), true);
+	_client->sendToAll(channel, MessageBuilder::ircOpeChangedMode(ScratchArena::string(), _client->getUsermask(), channel->getName(), sign + "t", ""), true);
 }
 
 /**
@@ -319,7 +319,7 @@ void Command::_setPasswordMode(Channel *channel)
 
 	_modeSign == '+' ? channel->setPassword(password) : channel->setPassword("");
 	std::string sign(1, _modeSign);
-	_client->sendToAll(channel, MessageBuilder::ircOpeChangedMode(_client->getUsermask(), channel->getName(), sign + "k", ""), true);
+	_client->sendToAll(channel, MessageBuilder::ircOpeChangedMode(ScratchArena::string(), _client->getUsermask(), channel->getName(), sign + "k", ""), true);
 }
 
 /**
@@ -343,7 +343,7 @@ void Command::_setOperatorPrivilege(Channel *channel, Client *newOp)
 
 	_modeSign == '+' && !channel->isOperator(newOp) ? channel->addOperator(newOp) : channel->removeOperator(newOp);
 	std::string sign(1, _modeSign);		
-	_client->sendToAll(channel, MessageBuilder::ircOpeChangedMode(_client->getUsermask(), channel->getName(), sign + "o", newOp->getNickname()), true);
+	_client->sendToAll(channel, MessageBuilder::ircOpeChangedMode(ScratchArena::string(), _client->getUsermask(), channel->getName(), sign + "o", newOp->getNickname()), true);
 }
 
 /**
@@ -388,6 +388,6 @@ bool Command::_setChannelLimit(Channel *channel)
 		channel->setClientsLimit(-1);
 		
 	std::string sign(1, _modeSign);
-	_client->sendToAll(channel, MessageBuilder::ircOpeChangedMode(_client->getUsermask(), channel->getName(), sign + "l", newLimitStr), true);
+	_client->sendToAll(channel, MessageBuilder::ircOpeChangedMode(ScratchArena::string(), _client->getUsermask(), channel->getName(), sign + "l", newLimitStr), true);
 	return true;
 }
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "Utils.hpp"
 #include "IrcHelper.hpp"
 #include "MessageBuilder.hpp"
+#include "ScratchArena.hpp"
 
 // === NAMESPACES ===
 #include "commands.hpp"
@@ -58,7 +59,7 @@ void Command::_authenticate()
 	std::string cmd = *_itInput;
 	std::string command_to_send = IrcHelper::commandToSend(*_client);
 	int toDo = IrcHelper::getCommand(*_client);
-	std::map<std::string, void (Command::*)()>::iterator itFunction = _fctMap.find(*_itInput);
+	std::map<std::string, Handler>::iterator itFunction = _fctMap.find(*_itInput);
 
 	if (itFunction == _fctMap.end() || IrcHelper::isCommandIgnored(cmd, true)
 		|| (cmd == NICK && toDo != NICK_CMD) || (cmd == USER && toDo != USER_CMD))
@@ -75,7 +76,7 @@ void Command::_authenticate()
 	}
 	
 	_itInput++;
-	(this->*itFunction->second)();
+	_dispatch(itFunction->second);
 
 	toDo = IrcHelper::getCommand(*_client);
 	if (toDo < CMD_ALL_SET && IrcHelper::isCommandIgnored(cmd, false) && !_client->isIdentified())
@@ -84,14 +85,9 @@ void Command::_authenticate()
 		_client->sendMessage(MessageBuilder::ircCommandPrompt(command_to_send, ""), NULL);
 	}
 
-	if (toDo == CMD_ALL_SET && _client->isAuthenticated() == false)
-	{
-		_client->setUsermask();
-		_client->authenticate();
-		_server.greetClient(_client);
-		_client->sendMessage(MessageBuilder::ircNoticeMsg(_client->getNickname(), PROMPT_ONCE_REGISTERED, IRC_COLOR_INFO), NULL);
-		std::cout << MessageBuilder::msgClientConnected(_client->getClientIp(), _client->getClientPort(), _clientFd, _client->getNickname()) << std::endl;
-	}
+	// Si le nom d'hôte est encore recherché, le serveur terminera l'enregistrement à la réponse DNS
+	if (toDo == CMD_ALL_SET && _client->isAuthenticated() == false && _client->isHostLookupPending() == false)
+		_server.completeRegistration(_client);
 }
 
 /**
@@ -194,15 +190,15 @@ void Command::_setNicknameClient(void)
 		throw std::invalid_argument(MessageBuilder::ircErroneusNickname(nickname, enteredNickname));
 	
 	// On check si le nickname est déjà pris
-	if (_server.getClientByNickname(enteredNickname, _client) != -1)
+	if (_server.getClientByNickname(enteredNickname, _client) != NULL)
 	{
 		if (_client->isIdentified())
 			_client->sendMessage(MessageBuilder::ircChangingNickname(enteredNickname), NULL);
 		throw std::invalid_argument(MessageBuilder::ircNicknameTaken(nickname, enteredNickname));
 	}
 
-	// Si tout est ok, on set le nickname et on le stocke
-	_client->setNickname(enteredNickname);
+	// Si tout est ok, on set le nickname et on le stocke dans l'index du serveur
+	_server.setClientNickname(_client, enteredNickname);
 	std::string newNickname = _client->getNickname();
 
 	// Affichage d'un message de confirmation au client si c'est le premier set du nickname
@@ -219,9 +215,9 @@ void Command::_setNicknameClient(void)
 	}
 
 	// Sinon, c'est un changement de nickname:
-	// on broadcast à tous les clients pour valider le changement
+	// on prévient le client et ceux qui partagent un canal avec lui (une seule fois chacun)
 	if ((!oldNickname.empty() && oldNickname != newNickname))
-		_server.broadcastToClients(MessageBuilder::ircNicknameSet(oldNickname, newNickname));
+		_server.sendToNeighbors(_client, MessageBuilder::ircNicknameSet(oldNickname, newNickname), true);
 }
 
 /**
@@ -253,7 +249,7 @@ void Command::_setUsernameClient(void)
 		throw std::invalid_argument(MessageBuilder::ircAlreadyRegistered(_client->getUsername()));
 	
 	// Récupération des arguments
-	std::vector<std::string> args = Utils::getTokens(*_itInput, splitter::WORD);
+	std::vector<std::string>& args = ScratchArena::split(*_itInput, splitter::WORD);
 	if (args.size() < 4)
 		throw std::invalid_argument(MessageBuilder::ircNeedMoreParams(_client->getNickname(), USER));
 	
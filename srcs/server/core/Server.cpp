@@ -81,7 +81,8 @@ void Server::signalHandler(int signal)
  * @throws std::invalid_argument If the port number is not within the valid range or if the password is invalid or empty.
 */
 Server::Server(const std::string &port, const std::string &password)
-	: _serverSocketFd(-1), _maxFd(0)
+	: _serverSocketFd(-1), _maxFd(0), _fanoutEpoch(0),
+	_authenticatedCount(0), _maxClientCount(0), _maxAuthenticatedCount(0)
 {
 	_port = IrcHelper::validatePort(port);
 
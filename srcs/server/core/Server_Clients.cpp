@@ -14,14 +14,19 @@
 
 // === OTHER CLASSES ===
 #include "Client.hpp"
+#include "Channel.hpp"
 #include "IrcHelper.hpp"
 #include "MessageBuilder.hpp"
+#include "EpochReclaimer.hpp"
+#include "ServerStats.hpp"
 
 // === NAMESPACES ===
 #include "irc_config.hpp"
 #include "server_messages.hpp"
+#include "colors.hpp"
 
 using namespace server_messages;
+using namespace colors;
 
 // =========================================================================================
 
@@ -32,13 +37,13 @@ using namespace server_messages;
 // === GETTERS ===
 
 /**
- * @brief Returns the list of clients.
+ * @brief Returns the client table.
  *
- * This function returns the list of clients as a reference.
+ * This function returns the fd-indexed table of connected clients as a reference.
  *
- * @return std::map<int, Client*>& The list of clients.
+ * @return ClientTable& The client table.
  */
-std::map<int, Client*>& Server::getClients()
+ClientTable& Server::getClients()
 {
 	return _clients;
 }
@@ -56,47 +61,137 @@ int Server::getTotalClientCount() const
 /**
  * @brief Get the count of clients based on their authentication status.
  * 
+ * The number of authenticated clients is a counter updated on authentication
+ * and deletion, so no client has to be scanned.
+ * 
  * @param authenticated If true, count only authenticated clients; 
  *                      if false, count only unauthenticated clients.
  * @return int The number of clients that match the specified authentication status.
  */
-int Server::getClientCount(bool authenticated)
+int Server::getClientCount(bool authenticated) const
+{
+	return authenticated ? _authenticatedCount : getTotalClientCount() - _authenticatedCount;
+}
+
+/**
+ * @brief Get the highest number of clients seen since the server started.
+ * 
+ * @param authenticated If true, the peak of authenticated clients;
+ *                      if false, the peak of all connected clients.
+ * @return int The peak number of clients.
+ */
+int Server::getMaxClientCount(bool authenticated) const
+{
+	return authenticated ? _maxAuthenticatedCount : _maxClientCount;
+}
+
+/**
+ * @brief Measures the memory held by the connected clients.
+ *
+ * @return The number of clients and their estimated memory, split between
+ *         active clients and clients in hibernation.
+ */
+ClientMemory Server::getClientMemory() const
 {
-	int count = 0;
-	for (std::map<int, Client*>::iterator it = _clients.begin(); it != _clients.end(); ++it)
+	ClientMemory memory;
+	const std::vector<Client*>& clients = _clients.getLiveClients();
+	for (std::vector<Client*>::const_iterator it = clients.begin(); it != clients.end(); ++it)
 	{
-		if (authenticated && (it->second)->isAuthenticated())
-			count++;
-		else if (!authenticated && !(it->second)->isAuthenticated())
-			count++;
+		if ((*it)->isHibernating())
+		{
+			memory.hibernatingCount++;
+			memory.hibernatingBytes += (*it)->getMemoryFootprint();
+		}
+		else
+		{
+			memory.activeCount++;
+			memory.activeBytes += (*it)->getMemoryFootprint();
+		}
 	}
-	return count;
+	return memory;
 }
 
 /**
- * @brief Retrieves the client ID associated with a given nickname.
+ * @brief Retrieves the client registered under a given nickname.
  *
- * This function iterates through the list of clients and returns the ID of the client
- * whose nickname matches the provided nickname. If the optional currClient parameter
- * is provided, it will be skipped during the search.
+ * The casefolded nickname (RFC 1459) is resolved to its interned symbol, then
+ * the nickname index is probed with that integer, so the lookup does not depend
+ * on the number of connected clients and "Alice" matches "alice". If the optional currClient parameter is provided
+ * and owns the nickname, it is skipped (used for nickname collision checks).
  *
  * @param nickname The nickname of the client to search for.
  * @param currClient Optional parameter to specify a client to be skipped during the search.
- * @return The ID of the client with the matching nickname, or -1 if no match is found.
+ * @return A pointer to the client with the matching nickname, or NULL if no match is found.
  */
-int Server::getClientByNickname(const std::string &nickname, Client* currClient)
+Client* Server::getClientByNickname(const std::string &nickname, Client* currClient)
 {
-	for (std::map<int, Client*>::iterator it = _clients.begin(); it != _clients.end(); it++)
+	Symbol key = StringPool::find(IrcHelper::toIrcLower(nickname));
+	if (!key)
+		return NULL;
+
+	Client** found = _nicknames.find(key);
+	if (!found || *found == currClient)
+		return NULL;
+	return *found;
+}
+
+// === ACTIONS ===
+
+/**
+ * @brief Changes the nickname of a client and keeps the nickname index up to date.
+ *
+ * The previous casefolded nickname is removed from the index (only if it still
+ * points to this client), then the client is registered under its new nickname.
+ *
+ * @param client The client whose nickname changes.
+ * @param nickname The new nickname.
+ */
+void Server::setClientNickname(Client* client, const std::string& nickname)
+{
+	Symbol oldKey = client->getNicknameKey();
+	if (oldKey)
 	{
-		if (currClient && currClient == it->second)
-			continue;
-		if (nickname == (it->second)->getNickname()) 
-			return it->first;
+		Client** owner = _nicknames.find(oldKey);
+		if (owner && *owner == client)
+			_nicknames.erase(oldKey);
 	}
-	return -1;
+	client->setNickname(nickname);
+	_nicknames.insert(client->getNicknameKey(), client);
 }
 
-// === ACTIONS ===
+/**
+ * @brief Marks a client as authenticated and updates the user counters.
+ *
+ * @param client A pointer to the client who completed registration.
+ */
+void Server::authenticateClient(Client* client)
+{
+	if (client->isAuthenticated())
+		return;
+	client->authenticate();
+
+	_authenticatedCount++;
+	if (_authenticatedCount > _maxAuthenticatedCount)
+		_maxAuthenticatedCount = _authenticatedCount;
+}
+
+/**
+ * @brief Completes the registration of a client once PASS, NICK and USER are set.
+ *
+ * Called by the USER/NICK handlers, or by the server loop when the registration
+ * was waiting for the reverse DNS lookup of the client: the usermask is built
+ * with the host found (or the IP), then the client is greeted.
+ *
+ * @param client A pointer to the client to register.
+ */
+void Server::completeRegistration(Client* client)
+{
+	client->setUsermask();
+	authenticateClient(client);
+	greetClient(client);
+	client->sendMessage(MessageBuilder::ircNoticeMsg(client->getNickname(), PROMPT_ONCE_REGISTERED, IRC_COLOR_INFO), NULL);
+	std::cout << MessageBuilder::msgClientConnected(client->getClientIp(), client->getClientPort(), client->getFd(), client->getNickname()) << std::endl;
+}
 
 /**
  * @brief Sends a greeting message to a newly connected client.
@@ -121,29 +216,64 @@ void Server::greetClient(Client* client)
 	client->sendMessage(MessageBuilder::ircInfos(nickname), NULL);
 	client->sendMessage(MessageBuilder::ircMOTDMessage(nickname), NULL);
 
+	sendUserStats(client);
+}
+
+/**
+ * @brief Sends the user statistics of the server to a client (greeting and LUSERS).
+ *
+ * All the values come from counters kept up to date on connection, authentication,
+ * deletion and channel creation/destruction, so this costs O(1) whatever the number of users.
+ *
+ * @param client A pointer to the client requesting the statistics.
+ */
+void Server::sendUserStats(Client* client)
+{
+	const std::string& nickname = client->getNickname();
+
 	int totalClientCount = getTotalClientCount();
 	int unknownClientCount = getClientCount(false);
 	int knownClientCount = getClientCount(true);
 	int channelCount = getChannelCount();
 
 	client->sendMessage(MessageBuilder::ircGlobalUserList(nickname, totalClientCount, knownClientCount, unknownClientCount, channelCount), NULL);
+	client->sendMessage(MessageBuilder::ircUserCountPeak(nickname, totalClientCount, getMaxClientCount(false), knownClientCount, getMaxClientCount(true)), NULL);
 }
 
 /**
- * @brief Broadcasts a message for nickname change to all connected and authenticated clients except those marked for deletion.
- * 
- * This function iterates through the list of connected clients and sends the specified
- * message to each client that is not present in the list of clients to be deleted.
- * 
- * @param message The message to be broadcasted to all connected and authenticated clients.
+ * @brief Sends a message once to every client sharing at least one channel with a client.
+ *
+ * Used for notifications about the client itself (NICK, QUIT...): the members of all
+ * its channels are visited, and each recipient is stamped with the number of the current
+ * fan-out, so that a client sharing several channels receives the message only once.
+ * The cost is the sum of the channel sizes, without any temporary set of recipients.
+ * Clients marked for deletion are skipped.
+ *
+ * @param client The client the notification is about.
+ * @param message The message to send.
+ * @param includeSelf Whether the client itself also receives the message.
  */
-void Server::broadcastToClients(const std::string &message)
+void Server::sendToNeighbors(Client* client, const std::string& message, bool includeSelf)
 {
-	for (std::map<int, Client*>::iterator it = _clients.begin(); it != _clients.end(); ++it)
+	++_fanoutEpoch;
+
+	// Le client lui-même est tamponné d'office: il n'est servi qu'une fois, et seulement si demandé
+	client->stampFanout(_fanoutEpoch);
+	if (includeSelf)
+		client->sendMessage(message, NULL);
+
+	std::map<Symbol, Channel*>& channels = client->getChannelsJoined();
+	for (std::map<Symbol, Channel*>::iterator it = channels.begin(); it != channels.end(); ++it)
 	{
-		std::vector<std::map<int, Client*>::iterator>::iterator itDeleted = std::find(_clientsToDelete.begin(), _clientsToDelete.end(), it);
-		if (itDeleted == _clientsToDelete.end() && it->second->isAuthenticated())
-			it->second->sendMessage(message, NULL);
+		const std::vector<ChannelMember>& members = it->second->getMembers();
+		for (std::vector<ChannelMember>::const_iterator itMember = members.begin(); itMember != members.end(); ++itMember)
+		{
+			Client* neighbor = itMember->client;
+			if (!(itMember->flags & member_flag::JOINED) || neighbor->isMarkedForDeletion())
+				continue;
+			if (neighbor->stampFanout(_fanoutEpoch))
+				neighbor->sendMessage(message, NULL);
+		}
 	}
 }
 
@@ -151,19 +281,30 @@ void Server::broadcastToClients(const std::string &message)
  * @brief Prepares a client to leave the server.
  *
  * This function handles the necessary steps to properly disconnect a client from the server.
- * It ensures that the client leaves all channels they are part of, disconnects the client,
- * and marks the client for deletion.
+ * A single QUIT is sent to the users sharing a channel with the client (not one per channel),
+ * then the client leaves all channels they are part of, is disconnected and marked for deletion.
+ * A client already marked is ignored, so it is queued for deletion only once
+ * even if several events (QUIT, timeout, read error) try to remove it in the same loop iteration.
  *
- * @param it An iterator pointing to the client in the map of clients.
+ * @param client A pointer to the client leaving the server.
+ * @param reason The reason sent with the QUIT (the client's own message for a QUIT command).
+ * @param type The kind of departure counted by the statistics (shutdown not counted).
  */
-void Server::prepareClientToLeave(std::map<int, Client*>::iterator it, const std::string& reason)
+void Server::prepareClientToLeave(Client* client, const std::string& reason, stats::Disconnect type)
 {
-	int clientFd = it->first;
-	Client* client = it->second;
+	if (client->isMarkedForDeletion())
+		return;
+
+	// Ses messages aux grands canaux arrivent à tous avant son départ
+	FanoutEngine::finish(client);
+	client->markForDeletion();
+	ServerStats::countDisconnect(type);
 
+	if (!client->getChannelsJoined().empty())
+		sendToNeighbors(client, MessageBuilder::ircClientQuitServer(client->getUsermask(), reason), false);
 	client->leaveAllChannels(_channels, reason, leaving_code::QUIT_SERV);
-	_disconnectClient(clientFd, reason);
-	_clientsToDelete.push_back(it);
+	_disconnectClient(client->getFd(), reason);
+	_clientsToDelete.push_back(client);
 }
 
 
@@ -187,15 +328,17 @@ std::map<std::string, FileData>& Server::getFiles()
  * 
  * This function associates a file with its metadata, including the file's path,
  * the sender, and the receiver, and stores it in the server's internal file map.
+ * Sender and receiver are kept as client handles: if one of them leaves,
+ * the transfer can no longer be resolved, even if its fd or nickname is reused.
  * 
  * @param filename The name of the file to be added.
  * @param path The file system path where the file is located.
- * @param sender The name or identifier of the sender of the file.
- * @param receiver The name or identifier of the receiver of the file.
+ * @param sender A pointer to the client sending the file.
+ * @param receiver A pointer to the client receiving the file.
  */
-void Server::addFile(const std::string& filename, const std::string& path, const std::string& sender, const std::string& receiver)
+void Server::addFile(const std::string& filename, const std::string& path, const Client* sender, const Client* receiver)
 {
-	_files[filename] = FileData(path, sender, receiver);
+	_files[filename] = FileData(path, _clients.getHandle(sender), _clients.getHandle(receiver));
 }
 
 /**
@@ -212,6 +355,19 @@ void Server::removeFile(const std::string& filename)
 	_files.erase(filename);
 }
 
+/**
+ * @brief Hands a file copy (GET) over to the loop.
+ *
+ * The copy advances a few blocks per loop iteration (see FileCopier); its files
+ * are already open and are closed by the copier.
+ *
+ * @param copy The open files, the clients to notify at the end and their nicknames.
+ */
+void Server::startFileCopy(const FileCopy& copy)
+{
+	_fileCopier.post(copy);
+}
+
 
 // ========================================= PRIVATE =======================================
 
@@ -228,8 +384,9 @@ void Server::removeFile(const std::string& filename)
  * 7. Sets the client's hostname or defaults to "127.0.0.1" if unavailable.
  * 8. Adds the client's socket descriptor to the set of descriptors monitored for reading.
  * 9. Sets the start of the client's activity.
- * 10. Prompts the client to enter authentication information.
- * 11. Outputs a debug message indicating the client has connected.
+ * 10. Starts the reverse DNS lookup of the client's IP (without waiting for the answer).
+ * 11. Prompts the client to enter authentication information.
+ * 12. Outputs a debug message indicating the client has connected.
  *
  * @note This function uses perror to print error messages if any system call fails.
  */
@@ -247,6 +404,13 @@ void Server::_acceptNewClient()
 		return;
 	}
 
+	// select() ne peut pas surveiller un descripteur au-delà de FD_SETSIZE : connexion refusée
+	if (newClientFd >= FD_SETSIZE)
+	{
+		_disconnectClient(newClientFd, CONNECTION_FAILED);
+		return;
+	}
+
 	// Rendre le nouveau socket non-bloquant
 	if (fcntl(newClientFd, F_SETFL, O_NONBLOCK) < 0)
 	{
@@ -255,8 +419,9 @@ void Server::_acceptNewClient()
 		return;
 	}
 	_addClient(newClientFd);
+	ServerStats::countAccept();
 
-	Client* client = _clients[newClientFd];
+	Client* client = _clients.get(newClientFd);
 
 	// Si l'adresse et le port du client ne sont pas récupérables (ex: proxy, VPN...)
 	// on assigne des valeurs par défaut pour éviter une déconnexion
@@ -284,6 +449,9 @@ void Server::_acceptNewClient()
 	// Ajouter le descripteur du client à l'ensemble des descripteurs surveillés pour l'écriture et la lecture
 	FD_SET(newClientFd, &_readFds);
 
+	// Recherche du nom d'hôte, sans attendre la réponse
+	_startHostLookup(client);
+
 	// Prompt pour saisir les infos d'authentification
 	std::string authenticationPrompt = IrcHelper::commandToSend(*client);
 	client->sendMessage(MessageBuilder::ircCommandPrompt(authenticationPrompt, ""), NULL);
@@ -296,13 +464,16 @@ void Server::_acceptNewClient()
  * @brief Adds a new client to the server.
  *
  * This function creates a new Client object using the provided client file descriptor
- * and adds it to the server's client map.
+ * and stores it in the slot of its file descriptor in the client table.
  *
  * @param clientFd The file descriptor of the client to be added.
  */
 void Server::_addClient(int clientFd)
 {
-	_clients[clientFd] = new Client(clientFd);
+	_clients.add(new Client(clientFd));
+
+	if (getTotalClientCount() > _maxClientCount)
+		_maxClientCount = getTotalClientCount();
 }
 
 /**
@@ -311,13 +482,25 @@ void Server::_addClient(int clientFd)
  * This function iterates through all connected clients and performs the following actions:
  * - If a client has been inactive for more than 4 minutes, it sends a PING message to the client to check the connection.
  * - If a client has been inactive for more than 5 minutes (no PONG or command received), it prepares the client to be disconnected due to a connection timeout.
+ * - If a client has been inactive for more than server::HIBERNATE_DELAY, it hibernates (releases the memory of its buffers).
  */
 void Server::_checkActivity()
 {
-	for (std::map<int, Client*>::iterator it = _clients.begin(); it != _clients.end(); ++it)
+	// Une seule lecture de l'horloge par tour ; le parcours ne touche que la partie chaude des clients
+	time_t now = time(NULL);
+	const std::vector<Client*>& clients = _clients.getLiveClients();
+	for (std::vector<Client*>::const_iterator it = clients.begin(); it != clients.end(); ++it)
 	{
-		Client* client = it->second;
-		time_t idleTime = client->getIdleTime();
+		Client* client = *it;
+		if (client->isMarkedForDeletion())
+			continue;
+		time_t idleTime = now - client->getLastActivity();
+
+		// Client inactif : il rend la mémoire de ses buffers jusqu'à sa prochaine activité
+		// (pas avant server::HIBERNATE_DELAY après un réveil, même sans ligne complète reçue depuis)
+		if (!client->isHibernating() && idleTime > server::HIBERNATE_DELAY
+			&& now - client->getWakeTime() > server::HIBERNATE_DELAY)
+			client->hibernate();
 
 		// Au bout de 4 minutes d'inactivité, envoie un PING au client pour vérifier sa connexion
 		if (!client->pingSent() && idleTime > server::PING_INTERVAL)
@@ -327,15 +510,43 @@ void Server::_checkActivity()
 		}
 		// Si le client est inactif depuis 5 minutes (pas de PONG ou de commande reçue), on le déconnecte
 		if (idleTime > server::PONG_TIMEOUT)
-			prepareClientToLeave(it, CONNECTION_TIMEOUT);
+			prepareClientToLeave(client, CONNECTION_TIMEOUT, stats::DISCONNECT_TIMEOUT);
+	}
+}
+
+/**
+ * @brief Watches the send queues of all connected clients.
+ *
+ * Clients with pending output are added to the set of descriptors select() watches
+ * for writing. A client whose send queue exceeded server::SENDQ_MAX (it stopped
+ * reading) is disconnected: its output is dropped instead of growing without bound.
+ *
+ * @param writeFds The set of descriptors to watch for writing, filled by this function.
+ */
+void Server::_checkSendQueues(fd_set& writeFds)
+{
+	const std::vector<Client*>& clients = _clients.getLiveClients();
+	for (std::vector<Client*>::const_iterator it = clients.begin(); it != clients.end(); ++it)
+	{
+		Client* client = *it;
+		if (client->isMarkedForDeletion())
+			continue;
+		if (client->sendQueueExceeded())
+			prepareClientToLeave(client, SENDQ_EXCEEDED, stats::DISCONNECT_SENDQ);
+		else if (client->hasPendingOutput())
+			FD_SET(client->getFd(), &writeFds);
 	}
 }
 
 /**
  * @brief Disconnects a client from the server.
  *
- * This function removes the client's socket from the set of descriptors to monitor,
- * closes the client's socket, and prints a message indicating the successful disconnection.
+ * This function removes the client's socket from the set of descriptors to monitor
+ * and prints a message indicating the successful disconnection.
+ * The socket itself is closed when the client is deleted (see _deleteClient()):
+ * as long as the client still owns its slot in the client table, accept() cannot
+ * hand the same fd to a new client during the current loop iteration.
+ * If no client object exists for this fd (failed connection), the socket is closed right away.
  *
  * @param fd The file descriptor of the client to disconnect.
  *
@@ -343,40 +554,65 @@ void Server::_checkActivity()
  */
 void Server::_disconnectClient(int fd, const std::string& reason)
 {
-	if (reason == SHUTDOWN_REASON || reason == CONNECTION_TIMEOUT || reason == CONNECTION_FAILED)
-		_clients[fd]->sendMessage(MessageBuilder::ircErrorQuitServer(reason), NULL);
+	Client* client = _clients.get(fd);
+	if (client && (reason == SHUTDOWN_REASON || reason == CONNECTION_TIMEOUT || reason == CONNECTION_FAILED
+		|| reason == SENDQ_EXCEEDED || reason == RECVQ_EXCEEDED))
+		client->sendMessage(MessageBuilder::ircErrorQuitServer(reason), NULL);
 
 	// Retirer le socket du client des descripteurs à surveiller
-	FD_CLR(fd, &_readFds);
+	if (fd < FD_SETSIZE)
+		FD_CLR(fd, &_readFds);
 
-	// Fermer le socket du client
-	if (close(fd) == -1)
+	// Pas d'objet client (connexion échouée) : on ferme directement le socket
+	if (!client)
 	{
-		perror("Failed to close client socket");
+		if (close(fd) == -1)
+			perror("Failed to close client socket");
 		return;
 	}
 
-	std::string nick = _clients[fd]->isAuthenticated() ? _clients[fd]->getNickname() : "";
-	std::cout << MessageBuilder::msgClientDisconnected(_clients[fd]->getClientIp(), _clients[fd]->getClientPort(), fd, nick) << std::endl;
+	std::string nick = client->isAuthenticated() ? client->getNickname() : "";
+	std::cout << MessageBuilder::msgClientDisconnected(client->getClientIp(), client->getClientPort(), fd, nick) << std::endl;
 }
 
 /**
  * @brief Deletes a client from the connected clients list.
  *
- * This function removes a client from the map of connected clients and deletes the associated
- * client object. It also closes the client's socket connection.
+ * This function closes the client's socket, removes the client from the client table
+ * and from the nickname index, withdraws its invitations, then retires the client object:
+ * the EpochReclaimer deletes it at the end of the loop iteration, once no reader can still use it.
  *
- * @param it An iterator pointing to the client in the map of connected clients.
+ * @param client A pointer to the client to delete.
  *
  * @return void
  */
-void Server::_deleteClient(std::map<int, Client*>::iterator it)
+void Server::_deleteClient(Client* client)
 {
-	if (it != _clients.end())
+	if (!client)
+		return;
+
+	// Retire le pseudo du client de l'index
+	Symbol key = client->getNicknameKey();
+	if (key)
 	{
-		delete it->second; // Supprime l'objet client
-		_clients.erase(it->first); // Supprime l'entrée du client dans map
+		Client** owner = _nicknames.find(key);
+		if (owner && *owner == client)
+			_nicknames.erase(key);
 	}
+
+	// Dernière tentative d'envoi de ce qui reste en file (ex: ERROR de fermeture),
+	// puis fermeture du socket du client, son fd peut maintenant être réattribué
+	client->flushSendQueue();
+	if (close(client->getFd()) == -1)
+		perror("Failed to close client socket");
+
+	// Met à jour le compteur de clients authentifiés
+	if (client->isAuthenticated())
+		_authenticatedCount--;
+
+	_clients.remove(client); // Libère le slot du client dans la table
+	client->withdrawInvitations();
+	EpochReclaimer::retire(client); // Objet client détruit en fin de tour de boucle
 }
 
 /**
@@ -384,10 +620,107 @@ void Server::_deleteClient(std::map<int, Client*>::iterator it)
  * 
  * This function iterates through the list of clients that are marked for deletion,
  * deletes each one. After all clients are deleted, the list is cleared.
+ * A client enters the list only when it gets marked, so it can never be deleted twice.
  */
 void Server::_lateClientDeletion()
 {
-	for (std::vector<std::map<int, Client*>::iterator>::iterator it = _clientsToDelete.begin(); it != _clientsToDelete.end(); ++it)
+	for (std::vector<Client*>::iterator it = _clientsToDelete.begin(); it != _clientsToDelete.end(); ++it)
 		_deleteClient(*it);
 	_clientsToDelete.clear();
-}
\ No newline at end of file
+}
+
+// === FILE TRANSFERS ===
+
+/**
+ * @brief Notifies the clients of the file copies finished during this iteration.
+ *
+ * The receiver learns that the file is there (or that it could not be written),
+ * the sender that it was delivered. A client gone in the meantime is skipped.
+ */
+void Server::_applyFileCopies()
+{
+	std::vector<FileCopy> finished;
+	_fileCopier.takeFinished(finished);
+	for (std::vector<FileCopy>::iterator it = finished.begin(); it != finished.end(); ++it)
+	{
+		Client* receiver = _clients.resolve(it->receiver);
+		Client* sender = _clients.resolve(it->sender);
+		if (it->failed)
+		{
+			if (receiver)
+				receiver->sendMessage(MessageBuilder::errorMsgWriteFile(it->filename), NULL);
+			continue;
+		}
+		if (receiver)
+			receiver->sendMessage(MessageBuilder::msgFileReceived(it->filename, it->senderNick), NULL);
+		if (sender)
+			sender->sendMessage(MessageBuilder::msgFileSent(it->filename, it->receiverNick), receiver);
+	}
+}
+
+// === HOSTNAME LOOKUP ===
+
+/**
+ * @brief Starts the reverse DNS lookup of a new client.
+ *
+ * The answer is immediate when the IP is in /etc/hosts or in the resolver cache.
+ * Otherwise the client is flagged: it can send PASS, NICK and USER meanwhile, and its
+ * registration is completed when the answer (or the timeout) comes in _applyHostLookups().
+ *
+ * @param client A pointer to the newly accepted client.
+ */
+void Server::_startHostLookup(Client* client)
+{
+	client->sendMessage(MessageBuilder::ircNoticeMsg(LOOKING_UP_HOST, IRC_COLOR_INFO), NULL);
+
+	std::string hostname;
+	if (_resolver.lookup(client->getClientIp(), _clients.getHandle(client), hostname))
+		_setClientHost(client, hostname);
+	else
+		client->setHostLookupPending(true);
+}
+
+/**
+ * @brief Gives a client the outcome of its reverse DNS lookup.
+ *
+ * @param client A pointer to the client.
+ * @param hostname The confirmed hostname, or an empty string if none was found (the IP is kept).
+ */
+void Server::_setClientHost(Client* client, const std::string& hostname)
+{
+	client->setHostLookupPending(false);
+	if (hostname.empty())
+	{
+		client->sendMessage(MessageBuilder::ircNoticeMsg(HOST_LOOKUP_FAILED, IRC_COLOR_INFO), NULL);
+		return;
+	}
+	client->setResolvedHost(hostname);
+	client->sendMessage(MessageBuilder::ircNoticeMsg(FOUND_HOST, IRC_COLOR_INFO), NULL);
+}
+
+/**
+ * @brief Delivers the lookups finished during this loop iteration.
+ *
+ * Clients are referenced by handle: a client that left while its lookup was running
+ * (or whose fd was reused) is simply skipped. A client that already sent PASS, NICK
+ * and USER was waiting for this answer, so its registration is completed now.
+ */
+void Server::_applyHostLookups()
+{
+	std::vector<HostLookup> results;
+	_resolver.takeResults(results);
+
+	for (std::vector<HostLookup>::iterator result = results.begin(); result != results.end(); ++result)
+	{
+		for (std::vector<ClientHandle>::iterator handle = result->clients.begin(); handle != result->clients.end(); ++handle)
+		{
+			Client* client = _clients.resolve(*handle);
+			if (!client || !client->isHostLookupPending())
+				continue;
+
+			_setClientHost(client, result->hostname);
+			if (!client->isAuthenticated() && IrcHelper::getCommand(*client) == auth_cmd::CMD_ALL_SET)
+				completeRegistration(client);
+		}
+	}
+}
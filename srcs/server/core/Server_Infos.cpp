@@ -12,6 +12,17 @@
 
 #include "Server.hpp"
 
+#include <algorithm>			// std::sort (commandes les plus lentes en premier)
+
+// === OTHER CLASSES ===
+#include "Client.hpp"
+#include "Channel.hpp"
+#include "MessageBuilder.hpp"
+#include "ServerStats.hpp"
+#include "LoopStats.hpp"
+#include "AllocCounter.hpp"
+#include "EpochReclaimer.hpp"
+
 // =========================================================================================
 
 // === SERVER INFOS GETTERS ===
@@ -65,13 +76,12 @@ int Server::getPort() const
  */
 int Server::getMaxFd()
 {
-	if (!_clients.empty())
-	{
-		int maxClientFd = _clients.rbegin()->first;
-		if (maxClientFd > _maxFd)
-			return maxClientFd;
-	}
-	return _serverSocketFd;
+	int maxFd = _clients.getMaxFd();
+	if (_serverSocketFd > maxFd)
+		maxFd = _serverSocketFd;
+	if (_metrics.getMaxFd() > maxFd)
+		maxFd = _metrics.getMaxFd();
+	return _resolver.getFd() > maxFd ? _resolver.getFd() : maxFd;
 }
 
 /**
@@ -90,13 +100,13 @@ const std::string& Server::getServerPassword() const
 // === CHANNELS ===
 
 /**
- * @brief Returns the list of channels.
+ * @brief Returns the channel registry.
  *
- * This function returns the list of channels as a reference to a map of channel names to Channel pointers.
+ * This function returns a reference to the registry indexing channels by their casefolded name.
  *
- * @return std::map<std::string, Channel*>& The list of channels.
+ * @return ChannelRegistry& The channel registry.
  */
-std::map<std::string, Channel*>& Server::getChannels()
+ChannelRegistry& Server::getChannels()
 {
 	return _channels;
 }
@@ -111,4 +121,296 @@ std::map<std::string, Channel*>& Server::getChannels()
 int Server::getChannelCount() const
 {
 	return _channels.size();
-}
\ No newline at end of file
+}
+
+
+// === SERVER OPERATORS ===
+
+/**
+ * @brief Returns the name expected by OPER.
+ *
+ * @return const std::string& The operator name (stats::OPER_NAME unless set by the environment).
+ */
+const std::string& Server::getOperatorName() const
+{
+	return _operName;
+}
+
+/**
+ * @brief Returns the password expected by OPER.
+ *
+ * @return const std::string& The operator password, empty if no operator is configured.
+ */
+const std::string& Server::getOperatorPassword() const
+{
+	return _operPassword;
+}
+
+
+// === SERVER STATS ===
+
+/**
+ * @brief Sends a STATS report to a server operator.
+ *
+ * The counters are plain integers kept up to date by the loop (see ServerStats):
+ * they are only read and formatted here. Reports:
+ * - t (default): message and byte rates, connections, disconnections by reason, channels.
+ * - m: number of calls of each command used since the server started.
+ * - e: event loop: iteration times, ready fds, lines, bytes flushed and dispatch delay (last window, last minute).
+ * - l: execution time of each command (percentiles), slowest first.
+ * - u: uptime.
+ * - z: pools, queues, heap, resolver, shards, fan-out, deferred reclamation, file copies and metrics endpoint.
+ *
+ * @param client The operator asking for the report.
+ * @param query The letter of the report (any other letter only gets the end of report).
+ */
+void Server::sendServerStats(Client* client, char query)
+{
+	const std::string& nickname = client->getNickname();
+
+	if (query == 't')
+		_sendTrafficStats(client);
+	else if (query == 'm')
+	{
+		const std::vector<CommandStats>& commands = ServerStats::getCommands();
+		for (std::vector<CommandStats>::const_iterator it = commands.begin(); it != commands.end(); ++it)
+			if (it->calls > 0)
+				client->sendMessage(MessageBuilder::ircStatsCommand(nickname, it->name, it->calls), NULL);
+	}
+	else if (query == 'e')
+		_sendLoopStats(client);
+	else if (query == 'l')
+		_sendLatencyStats(client);
+	else if (query == 'u')
+		client->sendMessage(MessageBuilder::ircStatsUptime(nickname, ServerStats::getUptime(time(NULL))), NULL);
+	else if (query == 'z')
+		_sendMemoryStats(client);
+
+	client->sendMessage(MessageBuilder::ircEndOfStats(nickname, query), NULL);
+}
+
+// ========================================= PRIVATE =======================================
+
+/**
+ * @brief Sends the traffic report (STATS t).
+ *
+ * The largest channel is only searched for here, at query time.
+ *
+ * @param client The operator asking for the report.
+ */
+void Server::_sendTrafficStats(Client* client)
+{
+	const std::string& nickname = client->getNickname();
+	const Traffic& total = ServerStats::getTraffic();
+	const Traffic& rates = ServerStats::getRates();
+
+	client->sendMessage(MessageBuilder::ircStatsTraffic(nickname, "Messages", rates.linesIn, total.linesIn, rates.linesOut, total.linesOut), NULL);
+	client->sendMessage(MessageBuilder::ircStatsTraffic(nickname, "Bytes", rates.bytesIn, total.bytesIn, rates.bytesOut, total.bytesOut), NULL);
+	client->sendMessage(MessageBuilder::ircStatsConnections(nickname, ServerStats::getAccepts(), getTotalClientCount(), getMaxClientCount(false)), NULL);
+	client->sendMessage(MessageBuilder::ircStatsDisconnections(nickname, ServerStats::getDisconnects(stats::DISCONNECT_QUIT),
+		ServerStats::getDisconnects(stats::DISCONNECT_TIMEOUT), ServerStats::getDisconnects(stats::DISCONNECT_SENDQ),
+		ServerStats::getDisconnects(stats::DISCONNECT_RECVQ), ServerStats::getDisconnects(stats::DISCONNECT_CLOSED)), NULL);
+
+	const Channel* largest = NULL;
+	for (ChannelRegistry::iterator it = _channels.begin(); it != _channels.end(); ++it)
+		if (!largest || it->value->getConnectedCount() > largest->getConnectedCount())
+			largest = it->value;
+	client->sendMessage(MessageBuilder::ircStatsChannels(nickname, getChannelCount(),
+		largest ? largest->getName() : "", largest ? largest->getConnectedCount() : 0), NULL);
+}
+
+/**
+ * @brief Sends the memory and queues report (STATS z).
+ *
+ * @param client The operator asking for the report.
+ */
+void Server::_sendMemoryStats(Client* client)
+{
+	const std::string& nickname = client->getNickname();
+	ObjectPool<Client>& clientPool = Client::getPool();
+	ObjectPool<Channel>& channelPool = Channel::getPool();
+	ClientMemory memory = getClientMemory();
+
+	client->sendMessage(MessageBuilder::ircStatsPool(nickname, "Client", clientPool.inUse(), clientPool.peak(), clientPool.capacity(), clientPool.slabCount()), NULL);
+	client->sendMessage(MessageBuilder::ircStatsPool(nickname, "Channel", channelPool.inUse(), channelPool.peak(), channelPool.capacity(), channelPool.slabCount()), NULL);
+	client->sendMessage(MessageBuilder::ircStatsQueues(nickname, Client::getTotalQueued(false), Client::getTotalQueued(true), Client::getPeakQueued()), NULL);
+	client->sendMessage(MessageBuilder::ircStatsClientMemory(nickname, memory.activeCount, memory.activeBytes, memory.hibernatingCount, memory.hibernatingBytes), NULL);
+	client->sendMessage(MessageBuilder::ircStatsAllocations(nickname, AllocCounter::allocations, AllocCounter::deallocations, AllocCounter::bytes), NULL);
+	client->sendMessage(MessageBuilder::ircStatsResolver(nickname, _resolver.getPendingCount(), _resolver.getCacheSize()), NULL);
+	if (_shards.isEnabled())
+		client->sendMessage(MessageBuilder::ircStatsShards(nickname, _shards.getShardCount(), _shards.getPendingCount(), _shards.getPeakPending()), NULL);
+	client->sendMessage(MessageBuilder::ircStatsFanout(nickname, FanoutEngine::getThreshold(), FanoutEngine::getJobCount(), FanoutEngine::getDeferredCount(), FanoutEngine::getDeferredDeliveries()), NULL);
+	client->sendMessage(MessageBuilder::ircStatsReclaimer(nickname, EpochReclaimer::getEpoch(), EpochReclaimer::getPendingCount(), EpochReclaimer::getRetiredCount(), EpochReclaimer::getFreedCount()), NULL);
+	client->sendMessage(MessageBuilder::ircStatsFileCopies(nickname, _fileCopier.getPendingCount(), _fileCopier.getBytesCopied()), NULL);
+	if (_metrics.isEnabled())
+		client->sendMessage(MessageBuilder::ircStatsMetrics(nickname, _metrics.getConnectionCount(), _metrics.getScrapeCount()), NULL);
+}
+
+/**
+ * @brief Sends the execution time of each command used since the launch (STATS l).
+ *
+ * Commands are sorted by p99, slowest first, so the expensive ones (JOIN on a big
+ * channel, WHO, MODE...) come at the top. The report is built from memory only: the
+ * whole histograms go to the latency file at shutdown (see stats::LATENCY_FILE_ENV).
+ *
+ * @param client The operator asking for the report.
+ */
+void Server::_sendLatencyStats(Client* client)
+{
+	const std::string& nickname = client->getNickname();
+	const std::vector<CommandStats>& commands = ServerStats::getCommands();
+
+	// p99 + indice de la commande, triés du plus lent au plus rapide
+	std::vector<std::pair<unsigned long, size_t> > order;
+	for (size_t i = 0; i < commands.size(); ++i)
+		if (commands[i].latency.getCount() > 0)
+			order.push_back(std::make_pair(commands[i].latency.getPercentile(99), i));
+	std::sort(order.rbegin(), order.rend());
+
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		const CommandStats& command = commands[order[i].second];
+		client->sendMessage(MessageBuilder::ircStatsLatency(nickname, command.name, command.latency.getCount(),
+			command.latency.getPercentile(50), order[i].first, command.latency.getPercentile(99.9), command.latency.getMax()), NULL);
+	}
+}
+
+
+/**
+ * @brief Sends the event loop report (STATS e).
+ *
+ * The totals and the loop lag, the last window (stats::RATE_WINDOW seconds) and the
+ * last minute (stats::LOOP_WINDOWS windows), then the distribution of the iteration
+ * times and of the dispatch delays since the launch.
+ *
+ * @param client The operator asking for the report.
+ */
+void Server::_sendLoopStats(Client* client)
+{
+	const std::string& nickname = client->getNickname();
+	const LatencyHistogram& tickTime = LoopStats::getTickTime();
+	const LatencyHistogram& lagTime = LoopStats::getLagTime();
+	size_t counts[2] = {1, stats::LOOP_WINDOWS};
+
+	client->sendMessage(MessageBuilder::ircStatsLoop(nickname, tickTime.getCount(), LoopStats::getSlowTicks(),
+		LoopStats::getSlowThreshold(), LoopStats::getLag()), NULL);
+	for (int i = 0; i < 2; ++i)
+	{
+		LoopWindow window = LoopStats::getWindows(counts[i]);
+		client->sendMessage(MessageBuilder::ircStatsLoopWindow(nickname, window.duration, window.busy, window.ticks,
+			window.maxTick, window.readyFds, window.maxReadyFds, window.lines, window.bytesFlushed, window.maxLag), NULL);
+	}
+	client->sendMessage(MessageBuilder::ircStatsLoopTimes(nickname, "Iteration time", tickTime.getCount(), tickTime.getPercentile(50),
+		tickTime.getPercentile(99), tickTime.getPercentile(99.9), tickTime.getMax()), NULL);
+	client->sendMessage(MessageBuilder::ircStatsLoopTimes(nickname, "Dispatch delay", lagTime.getCount(), lagTime.getPercentile(50),
+		lagTime.getPercentile(99), lagTime.getPercentile(99.9), lagTime.getMax()), NULL);
+}
+
+// === METRICS ENDPOINT ===
+
+/**
+ * @brief Writes the HELP and TYPE lines of a metric (Prometheus text format).
+ */
+static void writeMetricHeader(std::ostream& out, const char* name, const char* type, const char* help)
+{
+	out << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+}
+
+/**
+ * @brief Writes the quantiles, sum and count of a duration histogram as a Prometheus summary (seconds).
+ *
+ * @param out The metrics text.
+ * @param name The name of the summary.
+ * @param labels The labels of every sample, "" or ending with a comma (ex: command="JOIN",).
+ * @param histogram The durations, in nanoseconds.
+ */
+static void writeSummary(std::ostream& out, const char* name, const std::string& labels, const LatencyHistogram& histogram)
+{
+	out << name << "{" << labels << "quantile=\"0.5\"} " << histogram.getPercentile(50) / 1e9 << "\n"
+		<< name << "{" << labels << "quantile=\"0.99\"} " << histogram.getPercentile(99) / 1e9 << "\n"
+		<< name << "{" << labels << "quantile=\"0.999\"} " << histogram.getPercentile(99.9) / 1e9 << "\n";
+	std::string plain = labels.empty() ? "" : "{" + labels.substr(0, labels.size() - 1) + "}";
+	out << name << "_sum" << plain << " " << histogram.getSum() / 1e9 << "\n"
+		<< name << "_count" << plain << " " << histogram.getCount() << "\n";
+}
+
+/**
+ * @brief Renders the live counters in Prometheus text format (version 0.0.4), for GET /metrics.
+ *
+ * Only reads the counters kept by the loop (see ServerStats); the process memory
+ * comes from /proc/self/statm.
+ *
+ * @return The metrics text.
+ */
+std::string Server::_renderMetrics()
+{
+	std::ostringstream out;
+	const Traffic& traffic = ServerStats::getTraffic();
+
+	writeMetricHeader(out, "ircserv_uptime_seconds", "gauge", "Seconds since the server started.");
+	out << "ircserv_uptime_seconds " << ServerStats::getUptime(time(NULL)) << "\n";
+
+	// Connexions et canaux
+	writeMetricHeader(out, "ircserv_connections", "gauge", "Clients currently connected.");
+	out << "ircserv_connections " << getTotalClientCount() << "\n";
+	writeMetricHeader(out, "ircserv_connections_peak", "gauge", "Highest number of clients connected at once.");
+	out << "ircserv_connections_peak " << getMaxClientCount(false) << "\n";
+	writeMetricHeader(out, "ircserv_accepted_connections_total", "counter", "Connections accepted.");
+	out << "ircserv_accepted_connections_total " << ServerStats::getAccepts() << "\n";
+	writeMetricHeader(out, "ircserv_disconnections_total", "counter", "Clients that left the server, by reason.");
+	out << "ircserv_disconnections_total{reason=\"quit\"} " << ServerStats::getDisconnects(stats::DISCONNECT_QUIT) << "\n"
+		<< "ircserv_disconnections_total{reason=\"timeout\"} " << ServerStats::getDisconnects(stats::DISCONNECT_TIMEOUT) << "\n"
+		<< "ircserv_disconnections_total{reason=\"sendq\"} " << ServerStats::getDisconnects(stats::DISCONNECT_SENDQ) << "\n"
+		<< "ircserv_disconnections_total{reason=\"recvq\"} " << ServerStats::getDisconnects(stats::DISCONNECT_RECVQ) << "\n"
+		<< "ircserv_disconnections_total{reason=\"closed\"} " << ServerStats::getDisconnects(stats::DISCONNECT_CLOSED) << "\n";
+	writeMetricHeader(out, "ircserv_channels", "gauge", "Channels currently open.");
+	out << "ircserv_channels " << getChannelCount() << "\n";
+
+	// Trafic et files d'attente
+	writeMetricHeader(out, "ircserv_received_lines_total", "counter", "Lines received from the clients.");
+	out << "ircserv_received_lines_total " << traffic.linesIn << "\n";
+	writeMetricHeader(out, "ircserv_sent_lines_total", "counter", "Messages queued to the clients.");
+	out << "ircserv_sent_lines_total " << traffic.linesOut << "\n";
+	writeMetricHeader(out, "ircserv_received_bytes_total", "counter", "Bytes read from the client sockets.");
+	out << "ircserv_received_bytes_total " << traffic.bytesIn << "\n";
+	writeMetricHeader(out, "ircserv_sent_bytes_total", "counter", "Bytes written to the client sockets.");
+	out << "ircserv_sent_bytes_total " << traffic.bytesOut << "\n";
+	writeMetricHeader(out, "ircserv_queued_bytes", "gauge", "Bytes waiting in the client queues.");
+	out << "ircserv_queued_bytes{queue=\"recv\"} " << Client::getTotalQueued(false) << "\n"
+		<< "ircserv_queued_bytes{queue=\"send\"} " << Client::getTotalQueued(true) << "\n";
+
+	// Commandes : appels et durées d'exécution
+	const std::vector<CommandStats>& commands = ServerStats::getCommands();
+	writeMetricHeader(out, "ircserv_commands_total", "counter", "Commands dispatched, by command.");
+	for (size_t i = 0; i < commands.size(); ++i)
+		out << "ircserv_commands_total{command=\"" << commands[i].name << "\"} " << commands[i].calls << "\n";
+	writeMetricHeader(out, "ircserv_command_duration_seconds", "summary", "Execution time of the commands, by command.");
+	for (size_t i = 0; i < commands.size(); ++i)
+		if (commands[i].latency.getCount() > 0)
+			writeSummary(out, "ircserv_command_duration_seconds", "command=\"" + commands[i].name + "\",", commands[i].latency);
+
+	// Boucle et mémoire du processus
+	const LoopWindow window = LoopStats::getWindows(1);
+	writeMetricHeader(out, "ircserv_loop_iteration_seconds", "summary", "Work time of the loop iterations, select() wait excluded.");
+	writeSummary(out, "ircserv_loop_iteration_seconds", "", LoopStats::getTickTime());
+	writeMetricHeader(out, "ircserv_loop_iteration_max_seconds", "gauge", "Longest loop iteration since the server started.");
+	out << "ircserv_loop_iteration_max_seconds " << LoopStats::getTickTime().getMax() / 1e9 << "\n";
+	writeMetricHeader(out, "ircserv_loop_slow_iterations_total", "counter", "Loop iterations longer than the slow threshold.");
+	out << "ircserv_loop_slow_iterations_total " << LoopStats::getSlowTicks() << "\n";
+	writeMetricHeader(out, "ircserv_loop_dispatch_delay_seconds", "summary", "Worst delay between the wakeup and the dispatch of a ready fd, per iteration.");
+	writeSummary(out, "ircserv_loop_dispatch_delay_seconds", "", LoopStats::getLagTime());
+	writeMetricHeader(out, "ircserv_loop_lag_seconds", "gauge", "Worst dispatch delay over the last window.");
+	out << "ircserv_loop_lag_seconds " << LoopStats::getLag() / 1e9 << "\n";
+	writeMetricHeader(out, "ircserv_loop_busy_ratio", "gauge", "Share of the last window spent working.");
+	out << "ircserv_loop_busy_ratio " << (window.duration ? static_cast<double>(window.busy) / window.duration : 0.0) << "\n";
+
+	unsigned long resident, size;
+	if (ServerStats::getProcessMemory(resident, size))
+	{
+		writeMetricHeader(out, "process_resident_memory_bytes", "gauge", "Resident memory size in bytes.");
+		out << "process_resident_memory_bytes " << resident << "\n";
+		writeMetricHeader(out, "process_virtual_memory_bytes", "gauge", "Virtual memory size in bytes.");
+		out << "process_virtual_memory_bytes " << size << "\n";
+	}
+	return out.str();
+}
@@ -17,6 +17,10 @@
 #include "Command.hpp"
 #include "Utils.hpp"
 #include "MessageBuilder.hpp"
+#include "EpochReclaimer.hpp"
+#include "ScratchArena.hpp"
+#include "ServerStats.hpp"
+#include "LoopStats.hpp"
 
 // === NAMESPACES ===
 #include "irc_config.hpp"
@@ -51,6 +55,17 @@ void Server::_init()
 	_setSignal();
 	_setLocalIp();
 	_setServerSocket();
+	_reserveCapacity();
+
+	// Socket du résolveur DNS surveillé comme celui du serveur (aucun si DNS indisponible)
+	_resolver.init();
+	if (_resolver.getFd() != -1)
+		FD_SET(_resolver.getFd(), &_readFds);
+
+	_initChannelShards();
+	_initFanout();
+	_initStats();
+	_initMetrics();
 
 	_timeCreationStr = MessageBuilder::msgServerCreationTime();
 	Utils::writeEnvFile(_localIp, _port, _password);
@@ -128,6 +143,50 @@ void Server::_setLocalIp() // Configure l'adresse réseau pour permettre aux cli
 		throw std::runtime_error(ERR_NO_NETWORK);
 }
 
+/**
+ * @brief Reads the settings of the live counters from the environment, then starts them.
+ *
+ * The OPER password comes from stats::OPER_PASSWORD_ENV: without it, nobody can become
+ * operator. The name comes from stats::OPER_NAME_ENV, stats::OPER_NAME by default.
+ * The latency histograms are written to the file given by stats::LATENCY_FILE_ENV
+ * at shutdown, if any (never from the loop: STATS l answers from memory).
+ * A loop iteration is reported as slow above stats::SLOW_TICK_ENV milliseconds,
+ * stats::SLOW_TICK_MS by default.
+ */
+void Server::_initStats()
+{
+	const char* name = std::getenv(stats::OPER_NAME_ENV.c_str());
+	const char* password = std::getenv(stats::OPER_PASSWORD_ENV.c_str());
+	const char* latencyFile = std::getenv(stats::LATENCY_FILE_ENV.c_str());
+	const char* slowTick = std::getenv(stats::SLOW_TICK_ENV.c_str());
+	int slowTickMs = slowTick ? std::atoi(slowTick) : 0;
+	_operName = name && *name ? name : stats::OPER_NAME;
+	_operPassword = password ? password : "";
+	_latencyFile = latencyFile ? latencyFile : "";
+	ServerStats::start(time(NULL));
+	LoopStats::start((slowTickMs > 0 ? static_cast<unsigned long>(slowTickMs) : stats::SLOW_TICK_MS) * 1000000UL);
+}
+
+/**
+ * @brief Reserves memory for the expected population of clients and channels.
+ *
+ * The Client and Channel object pools, the client table and the lookup indexes
+ * are sized once at startup (see server::EXPECTED_CLIENTS and server::EXPECTED_CHANNELS),
+ * so the first connections and channels do not pay for growth and rehashing.
+ * The pools still grow if the real population exceeds these values.
+ *
+ * @return void
+ */
+void Server::_reserveCapacity()
+{
+	Client::getPool().reserve(server::EXPECTED_CLIENTS);
+	Channel::getPool().reserve(server::EXPECTED_CHANNELS);
+
+	_clients.reserve(server::EXPECTED_CLIENTS);
+	_nicknames.reserve(server::EXPECTED_CLIENTS);
+	_channels.reserve(server::EXPECTED_CHANNELS);
+}
+
 /**
  * @brief Sets up the server socket, binds it to an address and port, and listens for incoming connections.
  *
@@ -216,19 +275,38 @@ void Server::_start()
 		// les nouvelles connexions / déconnexions
 		fd_set readFds = _readFds;
 
+		// Ensemble des descripteurs à surveiller pour l'écriture : clients dont la sendq n'est pas vide
+		// (les clients dont la sendq a débordé sont déconnectés ici)
+		fd_set writeFds;
+		FD_ZERO(&writeFds);
+		_checkSendQueues(writeFds);
+
+		// Connexions HTTP de l'endpoint des métriques : lecture de la requête puis écriture de la réponse
+		_metrics.watch(readFds, writeFds);
+
 		// Récupérer le descripteur maximum pour select()
 		// -> Si pas de client, ce sera le descripteur du serveur
 		// -> Sinon, ce sera le descripteur du client avec le plus grand descripteur
-		// 	qui se trouve a la fin de la map car celle-ci est automatiquement triée par ordre croissant
+		// 	(la table des clients est indexée par fd et tient à jour son fd maximum)
 		_maxFd = getMaxFd();
 
+		// Les émetteurs d'une diffusion en cours ne sont pas lus tant qu'elle n'est pas finie
+		_pauseFanoutSenders(readFds);
+
 		// Délai pour la fonction select: intervalle de 500 ms pour le retour de fonction
+		// (aucune attente s'il reste des opérations de canal, des diffusions ou des copies de fichiers à terminer)
 		struct timeval timeout = {0, 500000};
+		if (_shards.getPendingCount() > 0 || !FanoutEngine::empty() || !_fileCopier.empty())
+			timeout.tv_usec = 0;
 
 		// Attendre que l'un des descripteurs soit prêt pour la lecture ou l'écriture
-		if (select(_maxFd + 1, &readFds, NULL, NULL, &timeout) < 0 && errno != EINTR)
+		int readyCount = select(_maxFd + 1, &readFds, &writeFds, NULL, &timeout);
+		if (readyCount < 0 && errno != EINTR)
 			throw std::runtime_error(ERR_SELECT_SOCKET);
 
+		// Début du tour : durée de travail et retard de traitement mesurés à partir d'ici
+		LoopStats::beginTick(readyCount > 0 ? readyCount : 0);
+
 		// Envoi d'un PING à tous les clients inactifs pour vérifier leur connexion
 		_checkActivity();
 
@@ -240,24 +318,97 @@ void Server::_start()
 		{
 			if (signalReceived)
 				break;
-			if (FD_ISSET(fd, &readFds))
+
+			bool writable = FD_ISSET(fd, &writeFds), readable = FD_ISSET(fd, &readFds);
+			if (!writable && !readable)
+				continue;
+
+			// Délai depuis le réveil, puis temps passé sur ce descripteur (cf LoopStats)
+			LoopStats::beginDispatch();
+
+			// Socket prêt en écriture : on vide ce qu'il accepte de la sendq du client
+			if (writable)
+			{
+				Client* client = _clients.get(fd);
+				if (client)
+					client->flushSendQueue();
+			}
+			if (readable)
 			{
 				if (fd == _serverSocketFd)
 					_acceptNewClient();
+				else if (fd == _resolver.getFd())
+					_resolver.readReplies();
+				else if (fd == _metrics.getFd())
+					_metrics.accept(time(NULL));
 				else
 				{
-					// On retrouve l'iterateur du client correspondant au fd dans la map _clients
-					std::map<int, Client*>::iterator it = _clients.find(fd);
-					_handleMessage(it);
+					// On retrouve le client correspondant au fd par simple index dans la table
+					// (un client marqué pour suppression pendant ce tour n'est plus lu)
+					Client* client = _clients.get(fd);
+					if (client && !client->isMarkedForDeletion())
+						_handleMessage(client);
 				}
 
 			}
+			LoopStats::endDispatch(fd);
+		}
+
+		// Endpoint des métriques : requêtes lues, réponses envoyées
+		// (ses connexions ne sont pas des clients : la boucle ci-dessus les ignore)
+		if (_metrics.isEnabled() && !signalReceived)
+			_serveMetrics(readFds, writeFds);
+
+		// Mode shardé : chaque shard de canaux exécute sa part d'opérations en attente
+		// (chaque phase de fin de tour est chronométrée comme un descripteur, cf LoopStats)
+		if (_shards.isEnabled() && !signalReceived)
+		{
+			LoopStats::beginPhase("");
+			_runChannelShards(shard::TICK_BUDGET);
+			LoopStats::endPhase(stats::PHASE_SHARDS);
+		}
+
+		// Grands canaux : une tranche des diffusions en cours, puis reprise des émetteurs libérés
+		if (!FanoutEngine::empty() && !signalReceived)
+		{
+			LoopStats::beginPhase(StringPool::str(FanoutEngine::getChannel()));
+			FanoutEngine::run(fanout::TICK_BUDGET);
+			LoopStats::endPhase(stats::PHASE_FANOUT);
+			_resumeFanoutSenders();
+		}
+
+		// Copies de fichiers (GET) : quelques blocs par tour, puis fin annoncée aux clients
+		if (!_fileCopier.empty() && !signalReceived)
+		{
+			LoopStats::beginPhase("");
+			_fileCopier.run(file::TICK_BUDGET);
+			LoopStats::endPhase(stats::PHASE_FILE_COPY);
+			_applyFileCopies();
 		}
 
 		// Supprimer les clients en attente de suppression
 		// (les supprimer au fur et à mesure dans la boucle ci-dessus impliquerait
 		// de modifier le conteneur pendant l'itération, ce qui causerait un comportement indéfini)
 		_lateClientDeletion();
+
+		// Recherches DNS : renvois et abandons, puis noms trouvés donnés aux clients
+		time_t now = time(NULL);
+		_resolver.checkTimeouts(now);
+		_applyHostLookups();
+
+		// Débits des compteurs STATS (recalculés à la fin de chaque fenêtre)
+		ServerStats::tick(now);
+		_metrics.checkTimeouts(now);
+
+		// Recycler les chaînes temporaires utilisées hors commande (départs, broadcasts)
+		ScratchArena::reset();
+
+		// Détruire les clients et canaux supprimés pendant ce tour
+		EpochReclaimer::collect();
+
+		// Fin du tour : un tour trop long est signalé avec le client et la commande qui l'ont occupé
+		if (LoopStats::endTick(now))
+			_reportSlowTick();
 	}
 }
 
@@ -271,17 +422,15 @@ void Server::_start()
  * necessary actions based on the received commands. It also manages client deletion
  * and handles exceptions.
  *
- * @param it An iterator pointing to the client in the map of connected clients.
+ * @param client A pointer to the client whose socket is ready for reading.
  *
  * @return void
  *
  * @throws std::exception If an error occurs while processing the client's message.
  */
-void Server::_handleMessage(std::map<int, Client*>::iterator it)
+void Server::_handleMessage(Client* client)
 {
-	int clientFd = it->first;
-	Client* client = it->second;
-	client->setLastActivity();
+	int clientFd = client->getFd();
 
 	char currentBuffer[server::BUFFER_SIZE];
 	std::memset(currentBuffer, 0, sizeof(currentBuffer));
@@ -296,61 +445,117 @@ void Server::_handleMessage(std::map<int, Client*>::iterator it)
 	if (bytesRead == 0)
 	{
 		// Client déconnecté proprement
-		prepareClientToLeave(it, CLIENT_CLOSED_CONNECTION);
+		// (ses dernières opérations de canal encore en attente sont exécutées avant son départ)
+		_runQueuedOperations(client);
+		prepareClientToLeave(client, CLIENT_CLOSED_CONNECTION, stats::DISCONNECT_CLOSED);
 		return;
 	}
 	currentBuffer[bytesRead] = '\0';
+	ServerStats::countBytesIn(bytesRead);
 
-	// On récupère le message stocké dans le buffer du client
-	std::string& bufferMessage = client->getBufferMessage();
+	// Ajoute les nouvelles données reçues au buffer du client (recvq)
+	client->appendToRecvQueue(currentBuffer);
 
-	// Ajoute les nouvelles données reçues au buffer existant
-	bufferMessage.append(currentBuffer);
+	_processLines(client);
+	if (client->isMarkedForDeletion())
+		return;
 
+	// Un client qui accumule des données sans fin de ligne au-delà de la recvq est déconnecté
+	if (client->getRecvQueueSize() > server::RECVQ_MAX)
+	{
+		prepareClientToLeave(client, RECVQ_EXCEEDED, stats::DISCONNECT_RECVQ);
+		return;
+	}
+
+	// S'il reste un message sans fin de ligne dans le buffer c'est because CTRL+D
+	// On l'a déjà stocké dans le buffer, ça sera traité la fois suivante
+	// (des lignes complètes restantes attendent seulement la fin d'une diffusion sur un grand canal)
+	if (client->getRecvQueueSize() > 0 && client->getRecvQueueSize() < server::BUFFER_SIZE - 1
+		&& !client->hasCompleteLine())
+		client->sendMessage("^D", NULL);
+}
+
+/**
+ * @brief Processes the complete lines waiting in the recvq of a client.
+ *
+ * Stops when a command made the client leave (ex: QUIT), or sent a message to a large
+ * channel: the next lines wait until that delivery is over (see _resumeFanoutSenders()).
+ *
+ * @param client The client whose lines are processed.
+ */
+void Server::_processLines(Client* client)
+{
 	// On parcourt les messages tant qu'il y a un \n
-	size_t pos;
-	while (((pos = bufferMessage.find('\n')) != std::string::npos))
+	// (on s'arrête si une commande a fait partir le client, ex: QUIT,
+	// ou si elle a lancé une diffusion sur un grand canal)
+	std::string message;
+	while (!client->isMarkedForDeletion() && FanoutEngine::getPendingFor(client) == 0
+		&& client->extractLine(message))
 	{
-		// On extrait le message jusqu'au \n (non inclus)
-		// + on enlève le \r s'il y en a un (cas irssi)
-		// + on supprime la commande traitée du buffer
-		std::string message = Utils::extractAndCleanMessage(bufferMessage, pos);
+		// Seule une ligne complète compte comme activité :
+		// un client qui envoie des octets sans jamais finir de ligne finit par expirer
+		client->setLastActivity();
+		ServerStats::countLineIn();
 
 		// Debug : affiche le message reçu
 		// std::cout << "---> " << message << std::endl;
 
 		// On traite le message extrait,
 		// le reste sera traité à la prochaine itération
-		_processCommand(it, message);
+		_processCommand(client, message);
 	}
-
-	// S'il reste un message dans le buffer c'est because CTRL+D
-	// On l'a déjà stocké dans le buffer, ça sera traité la fois suivante
-	if (!bufferMessage.empty() && bufferMessage.size() < server::BUFFER_SIZE - 1)
-		client->sendMessage("^D", NULL);
 }
 
 /**
  * @brief Processes the input message from a client.
  *
- * This function takes an iterator to a map of clients and a message string,
- * and processes the input message from the client associated with the iterator.
- * It creates a Command object to manage the command contained in the message.
- * If an exception is thrown during command management, the exception message is sent
- * back to the client.
+ * This function takes a client and a message string,
+ * and processes the input message from this client.
+ * In sharded mode, an operation on a single channel (JOIN, PART, PRIVMSG, MODE)
+ * is posted to the queue of the channel's shard and runs later in the loop;
+ * any other command first runs the operations the client still has in the queues,
+ * so that the commands of a client always take effect in the order they were sent.
+ * Such a command also completes the large-channel deliveries the client still has in progress.
  *
- * @param it Iterator to a map of clients, where the key is an integer and the value is a pointer to a Client object.
+ * @param client A pointer to the client who sent the message.
  * @param message The input message from the client to be processed.
  */
-void Server::_processCommand(std::map<int, Client*>::iterator it, std::string message)
+void Server::_processCommand(Client* client, std::string message)
 {
-	Client* client = it->second;
 	if (client->errorMsgTooLongSent() == true)
 		client->setErrorMsgTooLongSent(false);
 
+	if (_shards.isEnabled() && client->isAuthenticated())
+	{
+		size_t shard;
+		if (_shards.route(message, shard))
+		{
+			_shards.post(shard, _clients.getHandle(client), message);
+			return;
+		}
+		_runQueuedOperations(client);
+		if (client->isMarkedForDeletion())
+			return;
+	}
+	FanoutEngine::finish(client);
+	_executeCommand(client, message);
+}
+
+/**
+ * @brief Runs one command line for a client.
+ *
+ * It creates a Command object to manage the command contained in the message.
+ * If an exception is thrown during command management, the exception message is sent
+ * back to the client.
+ *
+ * @param client A pointer to the client who sent the message.
+ * @param message The command line to run.
+ */
+void Server::_executeCommand(Client* client, const std::string& message)
+{
 	try
 	{
-		Command handler(*this, it);
+		Command handler(*this, client);
 		handler.manageCommand(message);
 	}
 	catch (const std::exception &e)
@@ -360,6 +565,232 @@ void Server::_processCommand(std::map<int, Client*>::iterator it, std::string me
 }
 
 
+// === CHANNEL SHARDS ===
+
+/**
+ * @brief Enables the sharded mode when the environment asks for it.
+ *
+ * The number of shards is read from shard::COUNT_ENV (bounded by shard::MAX_COUNT);
+ * without it, channel commands keep running as soon as they are read.
+ */
+void Server::_initChannelShards()
+{
+	const char* env = std::getenv(shard::COUNT_ENV.c_str());
+	int count = env ? std::atoi(env) : 0;
+	if (count <= 0)
+		return;
+	_shards.init(std::min(static_cast<size_t>(count), shard::MAX_COUNT));
+}
+
+/**
+ * @brief Runs the operations waiting in the shards, in turn.
+ *
+ * Each shard runs at most budget operations, one at a time and starting with a
+ * different shard each round, so a busy channel cannot delay the others for a whole tick.
+ * A shard whose first operation waits for an older one of the same sender (in another
+ * shard) is skipped until that one has run. An operation whose sender left in the meantime is dropped.
+ *
+ * @param budget The maximum number of operations run per shard.
+ */
+void Server::_runChannelShards(size_t budget)
+{
+	if (_shards.isRunning() || _shards.getPendingCount() == 0)
+		return;
+	_shards.setRunning(true);
+
+	size_t shardCount = _shards.getShardCount();
+	size_t first = _shards.nextShard();
+	std::vector<size_t> done(shardCount, 0);
+	ChannelOperation operation;
+
+	bool progress = true;
+	while (progress && _shards.getPendingCount() > 0)
+	{
+		progress = false;
+		for (size_t i = 0; i < shardCount; ++i)
+		{
+			size_t shard = (first + i) % shardCount;
+			if (done[shard] >= budget || !_shards.take(shard, operation))
+				continue;
+			done[shard]++;
+			progress = true;
+
+			Client* client = _clients.resolve(operation.client);
+			if (client)
+				_executeCommand(client, operation.line);
+		}
+	}
+	_shards.setRunning(false);
+}
+
+/**
+ * @brief Runs the queued operations of a client before it does anything else.
+ *
+ * Shards are served in turn until none of the client's operations is left: the
+ * operations queued before them on the same channels run first, so the order
+ * of every channel is kept.
+ *
+ * @param client The client whose operations must take effect now.
+ */
+void Server::_runQueuedOperations(const Client* client)
+{
+	while (!_shards.isRunning() && _shards.getQueuedFor(client->getFd()) > 0)
+		_runChannelShards(1);
+}
+
+
+// === LARGE CHANNELS FAN-OUT ===
+
+/**
+ * @brief Sets the number of members from which a channel message is delivered over several iterations.
+ *
+ * The threshold is read from fanout::THRESHOLD_ENV, fanout::THRESHOLD by default.
+ */
+void Server::_initFanout()
+{
+	const char* env = std::getenv(fanout::THRESHOLD_ENV.c_str());
+	int threshold = env ? std::atoi(env) : 0;
+	FanoutEngine::attach(_clients, threshold > 0 ? static_cast<size_t>(threshold) : fanout::THRESHOLD);
+}
+
+/**
+ * @brief Removes from the read set the senders of the deliveries in progress.
+ *
+ * Their data stays in the socket until the delivery is over: the sender is slowed
+ * down to the pace of its delivery, and its recvq does not grow meanwhile.
+ *
+ * @param readFds The read set given to select().
+ */
+void Server::_pauseFanoutSenders(fd_set& readFds)
+{
+	for (size_t i = 0; i < FanoutEngine::getJobCount(); ++i)
+	{
+		Client* sender = _clients.resolve(FanoutEngine::getSender(i));
+		if (sender)
+			FD_CLR(sender->getFd(), &readFds);
+	}
+}
+
+/**
+ * @brief Processes the lines left in the recvq of the senders whose deliveries are over.
+ *
+ * Their socket is read again from the next iteration on.
+ */
+void Server::_resumeFanoutSenders()
+{
+	std::vector<ClientHandle> released;
+	FanoutEngine::takeReleased(released);
+	for (size_t i = 0; i < released.size(); ++i)
+	{
+		Client* client = _clients.resolve(released[i]);
+		if (client)
+			_processLines(client);
+	}
+}
+
+
+// === METRICS ENDPOINT ===
+
+/**
+ * @brief Opens the metrics endpoint on 127.0.0.1 if metrics::PORT_ENV gives a port.
+ *
+ * Its listening socket is watched by select() like the server one. If it cannot
+ * be opened, the server runs without it.
+ */
+void Server::_initMetrics()
+{
+	const char* env = std::getenv(metrics::PORT_ENV.c_str());
+	int port = env ? std::atoi(env) : 0;
+	if (port <= 0 || port > 65535 || !_metrics.open(port))
+		return;
+	FD_SET(_metrics.getFd(), &_readFds);
+	std::cout << MessageBuilder::msgMetricsEndpoint(port) << std::endl;
+}
+
+/**
+ * @brief Serves the HTTP connections of the metrics endpoint.
+ *
+ * The metrics text is rendered once per iteration at most, and only if a
+ * scraper is waiting for it: between two scrapes, the endpoint costs nothing.
+ *
+ * @param readFds The read set returned by select().
+ * @param writeFds The write set returned by select().
+ */
+void Server::_serveMetrics(const fd_set& readFds, const fd_set& writeFds)
+{
+	_metrics.run(readFds, writeFds);
+	if (_metrics.hasWaiting())
+		_metrics.answer(_renderMetrics());
+}
+
+
+// === LOOP INSTRUMENTATION ===
+
+/**
+ * @brief Logs a slow loop iteration, with what took most of it and the slowest command.
+ *
+ * The client time covers everything done for its descriptor (reading, commands, flushing).
+ * The phases run after the descriptors (channel shards, fan-out, file copies) are timed
+ * the same way: the longest of them is named instead of the client when it took longer.
+ * The command time is the longest single dispatch, wherever it ran.
+ */
+void Server::_reportSlowTick()
+{
+	const LoopTick& tick = LoopStats::getTick();
+	std::string command = tick.slowestCommandTime > 0 ? ServerStats::getCommands()[tick.slowestCommand].name : "";
+	bool phase = tick.slowestPhaseTime > tick.slowestClientTime;
+
+	std::cout << MessageBuilder::msgSlowTick(tick.duration, LoopStats::getSlowThreshold(), tick.readyFds,
+		tick.lines, tick.bytesFlushed, tick.lag, LoopStats::getUnreported()) << std::endl;
+	std::cout << MessageBuilder::msgSlowTickCulprits(phase ? _describePhase(tick) : _describeFd(tick.slowestClientFd),
+		phase ? tick.slowestPhaseTime : tick.slowestClientTime,
+		command, _describeFd(tick.slowestCommandFd), tick.slowestCommandTime) << std::endl;
+}
+
+/**
+ * @brief Names the longest phase of an iteration run after the ready descriptors.
+ *
+ * @param tick The iteration.
+ * @return "channel shards", "fanout" followed by the channel served first, or "file copies".
+ */
+std::string Server::_describePhase(const LoopTick& tick)
+{
+	if (tick.slowestPhase == stats::PHASE_SHARDS)
+		return "channel shards";
+	if (tick.slowestPhase == stats::PHASE_FILE_COPY)
+		return "file copies";
+
+	return tick.slowestPhaseChannel.empty() ? "fanout" : "fanout " + tick.slowestPhaseChannel;
+}
+
+/**
+ * @brief Names what a descriptor of the loop is (client nickname, or server socket).
+ *
+ * @param fd The descriptor (-1 if none).
+ * @return A short description, empty if fd is -1.
+ */
+std::string Server::_describeFd(int fd)
+{
+	std::ostringstream stream;
+	if (fd < 0)
+		return "";
+	if (fd == _serverSocketFd)
+		stream << "new connections";
+	else if (fd == _resolver.getFd())
+		stream << "DNS replies";
+	else if (fd == _metrics.getFd())
+		stream << "metrics endpoint";
+	else
+	{
+		Client* client = _clients.get(fd);
+		if (client)
+			stream << (client->getNickname().empty() ? "*" : client->getNickname()) << " ";
+		stream << "(fd " << fd << ")";
+	}
+	return stream.str();
+}
+
+
 // === CLEAN ===
 
 /**
@@ -374,16 +805,33 @@ void Server::_processCommand(std::map<int, Client*>::iterator it, std::string me
  */
 void Server::_clean()
 {
+	// Occupation des pools d'objets au moment de l'arrêt
+	ObjectPool<Client>& clientPool = Client::getPool();
+	ObjectPool<Channel>& channelPool = Channel::getPool();
+	std::cout << MessageBuilder::msgPoolOccupancy("Client", clientPool.inUse(), clientPool.peak(), clientPool.capacity(), clientPool.slabCount()) << std::endl;
+	std::cout << MessageBuilder::msgPoolOccupancy("Channel", channelPool.inUse(), channelPool.peak(), channelPool.capacity(), channelPool.slabCount()) << std::endl;
+	std::cout << MessageBuilder::msgQueueMemory(Client::getTotalQueued(false), Client::getTotalQueued(true), Client::getPeakQueued()) << std::endl;
+	ClientMemory memory = getClientMemory();
+	std::cout << MessageBuilder::msgClientMemory(memory.activeCount, memory.activeBytes, memory.hibernatingCount, memory.hibernatingBytes) << std::endl;
+	if (_shards.isEnabled())
+		std::cout << MessageBuilder::msgChannelShards(_shards.getShardCount(), _shards.getPendingCount(), _shards.getPeakPending()) << std::endl;
+	std::cout << MessageBuilder::msgFanout(FanoutEngine::getThreshold(), FanoutEngine::getDeferredCount(), FanoutEngine::getDeferredDeliveries()) << std::endl;
+	if (!_latencyFile.empty())
+		std::cout << MessageBuilder::msgLatencyFile(_latencyFile, ServerStats::writeLatencies(_latencyFile)) << std::endl;
+
 	// Fermer toutes connexions clients + objets clients + channels
 	while (!_clients.empty())
 	{
-		int clientFd = _clients.begin()->first;
-		Client* client = _clients.begin()->second;
+		Client* client = _clients.getLiveClients().back();
 
-		client->leaveAllChannels(_channels, SHUTDOWN_REASON, leaving_code::QUIT_SERV);
-		_disconnectClient(clientFd, SHUTDOWN_REASON);
-		_deleteClient(_clients.begin());
+		// (sans effet pour un client déjà marqué, qui a quitté ses canaux et a été déconnecté)
+		prepareClientToLeave(client, SHUTDOWN_REASON, stats::DISCONNECT_SHUTDOWN);
+		_deleteClient(client);
 	}
+	_clientsToDelete.clear();
+	FanoutEngine::clear();
+	_fileCopier.clear();
+	EpochReclaimer::collect();
 
 	// Fermer le socket du serveur
 	if (close(_serverSocketFd) == -1)
@@ -0,0 +1,367 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Resolver.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Resolver.hpp"
+
+#include <fstream>				// lecture de /etc/hosts et /etc/resolv.conf
+#include <sstream>				// découpage des lignes
+#include <cstdio>				// perror()
+#include <cstdlib>				// getenv(), atoi(), rand()
+#include <cstring>				// memset()
+#include <cerrno>				// codes erreur -> errno
+#include <fcntl.h>				// fcntl() -> O_NONBLOCK
+#include <unistd.h>				// close(), getpid()
+#include <arpa/inet.h>			// inet_pton(), htons()
+#include <sys/socket.h>			// socket(), connect(), send(), recv()
+
+// === NAMESPACES ===
+#include "irc_config.hpp"
+
+// =========================================================================================
+
+// === CONSTUCTOR / DESTRUCTOR ===
+
+// ========================================= PUBLIC ========================================
+
+Resolver::Resolver() : _fd(-1), _nextId(0) {}
+
+Resolver::~Resolver()
+{
+	if (_fd != -1)
+		close(_fd);
+}
+
+// ========================================= PRIVATE =======================================
+
+Resolver::Resolver(const Resolver& src) {(void) src;}
+Resolver & Resolver::operator=(const Resolver& src) {(void) src; return *this;}
+
+
+// =========================================================================================
+
+// === SETUP ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Loads /etc/hosts and opens the UDP socket to the nameserver.
+ *
+ * Without a usable nameserver the resolver still answers from /etc/hosts,
+ * and every other lookup ends immediately (clients keep their IP).
+ */
+void Resolver::init()
+{
+	_loadHosts();
+
+	// Identifiants de requête imprévisibles d'un lancement à l'autre (réponses usurpées)
+	std::srand(static_cast<unsigned int>(time(NULL) ^ getpid()));
+	_nextId = static_cast<unsigned short>(std::rand());
+
+	sockaddr_in nameserver;
+	if (!_findNameserver(nameserver))
+		return;
+
+	// Socket connecté : seules les réponses du serveur DNS sont reçues,
+	// et un serveur injoignable est signalé par ECONNREFUSED
+	_fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (_fd == -1 || fcntl(_fd, F_SETFL, O_NONBLOCK) == -1
+		|| connect(_fd, reinterpret_cast<sockaddr*>(&nameserver), sizeof(nameserver)) == -1)
+	{
+		perror("Reverse DNS disabled");
+		if (_fd != -1)
+			close(_fd);
+		_fd = -1;
+	}
+}
+
+// ========================================= PRIVATE =======================================
+
+/**
+ * @brief Reads the IPv4 entries of the hosts file (first name of the first line for each IP).
+ */
+void Resolver::_loadHosts()
+{
+	std::ifstream file(dns::HOSTS_FILE.c_str());
+	std::string line;
+	while (std::getline(file, line))
+	{
+		line = line.substr(0, line.find('#'));
+		std::istringstream fields(line);
+		std::string ip, name;
+		in_addr address;
+		if (!(fields >> ip >> name) || inet_pton(AF_INET, ip.c_str(), &address) != 1)
+			continue;
+		if (_isValidHostname(name) && _hosts.find(ip) == _hosts.end())
+			_hosts[ip] = name;
+	}
+}
+
+/**
+ * @brief Finds the nameserver to query.
+ *
+ * The IRCSERV_NAMESERVER environment variable ("ip" or "ip:port") takes precedence,
+ * which allows running the server against a local stub resolver; otherwise the first
+ * IPv4 "nameserver" line of /etc/resolv.conf is used.
+ *
+ * @param nameserver Receives the address of the nameserver.
+ * @return true if a nameserver was found.
+ */
+bool Resolver::_findNameserver(sockaddr_in& nameserver) const
+{
+	std::string ip;
+	int port = dns::PORT;
+
+	const char* env = std::getenv(dns::NAMESERVER_ENV.c_str());
+	if (env && *env)
+	{
+		ip = env;
+		size_t colon = ip.find(':');
+		if (colon != std::string::npos)
+		{
+			port = std::atoi(ip.c_str() + colon + 1);
+			ip.erase(colon);
+		}
+	}
+	else
+	{
+		std::ifstream file(dns::RESOLV_CONF.c_str());
+		std::string line, keyword, value;
+		while (ip.empty() && std::getline(file, line))
+		{
+			std::istringstream fields(line);
+			if (fields >> keyword >> value && keyword == "nameserver" && value.find(':') == std::string::npos)
+				ip = value;
+		}
+	}
+
+	std::memset(&nameserver, 0, sizeof(nameserver));
+	nameserver.sin_family = AF_INET;
+	nameserver.sin_port = htons(port);
+	return port > 0 && port < 65536 && inet_pton(AF_INET, ip.c_str(), &nameserver.sin_addr) == 1;
+}
+
+
+// =========================================================================================
+
+// === LOOKUP ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Starts the reverse lookup of a client IP.
+ *
+ * Answers coming from /etc/hosts or from the cache are immediate. Otherwise a PTR
+ * query is sent (or the client joins the query already running for this IP) and the
+ * result is delivered later through takeResults().
+ *
+ * @param ip The numeric IPv4 address of the client.
+ * @param client A handle to the client waiting for its hostname.
+ * @param hostname Receives the confirmed hostname when the answer is immediate (empty if unknown).
+ * @return true if the answer is immediate, false if the client must wait for a result.
+ */
+bool Resolver::lookup(const std::string& ip, const ClientHandle& client, std::string& hostname)
+{
+	hostname.clear();
+
+	std::map<std::string, std::string>::const_iterator host = _hosts.find(ip);
+	if (host != _hosts.end())
+	{
+		hostname = host->second;
+		return true;
+	}
+
+	time_t now = time(NULL);
+	std::map<std::string, CacheEntry>::iterator cached = _cache.find(ip);
+	if (cached != _cache.end())
+	{
+		if (cached->second.expiresAt > now)
+		{
+			hostname = cached->second.hostname;
+			return true;
+		}
+		_cache.erase(cached);
+	}
+
+	Query query;
+	if (_fd == -1 || inet_pton(AF_INET, ip.c_str(), &query.address) != 1)
+		return true;
+
+	// Une recherche est déjà en cours pour cette IP (reconnexions) : le client l'attend aussi
+	for (std::map<unsigned short, Query>::iterator it = _queries.begin(); it != _queries.end(); ++it)
+	{
+		if (it->second.ip == ip)
+		{
+			it->second.clients.push_back(client);
+			return false;
+		}
+	}
+
+	query.ip = ip;
+	query.startedAt = now;
+	query.ttl = dns::CACHE_TTL_MAX;
+	query.clients.push_back(client);
+	_startQuery(query, dns::TYPE_PTR, _reverseName(ip), now);
+	return false;
+}
+
+/**
+ * @brief Reads every reply available on the resolver socket.
+ *
+ * Called when select() reports the socket readable. If the nameserver turns out
+ * to be unreachable, every running lookup fails at once instead of waiting for its timeout.
+ */
+void Resolver::readReplies()
+{
+	unsigned char buffer[512];
+	while (_fd != -1)
+	{
+		ssize_t len = recv(_fd, buffer, sizeof(buffer), 0);
+		if (len >= 0)
+		{
+			_handleReply(buffer, len);
+			continue;
+		}
+		if (errno == ECONNREFUSED)
+			while (!_queries.empty())
+				_finish(_queries.begin()->first, "");
+		return;
+	}
+}
+
+/**
+ * @brief Resends the queries left unanswered for dns::RETRY_DELAY seconds,
+ *        and gives up on lookups older than dns::TIMEOUT seconds.
+ *
+ * @param now The current time, read once per loop iteration.
+ */
+void Resolver::checkTimeouts(time_t now)
+{
+	std::map<unsigned short, Query>::iterator it = _queries.begin();
+	while (it != _queries.end())
+	{
+		std::map<unsigned short, Query>::iterator current = it++;
+		if (now - current->second.startedAt >= dns::TIMEOUT)
+			_finish(current->first, "");
+		else if (now - current->second.sentAt >= dns::RETRY_DELAY)
+			_send(current->second, now);
+	}
+}
+
+/**
+ * @brief Hands the finished lookups over to the server.
+ *
+ * @param results Receives the finished lookups (its previous content is discarded).
+ */
+void Resolver::takeResults(std::vector<HostLookup>& results)
+{
+	results.clear();
+	results.swap(_results);
+}
+
+// ========================================= PRIVATE =======================================
+
+void Resolver::_send(Query& query, time_t now)
+{
+	query.sentAt = now;
+
+	// Une requête perdue est renvoyée par checkTimeouts(), un échec d'envoi n'a pas d'autre traitement
+	send(_fd, query.packet.data(), query.packet.size(), 0);
+}
+
+/**
+ * @brief Encodes a query under a fresh identifier and sends it.
+ *
+ * @param query The lookup (copied into the table of running queries).
+ * @param type dns::TYPE_PTR or dns::TYPE_A.
+ * @param name The name queried.
+ * @param now The current time.
+ */
+void Resolver::_startQuery(Query& query, int type, const std::string& name, time_t now)
+{
+	unsigned short id = _nextId;
+	while (_queries.find(id) != _queries.end())
+		++id;
+	_nextId = static_cast<unsigned short>(id * 1103515245u + 12345u);
+
+	query.type = type;
+	query.packet = _buildQuery(id, name, type);
+	Query& stored = _queries[id] = query;
+	_send(stored, now);
+}
+
+/**
+ * @brief Ends a lookup: caches its outcome and queues it for the server.
+ *
+ * @param id The identifier of the running query.
+ * @param hostname The confirmed hostname, empty on failure.
+ */
+void Resolver::_finish(unsigned short id, const std::string& hostname)
+{
+	std::map<unsigned short, Query>::iterator it = _queries.find(id);
+	if (it == _queries.end())
+		return;
+
+	_cacheResult(it->second.ip, hostname, hostname.empty() ? dns::NEGATIVE_TTL : it->second.ttl);
+
+	_results.push_back(HostLookup());
+	_results.back().ip = it->second.ip;
+	_results.back().hostname = hostname;
+	_results.back().clients.swap(it->second.clients);
+	_queries.erase(it);
+}
+
+void Resolver::_cacheResult(const std::string& ip, const std::string& hostname, unsigned int ttl)
+{
+	time_t now = time(NULL);
+
+	// Cache plein : on retire les entrées expirées, puis au besoin une entrée quelconque
+	if (_cache.size() >= dns::CACHE_MAX)
+	{
+		std::map<std::string, CacheEntry>::iterator it = _cache.begin();
+		while (it != _cache.end())
+		{
+			if (it->second.expiresAt <= now)
+				_cache.erase(it++);
+			else
+				++it;
+		}
+		if (_cache.size() >= dns::CACHE_MAX)
+			_cache.erase(_cache.begin());
+	}
+
+	if (ttl < dns::CACHE_TTL_MIN && !hostname.empty())
+		ttl = dns::CACHE_TTL_MIN;
+	if (ttl > dns::CACHE_TTL_MAX)
+		ttl = dns::CACHE_TTL_MAX;
+
+	CacheEntry& entry = _cache[ip];
+	entry.hostname = hostname;
+	entry.expiresAt = now + ttl;
+}
+
+
+// =========================================================================================
+
+// === INFOS ===
+
+int Resolver::getFd() const
+{
+	return _fd;
+}
+size_t Resolver::getPendingCount() const
+{
+	return _queries.size();
+}
+size_t Resolver::getCacheSize() const
+{
+	return _cache.size();
+}
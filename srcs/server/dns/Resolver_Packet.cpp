@@ -0,0 +1,250 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Resolver_Packet.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Resolver.hpp"
+
+#include <cstring>				// memcmp()
+#include <cctype>				// isalnum()
+
+// === NAMESPACES ===
+#include "irc_config.hpp"
+
+// =========================================================================================
+
+// === DNS MESSAGES (RFC 1035) ===
+
+// ========================================= PRIVATE =======================================
+
+static void putShort(std::string& packet, unsigned int value)
+{
+	packet += static_cast<char>((value >> 8) & 0xFF);
+	packet += static_cast<char>(value & 0xFF);
+}
+
+static unsigned int getShort(const unsigned char* msg, size_t pos)
+{
+	return (msg[pos] << 8) | msg[pos + 1];
+}
+
+/**
+ * @brief Encodes a recursive query for one name.
+ *
+ * @param id The identifier of the query, echoed by the nameserver.
+ * @param name The name queried (dotted form).
+ * @param type dns::TYPE_PTR or dns::TYPE_A.
+ * @return The query, ready to be sent over UDP.
+ */
+std::string Resolver::_buildQuery(unsigned short id, const std::string& name, int type)
+{
+	std::string packet;
+	putShort(packet, id);
+	putShort(packet, 0x0100);						// Requête standard, récursion demandée
+	putShort(packet, 1);							// Une question
+	putShort(packet, 0);
+	putShort(packet, 0);
+	putShort(packet, 0);
+
+	// Nom encodé en labels : longueur + caractères, terminé par un label vide
+	size_t start = 0;
+	while (start < name.size())
+	{
+		size_t end = name.find('.', start);
+		if (end == std::string::npos)
+			end = name.size();
+		packet += static_cast<char>(end - start);
+		packet.append(name, start, end - start);
+		start = end + 1;
+	}
+	packet += '\0';
+
+	putShort(packet, type);
+	putShort(packet, 1);							// Classe IN
+	return packet;
+}
+
+/**
+ * @brief Builds the name queried to reverse an IPv4 address.
+ *
+ * @param ip A dotted IPv4 address (a.b.c.d).
+ * @return The name d.c.b.a.in-addr.arpa.
+ */
+std::string Resolver::_reverseName(const std::string& ip)
+{
+	std::string name;
+	size_t end = ip.size();
+	while (end != std::string::npos)
+	{
+		size_t dot = ip.rfind('.', end - 1);
+		size_t start = dot == std::string::npos ? 0 : dot + 1;
+		name.append(ip, start, end - start).append(".");
+		end = dot;
+	}
+	return name + "in-addr.arpa";
+}
+
+/**
+ * @brief Decodes a name, following compression pointers.
+ *
+ * @param msg The whole DNS message.
+ * @param len The size of the message.
+ * @param pos Position of the name; moved past it (past the first pointer if compressed).
+ * @param name Receives the name in dotted form.
+ * @return false if the name is malformed or goes out of the message.
+ */
+bool Resolver::_readName(const unsigned char* msg, size_t len, size_t& pos, std::string& name)
+{
+	size_t cursor = pos;
+	bool jumped = false;
+	int jumps = 0;
+
+	name.clear();
+	while (true)
+	{
+		if (cursor >= len)
+			return false;
+		unsigned char labelLen = msg[cursor];
+
+		// Pointeur de compression : la suite du nom est ailleurs dans le message (boucles bornées)
+		if ((labelLen & 0xC0) == 0xC0)
+		{
+			if (cursor + 1 >= len || ++jumps > 16)
+				return false;
+			if (!jumped)
+				pos = cursor + 2;
+			cursor = getShort(msg, cursor) & 0x3FFF;
+			jumped = true;
+			continue;
+		}
+		if (labelLen & 0xC0)
+			return false;
+
+		cursor++;
+		if (labelLen == 0)
+			break;
+		if (cursor + labelLen > len || name.size() + labelLen > 255)
+			return false;
+		if (!name.empty())
+			name += '.';
+		name.append(reinterpret_cast<const char*>(msg + cursor), labelLen);
+		cursor += labelLen;
+	}
+	if (!jumped)
+		pos = cursor;
+	return true;
+}
+
+/**
+ * @brief Checks that a name found in the DNS can be shown as a client host.
+ *
+ * Only letters, digits, dashes and dots are accepted, so that a hostile PTR record
+ * cannot inject spaces, colons or control characters into IRC messages.
+ *
+ * @param name The name to check.
+ * @return true if the name is usable.
+ */
+bool Resolver::_isValidHostname(const std::string& name)
+{
+	if (name.empty() || name.size() > dns::HOSTLEN || name[0] == '.' || name[0] == '-')
+		return false;
+	for (size_t i = 0; i < name.size(); i++)
+		if (!std::isalnum(static_cast<unsigned char>(name[i])) && name[i] != '-' && name[i] != '.')
+			return false;
+	return true;
+}
+
+/**
+ * @brief Processes one reply of the nameserver.
+ *
+ * A PTR answer gives the candidate name, which is then checked with an A query;
+ * an A answer confirms the name if one of its addresses is the client IP.
+ * Any error (unknown identifier excepted) ends the lookup without a name.
+ *
+ * @param msg The reply.
+ * @param len The size of the reply.
+ */
+void Resolver::_handleReply(const unsigned char* msg, size_t len)
+{
+	if (len < 12)
+		return;
+
+	// Identifiant inconnu (réponse tardive ou usurpée) ou message qui n'est pas une réponse : ignoré
+	unsigned short id = getShort(msg, 0);
+	std::map<unsigned short, Query>::iterator it = _queries.find(id);
+	if (it == _queries.end() || !(msg[2] & 0x80))
+		return;
+	Query& query = it->second;
+
+	unsigned int rcode = msg[3] & 0x0F;
+	unsigned int questions = getShort(msg, 4);
+	unsigned int answers = getShort(msg, 6);
+	if (rcode != 0)
+	{
+		_finish(id, "");
+		return;
+	}
+
+	size_t pos = 12;
+	std::string name;
+	for (unsigned int i = 0; i < questions; i++)
+	{
+		if (!_readName(msg, len, pos, name) || pos + 4 > len)
+		{
+			_finish(id, "");
+			return;
+		}
+		pos += 4;
+	}
+
+	std::string found;
+	bool confirmed = false;
+	for (unsigned int i = 0; i < answers && !confirmed; i++)
+	{
+		if (!_readName(msg, len, pos, name) || pos + 10 > len)
+			break;
+		unsigned int type = getShort(msg, pos);
+		unsigned int ttl = (getShort(msg, pos + 4) << 16) | getShort(msg, pos + 6);
+		size_t rdlength = getShort(msg, pos + 8);
+		size_t rdata = pos + 10;
+		if (rdata + rdlength > len)
+			break;
+		pos = rdata + rdlength;
+
+		if (query.type == dns::TYPE_PTR && type == dns::TYPE_PTR && found.empty())
+		{
+			if (_readName(msg, len, rdata, name) && _isValidHostname(name))
+				found = name;
+		}
+		else if (query.type == dns::TYPE_A && type == dns::TYPE_A && rdlength == 4)
+			confirmed = std::memcmp(msg + rdata, &query.address, 4) == 0;
+		else
+			continue;
+		if (ttl < query.ttl)
+			query.ttl = ttl;
+	}
+
+	if (query.type == dns::TYPE_A)
+	{
+		_finish(id, confirmed ? query.hostname : "");
+		return;
+	}
+	if (found.empty())
+	{
+		_finish(id, "");
+		return;
+	}
+
+	// Confirmation directe : le nom trouvé doit redonner l'IP du client
+	Query next = query;
+	next.hostname = found;
+	_queries.erase(it);
+	_startQuery(next, dns::TYPE_A, found, time(NULL));
+}
@@ -0,0 +1,286 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LoopStats.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "LoopStats.hpp"
+
+// === OTHER CLASSES ===
+#include "ServerStats.hpp"
+
+// =========================================================================================
+
+// === STATIC MEMBERS ===
+
+LoopTick LoopStats::_tick;
+unsigned long long LoopStats::_dispatchStart = 0;
+unsigned long long LoopStats::_phaseStart = 0;
+std::string LoopStats::_phaseChannel;
+unsigned long LoopStats::_linesBase = 0;
+unsigned long LoopStats::_bytesBase = 0;
+LatencyHistogram LoopStats::_tickTime;
+LatencyHistogram LoopStats::_lagTime;
+LoopWindow LoopStats::_current;
+LoopWindow LoopStats::_windows[stats::LOOP_WINDOWS];
+size_t LoopStats::_windowIndex = 0;
+size_t LoopStats::_windowCount = 0;
+unsigned long long LoopStats::_windowStart = 0;
+unsigned long LoopStats::_slowThreshold = stats::SLOW_TICK_MS * 1000000UL;
+unsigned long LoopStats::_slowTicks = 0;
+time_t LoopStats::_lastWarning = 0;
+unsigned long LoopStats::_unreported = 0;
+unsigned long LoopStats::_unreportedBefore = 0;
+
+
+// =========================================================================================
+
+// === SETUP ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Resets the measures when the server starts.
+ *
+ * @param slowThreshold The work time (ns) above which an iteration is slow.
+ */
+void LoopStats::start(unsigned long slowThreshold)
+{
+	_tick = LoopTick();
+	_tick.slowestClientFd = _tick.slowestCommandFd = -1;
+	_tick.slowestPhase = stats::PHASE_NONE;
+	_tickTime.reset();
+	_lagTime.reset();
+	_current = LoopWindow();
+	_windowIndex = _windowCount = 0;
+	_windowStart = ServerStats::clockNs();
+	_slowThreshold = slowThreshold;
+	_slowTicks = _unreported = _unreportedBefore = 0;
+	_lastWarning = 0;
+}
+
+
+// =========================================================================================
+
+// === LOOP ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Starts an iteration, right after select() returned.
+ *
+ * @param readyFds The number of ready descriptors given by select().
+ */
+void LoopStats::beginTick(int readyFds)
+{
+	const Traffic& traffic = ServerStats::getTraffic();
+
+	_tick.wakeup = ServerStats::clockNs();
+	_tick.duration = 0;
+	_tick.readyFds = readyFds;
+	_tick.lag = 0;
+	_tick.lines = _tick.bytesFlushed = 0;
+	_tick.slowestClientFd = _tick.slowestCommandFd = -1;
+	_tick.slowestClientTime = _tick.slowestCommandTime = 0;
+	_tick.slowestCommand = 0;
+	_tick.slowestPhase = stats::PHASE_NONE;
+	_tick.slowestPhaseChannel.clear();
+	_tick.slowestPhaseTime = 0;
+	_linesBase = traffic.linesIn;
+	_bytesBase = traffic.bytesOut;
+}
+
+/**
+ * @brief Stamps a ready descriptor when the loop gets to it (wakeup -> dispatch gap).
+ */
+void LoopStats::beginDispatch()
+{
+	_dispatchStart = ServerStats::clockNs();
+	unsigned long gap = static_cast<unsigned long>(_dispatchStart - _tick.wakeup);
+	if (gap > _tick.lag)
+		_tick.lag = gap;
+}
+
+/**
+ * @brief Ends the dispatch of a ready descriptor, and keeps it if it took the longest.
+ *
+ * @param fd The descriptor served (client, or server socket).
+ */
+void LoopStats::endDispatch(int fd)
+{
+	unsigned long time = static_cast<unsigned long>(ServerStats::clockNs() - _dispatchStart);
+	if (time <= _tick.slowestClientTime)
+		return;
+	_tick.slowestClientFd = fd;
+	_tick.slowestClientTime = time;
+}
+
+/**
+ * @brief Stamps the start of a phase run after the ready descriptors.
+ *
+ * The channel name is copied now: the phase may end the last broadcast
+ * to that channel and release its symbol before the iteration is reported.
+ *
+ * @param channel For the fan-out, the channel served first (empty otherwise).
+ */
+void LoopStats::beginPhase(const std::string& channel)
+{
+	_phaseChannel = channel;
+	_phaseStart = ServerStats::clockNs();
+}
+
+/**
+ * @brief Ends a phase run after the ready descriptors, and keeps it if it took the longest.
+ *
+ * @param phase The phase (channel shards, fan-out, file copies).
+ */
+void LoopStats::endPhase(stats::LoopPhase phase)
+{
+	unsigned long time = static_cast<unsigned long>(ServerStats::clockNs() - _phaseStart);
+	if (time <= _tick.slowestPhaseTime)
+		return;
+	_tick.slowestPhase = phase;
+	_tick.slowestPhaseChannel = _phaseChannel;
+	_tick.slowestPhaseTime = time;
+}
+
+/**
+ * @brief Ends an iteration: records it, adds it to the window, closes the window if it lasted long enough.
+ *
+ * A slow iteration is reported at most once every stats::SLOW_TICK_LOG_INTERVAL seconds;
+ * the others are counted, and the count is given with the next report (getUnreported()).
+ *
+ * @param now The current time.
+ * @return true if this iteration is slow and is to be reported.
+ */
+bool LoopStats::endTick(time_t now)
+{
+	const Traffic& traffic = ServerStats::getTraffic();
+	unsigned long long end = ServerStats::clockNs();
+
+	_tick.duration = static_cast<unsigned long>(end - _tick.wakeup);
+	_tick.lines = traffic.linesIn - _linesBase;
+	_tick.bytesFlushed = traffic.bytesOut - _bytesBase;
+	_tickTime.record(_tick.duration);
+	_lagTime.record(_tick.lag);
+
+	_current.busy += _tick.duration;
+	_current.ticks++;
+	_current.readyFds += _tick.readyFds;
+	_current.lines += _tick.lines;
+	_current.bytesFlushed += _tick.bytesFlushed;
+	if (_tick.duration > _current.maxTick)
+		_current.maxTick = _tick.duration;
+	if (_tick.lag > _current.maxLag)
+		_current.maxLag = _tick.lag;
+	if (static_cast<unsigned long>(_tick.readyFds) > _current.maxReadyFds)
+		_current.maxReadyFds = _tick.readyFds;
+	if (end - _windowStart >= static_cast<unsigned long long>(stats::RATE_WINDOW) * 1000000000ULL)
+		_closeWindow(end);
+
+	if (_tick.duration < _slowThreshold)
+		return false;
+	_slowTicks++;
+	_current.slowTicks++;
+	if (now - _lastWarning < stats::SLOW_TICK_LOG_INTERVAL)
+	{
+		_unreported++;
+		return false;
+	}
+	_lastWarning = now;
+	_unreportedBefore = _unreported;
+	_unreported = 0;
+	return true;
+}
+
+// ========================================= PRIVATE =======================================
+
+/**
+ * @brief Moves the window in progress to the ring (the oldest one is dropped), then starts a new one.
+ *
+ * @param now The current monotonic time (ns).
+ */
+void LoopStats::_closeWindow(unsigned long long now)
+{
+	_current.duration = now - _windowStart;
+	_windows[_windowIndex] = _current;
+	_windowIndex = (_windowIndex + 1) % stats::LOOP_WINDOWS;
+	if (_windowCount < stats::LOOP_WINDOWS)
+		_windowCount++;
+	_current = LoopWindow();
+	_windowStart = now;
+}
+
+
+// =========================================================================================
+
+// === INFOS ===
+
+const LoopTick& LoopStats::getTick()
+{
+	return _tick;
+}
+
+/**
+ * @brief Sums the last finished windows (maximums are kept as maximums).
+ *
+ * @param count The number of windows (1 = the last stats::RATE_WINDOW seconds).
+ * @return The total, empty if no window is finished yet.
+ */
+LoopWindow LoopStats::getWindows(size_t count)
+{
+	LoopWindow total;
+	for (size_t i = 0; i < count && i < _windowCount; ++i)
+	{
+		const LoopWindow& window = _windows[(_windowIndex + stats::LOOP_WINDOWS - 1 - i) % stats::LOOP_WINDOWS];
+		total.duration += window.duration;
+		total.busy += window.busy;
+		total.ticks += window.ticks;
+		total.slowTicks += window.slowTicks;
+		total.readyFds += window.readyFds;
+		total.lines += window.lines;
+		total.bytesFlushed += window.bytesFlushed;
+		if (window.maxTick > total.maxTick)
+			total.maxTick = window.maxTick;
+		if (window.maxLag > total.maxLag)
+			total.maxLag = window.maxLag;
+		if (window.maxReadyFds > total.maxReadyFds)
+			total.maxReadyFds = window.maxReadyFds;
+	}
+	return total;
+}
+
+/**
+ * @brief Gives the loop lag: the worst wakeup -> dispatch gap of the last finished window
+ *        (of the window in progress until one is finished).
+ */
+unsigned long LoopStats::getLag()
+{
+	return _windowCount ? getWindows(1).maxLag : _current.maxLag;
+}
+const LatencyHistogram& LoopStats::getTickTime()
+{
+	return _tickTime;
+}
+const LatencyHistogram& LoopStats::getLagTime()
+{
+	return _lagTime;
+}
+unsigned long LoopStats::getSlowThreshold()
+{
+	return _slowThreshold;
+}
+unsigned long LoopStats::getSlowTicks()
+{
+	return _slowTicks;
+}
+unsigned long LoopStats::getUnreported()
+{
+	return _unreportedBefore;
+}
@@ -0,0 +1,326 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MetricsEndpoint.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MetricsEndpoint.hpp"
+
+#include <sstream>				// std::ostringstream (en-têtes de la réponse)
+#include <cstdio>				// perror()
+#include <cstring>				// memset()
+#include <cerrno>				// errno, EAGAIN, EINTR
+#include <fcntl.h>				// fcntl() -> O_NONBLOCK
+#include <unistd.h>				// close()
+#include <sys/socket.h>			// socket(), bind(), listen(), accept(), recv(), send()
+#include <netinet/in.h>			// sockaddr_in, INADDR_LOOPBACK
+
+// === NAMESPACES ===
+#include "irc_config.hpp"
+
+// =========================================================================================
+
+// === CONSTUCTOR / DESTRUCTOR ===
+
+// ========================================= PUBLIC ========================================
+
+MetricsEndpoint::MetricsEndpoint() : _fd(-1), _scrapes(0) {}
+MetricsEndpoint::~MetricsEndpoint()
+{
+	close();
+}
+
+// ========================================= PRIVATE =======================================
+
+MetricsEndpoint::MetricsEndpoint(const MetricsEndpoint& src) {(void) src;}
+MetricsEndpoint & MetricsEndpoint::operator=(const MetricsEndpoint& src) {(void) src; return *this;}
+
+
+// =========================================================================================
+
+// === SETUP ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Opens the listening socket on the loopback interface only.
+ *
+ * @param port The local port to listen on.
+ * @return true if the endpoint listens, false otherwise (error printed, endpoint disabled).
+ */
+bool MetricsEndpoint::open(int port)
+{
+	_fd = socket(AF_INET, SOCK_STREAM, 0);
+
+	int opt = 1;
+	struct sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(port);
+
+	if (_fd == -1 || setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) == -1
+		|| fcntl(_fd, F_SETFL, O_NONBLOCK) == -1
+		|| bind(_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1
+		|| listen(_fd, metrics::MAX_CONNECTIONS) == -1)
+	{
+		perror("Metrics endpoint disabled");
+		if (_fd != -1)
+			::close(_fd);
+		_fd = -1;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Closes every HTTP connection, then the listening socket.
+ */
+void MetricsEndpoint::close()
+{
+	for (size_t i = 0; i < _connections.size(); ++i)
+		::close(_connections[i].fd);
+	_connections.clear();
+	if (_fd != -1)
+		::close(_fd);
+	_fd = -1;
+}
+
+
+// =========================================================================================
+
+// === LOOP ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Adds the HTTP connections to the sets given to select().
+ *
+ * A connection is read until its request is complete, then written until its response is sent.
+ *
+ * @param readFds The read set of this iteration.
+ * @param writeFds The write set of this iteration.
+ */
+void MetricsEndpoint::watch(fd_set& readFds, fd_set& writeFds) const
+{
+	for (size_t i = 0; i < _connections.size(); ++i)
+	{
+		if (!_connections[i].response.empty())
+			FD_SET(_connections[i].fd, &writeFds);
+		else if (!_connections[i].waiting)
+			FD_SET(_connections[i].fd, &readFds);
+	}
+}
+
+/**
+ * @brief Accepts the pending connections.
+ *
+ * Beyond metrics::MAX_CONNECTIONS open connections (or a descriptor select() cannot watch),
+ * the connection is closed at once.
+ *
+ * @param now The current time.
+ */
+void MetricsEndpoint::accept(time_t now)
+{
+	int fd;
+	while ((fd = ::accept(_fd, NULL, NULL)) != -1)
+	{
+		if (_connections.size() >= metrics::MAX_CONNECTIONS || fd >= FD_SETSIZE
+			|| fcntl(fd, F_SETFL, O_NONBLOCK) == -1)
+		{
+			::close(fd);
+			continue;
+		}
+		MetricsConnection connection;
+		connection.fd = fd;
+		connection.sent = 0;
+		connection.since = now;
+		connection.waiting = false;
+		_connections.push_back(connection);
+	}
+}
+
+/**
+ * @brief Reads the requests and writes the responses of the ready connections.
+ *
+ * A connection is closed once its response is sent, or on error.
+ *
+ * @param readFds The read set returned by select().
+ * @param writeFds The write set returned by select().
+ */
+void MetricsEndpoint::run(const fd_set& readFds, const fd_set& writeFds)
+{
+	for (size_t i = 0; i < _connections.size(); )
+	{
+		MetricsConnection& connection = _connections[i];
+		bool keep = true;
+		if (FD_ISSET(connection.fd, &writeFds) && !connection.response.empty())
+			keep = _write(connection);
+		else if (FD_ISSET(connection.fd, &readFds) && connection.response.empty() && !connection.waiting)
+			keep = _read(connection);
+
+		if (keep)
+			++i;
+		else
+		{
+			::close(connection.fd);
+			_connections.erase(_connections.begin() + i);
+		}
+	}
+}
+
+/**
+ * @brief Sends the metrics to every connection waiting for them.
+ *
+ * @param metrics The metrics in Prometheus text format, rendered once for all.
+ */
+void MetricsEndpoint::answer(const std::string& metrics)
+{
+	for (size_t i = 0; i < _connections.size(); ++i)
+	{
+		if (!_connections[i].waiting)
+			continue;
+		_connections[i].waiting = false;
+		_respond(_connections[i], "200 OK", metrics);
+		_scrapes++;
+	}
+}
+
+/**
+ * @brief Closes the connections still open metrics::TIMEOUT seconds after being accepted.
+ *
+ * @param now The current time.
+ */
+void MetricsEndpoint::checkTimeouts(time_t now)
+{
+	for (size_t i = 0; i < _connections.size(); )
+	{
+		if (now - _connections[i].since < metrics::TIMEOUT)
+		{
+			++i;
+			continue;
+		}
+		::close(_connections[i].fd);
+		_connections.erase(_connections.begin() + i);
+	}
+}
+
+// ========================================= PRIVATE =======================================
+
+/**
+ * @brief Reads what the scraper sent, and parses the request once the headers are complete.
+ *
+ * @return false if the connection is closed by the peer or fails.
+ */
+bool MetricsEndpoint::_read(MetricsConnection& connection)
+{
+	char buffer[1024];
+	ssize_t bytes = recv(connection.fd, buffer, sizeof(buffer), 0);
+	if (bytes == 0)
+		return false;
+	if (bytes < 0)
+		return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+
+	connection.request.append(buffer, bytes);
+	if (connection.request.find("\r\n\r\n") != std::string::npos
+		|| connection.request.find("\n\n") != std::string::npos)
+		_parse(connection);
+	else if (connection.request.size() > metrics::REQUEST_MAX)
+		_respond(connection, "431 Request Header Fields Too Large", "");
+	return true;
+}
+
+/**
+ * @brief Checks the request line: only GET metrics::PATH (query string ignored) is served.
+ */
+void MetricsEndpoint::_parse(MetricsConnection& connection)
+{
+	std::istringstream line(connection.request.substr(0, connection.request.find('\n')));
+	std::string method, target;
+	line >> method >> target;
+	target = target.substr(0, target.find('?'));
+
+	if (method != "GET")
+		_respond(connection, "405 Method Not Allowed", "");
+	else if (target != metrics::PATH)
+		_respond(connection, "404 Not Found", "");
+	else
+		connection.waiting = true;
+	connection.request.clear();
+}
+
+/**
+ * @brief Builds the whole response, sent as soon as the socket is writable (see run()).
+ *
+ * @param connection The connection to answer.
+ * @param status The HTTP status (code and reason).
+ * @param body The body, in plain text.
+ */
+void MetricsEndpoint::_respond(MetricsConnection& connection, const std::string& status, const std::string& body)
+{
+	std::ostringstream response;
+	response << "HTTP/1.1 " << status << "\r\n"
+		<< "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+		<< "Content-Length: " << body.size() << "\r\n"
+		<< "Connection: close\r\n\r\n" << body;
+	connection.response = response.str();
+	connection.sent = 0;
+}
+
+/**
+ * @brief Sends the rest of the response.
+ *
+ * @return false once the response is fully sent (or the socket fails): the connection is to be closed.
+ */
+bool MetricsEndpoint::_write(MetricsConnection& connection)
+{
+	ssize_t bytes = send(connection.fd, connection.response.data() + connection.sent,
+		connection.response.size() - connection.sent, MSG_NOSIGNAL);
+	if (bytes < 0)
+		return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+	connection.sent += bytes;
+	return connection.sent < connection.response.size();
+}
+
+
+// =========================================================================================
+
+// === INFOS ===
+
+int MetricsEndpoint::getFd() const
+{
+	return _fd;
+}
+int MetricsEndpoint::getMaxFd() const
+{
+	int maxFd = _fd;
+	for (size_t i = 0; i < _connections.size(); ++i)
+		if (_connections[i].fd > maxFd)
+			maxFd = _connections[i].fd;
+	return maxFd;
+}
+bool MetricsEndpoint::isEnabled() const
+{
+	return _fd != -1;
+}
+bool MetricsEndpoint::hasWaiting() const
+{
+	for (size_t i = 0; i < _connections.size(); ++i)
+		if (_connections[i].waiting)
+			return true;
+	return false;
+}
+size_t MetricsEndpoint::getConnectionCount() const
+{
+	return _connections.size();
+}
+unsigned long MetricsEndpoint::getScrapeCount() const
+{
+	return _scrapes;
+}
@@ -0,0 +1,231 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ServerStats.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ServerStats.hpp"
+
+#include <fstream>				// std::ofstream (export des histogrammes), std::ifstream (/proc/self/statm)
+#include <unistd.h>				// sysconf() -> taille d'une page
+
+// === OTHER CLASSES ===
+#include "LoopStats.hpp"
+
+// =========================================================================================
+
+// === STATIC MEMBERS ===
+
+time_t ServerStats::_startTime = 0;
+time_t ServerStats::_windowStart = 0;
+Traffic ServerStats::_traffic;
+Traffic ServerStats::_windowBase;
+Traffic ServerStats::_rates;
+unsigned long ServerStats::_accepts = 0;
+unsigned long ServerStats::_disconnects[stats::DISCONNECT_REASONS] = {0};
+std::vector<CommandStats> ServerStats::_commands;
+
+
+// =========================================================================================
+
+// === SETUP ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Resets the counters when the server starts.
+ *
+ * The commands already numbered keep their number, only their counters are reset.
+ *
+ * @param now The current time.
+ */
+void ServerStats::start(time_t now)
+{
+	_startTime = _windowStart = now;
+	_traffic = _windowBase = _rates = Traffic();
+	_accepts = 0;
+	for (int i = 0; i < stats::DISCONNECT_REASONS; ++i)
+		_disconnects[i] = 0;
+	for (size_t i = 0; i < _commands.size(); ++i)
+	{
+		_commands[i].calls = 0;
+		_commands[i].latency.reset();
+	}
+}
+
+/**
+ * @brief Gives a command the index of its counter.
+ *
+ * Called when the command map is built: the index is kept next to the handler,
+ * so that countCommand() never looks the name up.
+ *
+ * @param name The name of the command (key of the command map).
+ * @return The index to give to countCommand().
+ */
+size_t ServerStats::registerCommand(const std::string& name)
+{
+	for (size_t i = 0; i < _commands.size(); ++i)
+		if (_commands[i].name == name)
+			return i;
+
+	CommandStats command;
+	command.name = name;
+	command.calls = 0;
+	_commands.push_back(command);
+	return _commands.size() - 1;
+}
+
+
+// =========================================================================================
+
+// === COUNTERS ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Computes the rates once the current window lasted stats::RATE_WINDOW seconds.
+ *
+ * @param now The current time.
+ */
+void ServerStats::tick(time_t now)
+{
+	time_t elapsed = now - _windowStart;
+	if (elapsed < stats::RATE_WINDOW)
+		return;
+
+	_rates.linesIn = (_traffic.linesIn - _windowBase.linesIn) / elapsed;
+	_rates.linesOut = (_traffic.linesOut - _windowBase.linesOut) / elapsed;
+	_rates.bytesIn = (_traffic.bytesIn - _windowBase.bytesIn) / elapsed;
+	_rates.bytesOut = (_traffic.bytesOut - _windowBase.bytesOut) / elapsed;
+	_windowBase = _traffic;
+	_windowStart = now;
+}
+
+
+// =========================================================================================
+
+// === TIMER ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Reads the monotonic clock (never goes back, unlike time()).
+ *
+ * @return The current time in nanoseconds, from an arbitrary origin.
+ */
+unsigned long long ServerStats::clockNs()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return static_cast<unsigned long long>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+ServerStats::Timer::Timer(size_t id, int fd) : _id(id), _fd(fd), _start(clockNs()) {}
+
+/**
+ * @brief Records the time elapsed since the construction into the histogram of the command,
+ *        and offers it as the slowest command of the loop iteration.
+ */
+ServerStats::Timer::~Timer()
+{
+	unsigned long time = static_cast<unsigned long>(clockNs() - _start);
+	recordLatency(_id, time);
+	LoopStats::noteCommand(_id, _fd, time);
+}
+
+// ========================================= PRIVATE =======================================
+
+ServerStats::Timer::Timer(const Timer& src) : _id(src._id), _fd(src._fd), _start(src._start) {}
+ServerStats::Timer& ServerStats::Timer::operator=(const Timer& src) {(void) src; return *this;}
+
+
+// =========================================================================================
+
+// === INFOS ===
+
+time_t ServerStats::getUptime(time_t now)
+{
+	return now - _startTime;
+}
+const Traffic& ServerStats::getTraffic()
+{
+	return _traffic;
+}
+const Traffic& ServerStats::getRates()
+{
+	return _rates;
+}
+unsigned long ServerStats::getAccepts()
+{
+	return _accepts;
+}
+unsigned long ServerStats::getDisconnects(stats::Disconnect reason)
+{
+	return _disconnects[reason];
+}
+const std::vector<CommandStats>& ServerStats::getCommands()
+{
+	return _commands;
+}
+
+/**
+ * @brief Reads the memory of the process from /proc/self/statm (sizes in pages).
+ *
+ * @param resident Set to the resident set size, in bytes.
+ * @param size Set to the virtual memory size, in bytes.
+ * @return false if the file cannot be read (not Linux).
+ */
+bool ServerStats::getProcessMemory(unsigned long& resident, unsigned long& size)
+{
+	std::ifstream statm("/proc/self/statm");
+	unsigned long sizePages, residentPages;
+	if (!(statm >> sizePages >> residentPages))
+		return false;
+
+	unsigned long pageSize = static_cast<unsigned long>(sysconf(_SC_PAGESIZE));
+	resident = residentPages * pageSize;
+	size = sizePages * pageSize;
+	return true;
+}
+
+
+// =========================================================================================
+
+// === EXPORT ===
+
+/**
+ * @brief Writes the latency histogram of every command called since the launch.
+ *
+ * One block per command: a summary line (calls and percentiles in ns), then
+ * one line per non-empty bucket (see LatencyHistogram::write()). The file is replaced.
+ *
+ * @param path The file to write.
+ * @return true if the file was written, false otherwise.
+ */
+bool ServerStats::writeLatencies(const std::string& path)
+{
+	std::ofstream out(path.c_str(), std::ios::out | std::ios::trunc);
+	if (!out)
+		return false;
+
+	out << "# upper_ns count cumulative_fraction\n";
+	for (size_t i = 0; i < _commands.size(); ++i)
+	{
+		const LatencyHistogram& latency = _commands[i].latency;
+		if (latency.getCount() == 0)
+			continue;
+		out << "\n# " << _commands[i].name << " calls=" << latency.getCount()
+			<< " mean=" << latency.getMean() << " p50=" << latency.getPercentile(50)
+			<< " p99=" << latency.getPercentile(99) << " p999=" << latency.getPercentile(99.9)
+			<< " max=" << latency.getMax() << "\n";
+		latency.write(out);
+	}
+	out.flush();
+	return out.good();
+}
@@ -0,0 +1,182 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FileCopier.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "FileCopier.hpp"
+
+#include <algorithm>			// std::min
+#include <cerrno>				// errno, EINTR
+#include <unistd.h>				// read(), write(), close()
+
+// === NAMESPACES ===
+#include "irc_config.hpp"
+
+// =========================================================================================
+
+// === CONSTUCTOR / DESTRUCTOR ===
+
+// ========================================= PUBLIC ========================================
+
+FileCopier::FileCopier() : _bytesCopied(0) {}
+FileCopier::~FileCopier()
+{
+	clear();
+}
+
+// ========================================= PRIVATE =======================================
+
+FileCopier::FileCopier(const FileCopier& src) {(void) src;}
+FileCopier & FileCopier::operator=(const FileCopier& src) {(void) src; return *this;}
+
+
+// =========================================================================================
+
+// === COPIES ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Queues a copy whose two files are already open.
+ *
+ * The copier owns the two descriptors from now on and closes them when the copy ends.
+ *
+ * @param copy The files, the clients to notify and their nicknames.
+ */
+void FileCopier::post(const FileCopy& copy)
+{
+	_copies.push_back(copy);
+	_copies.back().bytes = 0;
+	_copies.back().failed = false;
+}
+
+/**
+ * @brief Advances the copies in progress.
+ *
+ * Each copy gets one block of file::CHUNK_SIZE bytes in turn, until the budget
+ * is spent. A copy that reaches the end of its source, or fails, is closed and
+ * moved to the finished ones.
+ *
+ * @param budget The maximum number of bytes copied by this call.
+ * @return The number of bytes copied.
+ */
+size_t FileCopier::run(size_t budget)
+{
+	size_t done = 0;
+	while (!_copies.empty() && done < budget)
+	{
+		for (size_t i = 0; i < _copies.size() && done < budget;)
+		{
+			FileCopy& copy = _copies[i];
+			unsigned long before = copy.bytes;
+			bool more = _step(copy, std::min(file::CHUNK_SIZE, budget - done));
+			done += copy.bytes - before;
+			if (more)
+			{
+				++i;
+				continue;
+			}
+			_close(copy);
+			_finished.push_back(copy);
+			_copies.erase(_copies.begin() + i);
+		}
+	}
+	_bytesCopied += done;
+	return done;
+}
+
+/**
+ * @brief Hands over the finished copies, so that the loop notifies their clients.
+ *
+ * @param finished Receives the copies (its previous content is discarded).
+ */
+void FileCopier::takeFinished(std::vector<FileCopy>& finished)
+{
+	finished.clear();
+	finished.swap(_finished);
+}
+
+/**
+ * @brief Drops the copies in progress and closes their files.
+ */
+void FileCopier::clear()
+{
+	for (std::deque<FileCopy>::iterator it = _copies.begin(); it != _copies.end(); ++it)
+		_close(*it);
+	_copies.clear();
+	_finished.clear();
+}
+
+// ========================================= PRIVATE =======================================
+
+/**
+ * @brief Copies one block from the source to the target.
+ *
+ * @param copy The copy to advance.
+ * @param length The maximum size of the block.
+ * @return false once the source is fully copied, or on a read or write error.
+ */
+bool FileCopier::_step(FileCopy& copy, size_t length)
+{
+	char buffer[file::CHUNK_SIZE];
+	ssize_t bytesRead = read(copy.source, buffer, length);
+	if (bytesRead < 0)
+	{
+		copy.failed = errno != EINTR;
+		return !copy.failed;
+	}
+	if (bytesRead == 0)
+		return false;
+
+	// Fichier régulier : l'écriture ne s'arrête avant la fin qu'en cas d'erreur (disque plein)
+	ssize_t written = 0;
+	while (written < bytesRead)
+	{
+		ssize_t result = write(copy.target, buffer + written, bytesRead - written);
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result <= 0)
+		{
+			copy.failed = true;
+			return false;
+		}
+		written += result;
+	}
+	copy.bytes += bytesRead;
+	return true;
+}
+
+void FileCopier::_close(FileCopy& copy)
+{
+	if (copy.source != -1)
+		close(copy.source);
+	if (copy.target != -1)
+		close(copy.target);
+	copy.source = -1;
+	copy.target = -1;
+}
+
+
+// =========================================================================================
+
+// === INFOS ===
+
+bool FileCopier::empty() const
+{
+	return _copies.empty();
+}
+size_t FileCopier::getPendingCount() const
+{
+	return _copies.size();
+}
+unsigned long FileCopier::getBytesCopied() const
+{
+	return _bytesCopied;
+}
@@ -0,0 +1,262 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FanoutPipelineTest.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <iostream>				// std::cout, std::cerr
+#include <sstream>				// std::ostringstream
+#include <string>				// std::string
+#include <vector>				// container vector
+#include <cstdlib>				// std::atoi, setenv(), mkdtemp(), realpath()
+#include <cstring>				// memset()
+#include <cstdio>				// perror()
+#include <csignal>				// kill(), SIGINT
+#include <ctime>				// time()
+#include <unistd.h>				// fork(), execl(), chdir(), dup2(), close(), usleep()
+#include <fcntl.h>				// open() -> /dev/null
+#include <sys/wait.h>			// waitpid()
+#include <sys/select.h>			// select()
+#include <sys/socket.h>			// socket(), connect(), send(), recv()
+#include <netinet/in.h>			// sockaddr_in
+#include <arpa/inet.h>			// htons(), inet_addr()
+
+// =========================================================================================
+
+/**
+ * @file FanoutPipelineTest.cpp
+ * @brief Checks that a client pipelining messages to a large channel gets no "^D" back.
+ *
+ * The server is started with a fan-out threshold of 3 members, so every message to the
+ * test channel is delivered over several loop iterations. While its delivery is in progress,
+ * the sender's next lines stay in its recvq: they are complete lines, not a partial one
+ * left by a CTRL+D, and must not be answered with "^D".
+ * The sender pipelines MESSAGES PRIVMSGs in a single write, then a PING: the test reads
+ * until the PONG, and checks that no "^D" came back and that a member received every
+ * message, in order.
+ *
+ * Usage: ./bin/tests/FanoutPipelineTest <path to ircserv> [port]
+ */
+
+// =========================================================================================
+
+// === TEST HELPERS ===
+
+static const int MEMBERS = 6;
+static const int MESSAGES = 50;
+static const char* PASSWORD = "fanout42";
+
+/**
+ * @brief Test client: a socket and what was received but not read line by line yet.
+ */
+struct TestClient
+{
+	int fd;
+	std::string buffer;
+
+	TestClient() : fd(-1) {}
+};
+
+static bool sendLine(TestClient& client, const std::string& line)
+{
+	std::string data = line + "\r\n";
+	return send(client.fd, data.data(), data.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(data.size());
+}
+
+/**
+ * @brief Reads the lines of a client until one contains a marker, or until the timeout.
+ *
+ * @param lines Receives every line read, marker included.
+ * @return true if the marker was found.
+ */
+static bool readUntil(TestClient& client, const std::string& marker, std::vector<std::string>& lines, int timeout)
+{
+	time_t end = time(NULL) + timeout;
+	while (time(NULL) <= end)
+	{
+		size_t pos;
+		while ((pos = client.buffer.find("\r\n")) != std::string::npos)
+		{
+			lines.push_back(client.buffer.substr(0, pos));
+			client.buffer.erase(0, pos + 2);
+			if (lines.back().find(marker) != std::string::npos)
+				return true;
+		}
+
+		fd_set readFds;
+		FD_ZERO(&readFds);
+		FD_SET(client.fd, &readFds);
+		struct timeval wait = {0, 200000};
+		if (select(client.fd + 1, &readFds, NULL, NULL, &wait) <= 0)
+			continue;
+		char data[4096];
+		ssize_t bytes = recv(client.fd, data, sizeof(data), 0);
+		if (bytes <= 0)
+			return false;
+		client.buffer.append(data, bytes);
+	}
+	return false;
+}
+
+static bool connectClient(TestClient& client, int port, const std::string& nickname)
+{
+	struct sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+	// Le serveur vient d'être lancé : on réessaie le temps qu'il écoute
+	for (int attempt = 0; attempt < 50; ++attempt)
+	{
+		client.fd = socket(AF_INET, SOCK_STREAM, 0);
+		if (connect(client.fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0)
+			break;
+		close(client.fd);
+		client.fd = -1;
+		usleep(100000);
+	}
+	if (client.fd == -1)
+		return false;
+
+	std::vector<std::string> lines;
+	return sendLine(client, std::string("PASS ") + PASSWORD) && sendLine(client, "NICK " + nickname)
+		&& sendLine(client, "USER " + nickname + " 0 * :Fanout test")
+		&& readUntil(client, " 001 ", lines, 10);
+}
+
+/**
+ * @brief Starts the server in a scratch directory (it writes its .env in the current directory),
+ *        its logs sent to /dev/null.
+ *
+ * @return The pid of the server, -1 on failure.
+ */
+static pid_t startServer(const std::string& binary, int port)
+{
+	char directory[] = "/tmp/ircserv-test-XXXXXX";
+	if (!mkdtemp(directory))
+		return -1;
+
+	pid_t pid = fork();
+	if (pid != 0)
+		return pid;
+
+	std::ostringstream portStr;
+	portStr << port;
+	setenv("IRCSERV_FANOUT_THRESHOLD", "3", 1);
+	int null = open("/dev/null", O_WRONLY);
+	if (null != -1)
+	{
+		dup2(null, STDOUT_FILENO);
+		dup2(null, STDERR_FILENO);
+		close(null);
+	}
+	if (chdir(directory) == 0)
+		execl(binary.c_str(), binary.c_str(), portStr.str().c_str(), PASSWORD, static_cast<char*>(NULL));
+	std::perror("execl");
+	std::exit(127);
+}
+
+
+// =========================================================================================
+
+// === MAIN ===
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <path to ircserv> [port]" << std::endl;
+		return 1;
+	}
+	char binary[4096];
+	if (!realpath(argv[1], binary))
+	{
+		std::perror(argv[1]);
+		return 1;
+	}
+	int port = argc > 2 ? std::atoi(argv[2]) : 6690;
+
+	pid_t server = startServer(binary, port);
+	if (server == -1)
+		return 1;
+
+	bool ok = true;
+	std::vector<TestClient> clients(MEMBERS);
+	std::vector<std::string> lines;
+	for (int i = 0; i < MEMBERS && ok; ++i)
+	{
+		std::ostringstream nickname;
+		nickname << "member" << i;
+		ok = connectClient(clients[i], port, nickname.str())
+			&& sendLine(clients[i], "JOIN #fanout") && readUntil(clients[i], " 366 ", lines, 10);
+	}
+	if (!ok)
+		std::cerr << "FAIL: clients could not register and join" << std::endl;
+
+	// Toutes les lignes en une seule écriture : elles arrivent ensemble dans la recvq de l'émetteur
+	std::string pipeline;
+	for (int i = 0; i < MESSAGES && ok; ++i)
+	{
+		std::ostringstream line;
+		line << "PRIVMSG #fanout :message " << i << "\r\n";
+		pipeline += line.str();
+	}
+	pipeline += "PING :ircserv\r\n";
+	if (ok && send(clients[0].fd, pipeline.data(), pipeline.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(pipeline.size()))
+		ok = false;
+
+	// L'émetteur ne doit recevoir aucun "^D" avant son PONG
+	std::vector<std::string> senderLines;
+	if (ok && !readUntil(clients[0], "PONG", senderLines, 10))
+	{
+		std::cerr << "FAIL: no PONG for the sender" << std::endl;
+		ok = false;
+	}
+	for (size_t i = 0; i < senderLines.size(); ++i)
+		if (senderLines[i] == "^D")
+		{
+			std::cerr << "FAIL: the sender got \"^D\" back" << std::endl;
+			ok = false;
+			break;
+		}
+
+	// Un membre reçoit tous les messages, dans l'ordre
+	std::vector<std::string> memberLines;
+	std::ostringstream last;
+	last << "message " << MESSAGES - 1;
+	if (ok && !readUntil(clients[1], last.str(), memberLines, 10))
+	{
+		std::cerr << "FAIL: a member did not get every message" << std::endl;
+		ok = false;
+	}
+	int expected = 0;
+	for (size_t i = 0; i < memberLines.size() && ok; ++i)
+	{
+		std::ostringstream text;
+		text << ":message " << expected;
+		if (memberLines[i].find(" PRIVMSG #fanout ") == std::string::npos)
+			continue;
+		if (memberLines[i].find(text.str()) == std::string::npos)
+		{
+			std::cerr << "FAIL: messages out of order: " << memberLines[i] << std::endl;
+			ok = false;
+		}
+		expected++;
+	}
+
+	for (int i = 0; i < MEMBERS; ++i)
+		if (clients[i].fd != -1)
+			close(clients[i].fd);
+	kill(server, SIGINT);
+	waitpid(server, NULL, 0);
+
+	std::cout << (ok ? "OK" : "FAIL") << ": " << MESSAGES << " pipelined messages to a fan-out channel" << std::endl;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AllocCounter.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 17:05:12 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 17:05:12 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "AllocCounter.hpp"
+
+#include <cstdlib>				// malloc(), free()
+#include <new>					// std::bad_alloc
+
+// =========================================================================================
+
+// === COUNTERS ===
+
+unsigned long AllocCounter::allocations = 0;
+unsigned long AllocCounter::deallocations = 0;
+unsigned long AllocCounter::bytes = 0;
+
+
+// =========================================================================================
+
+// === GLOBAL OPERATOR NEW / DELETE ===
+
+/**
+ * @brief Replacement of the global operator new: counts the call, then allocates with malloc().
+ *
+ * Every container of the program (std::string, std::vector, std::map...) goes through it.
+ * The counters are updated with relaxed atomic additions (as in EpochReclaimer):
+ * the threads of the benchmarks allocate too, and none of their calls is lost.
+ *
+ * @param size The number of bytes requested.
+ * @return A pointer to the allocated memory.
+ * @throws std::bad_alloc if malloc() fails.
+ */
+void* operator new(size_t size) throw(std::bad_alloc)
+{
+	__atomic_fetch_add(&AllocCounter::allocations, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&AllocCounter::bytes, size, __ATOMIC_RELAXED);
+
+	void* ptr = std::malloc(size ? size : 1);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](size_t size) throw(std::bad_alloc)
+{
+	return operator new(size);
+}
+
+void operator delete(void* ptr) throw()
+{
+	if (!ptr)
+		return;
+	__atomic_fetch_add(&AllocCounter::deallocations, 1, __ATOMIC_RELAXED);
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) throw()
+{
+	operator delete(ptr);
+}
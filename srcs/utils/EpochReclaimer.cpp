@@ -0,0 +1,185 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   EpochReclaimer.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "EpochReclaimer.hpp"
+
+// === NAMESPACES ===
+#include "irc_config.hpp"
+
+// =========================================================================================
+
+// === STATIC MEMBERS ===
+
+unsigned long EpochReclaimer::_epoch = 1;
+EpochReclaimer::Slot EpochReclaimer::_slots[reclaim::MAX_READERS];
+std::vector<EpochReclaimer::Retired> EpochReclaimer::_retired;
+unsigned long EpochReclaimer::_retiredCount = 0;
+unsigned long EpochReclaimer::_freedCount = 0;
+
+
+// =========================================================================================
+
+// === GUARD ===
+
+EpochReclaimer::Guard::Guard(int slot) : _slot(slot)
+{
+	pin(_slot);
+}
+EpochReclaimer::Guard::~Guard()
+{
+	unpin(_slot);
+}
+EpochReclaimer::Guard::Guard(const Guard& src) : _slot(src._slot) {}
+EpochReclaimer::Guard & EpochReclaimer::Guard::operator=(const Guard& src) {(void) src; return *this;}
+
+
+// =========================================================================================
+
+// === READERS ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Claims a reader slot for the calling thread.
+ *
+ * @return The slot to give to pin() / Guard, or -1 if reclaim::MAX_READERS threads already have one.
+ */
+int EpochReclaimer::registerReader()
+{
+	for (size_t i = 0; i < reclaim::MAX_READERS; ++i)
+	{
+		unsigned long free = 0;
+		if (__atomic_compare_exchange_n(&_slots[i].claimed, &free, 1UL, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+			return static_cast<int>(i);
+	}
+	return -1;
+}
+
+/**
+ * @brief Gives back a reader slot. The reader must be out of its critical section.
+ */
+void EpochReclaimer::unregisterReader(int slot)
+{
+	__atomic_store_n(&_slots[slot].pinned, 0UL, __ATOMIC_RELEASE);
+	__atomic_store_n(&_slots[slot].claimed, 0UL, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Enters a critical section: the objects found from now on stay valid until unpin().
+ *
+ * The epoch is read again after being published: if the loop moved it forward in between,
+ * the reader publishes the new one, so the loop never frees an object this reader may find.
+ *
+ * @param slot The slot of the reader (cf registerReader()).
+ */
+void EpochReclaimer::pin(int slot)
+{
+	unsigned long epoch = __atomic_load_n(&_epoch, __ATOMIC_SEQ_CST);
+	while (true)
+	{
+		__atomic_store_n(&_slots[slot].pinned, epoch, __ATOMIC_SEQ_CST);
+		unsigned long current = __atomic_load_n(&_epoch, __ATOMIC_SEQ_CST);
+		if (current == epoch)
+			break;
+		epoch = current;
+	}
+}
+
+/**
+ * @brief Leaves the critical section: pointers found inside must not be used anymore.
+ */
+void EpochReclaimer::unpin(int slot)
+{
+	__atomic_store_n(&_slots[slot].pinned, 0UL, __ATOMIC_RELEASE);
+}
+
+
+// =========================================================================================
+
+// === LOOP THREAD ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Destroys the retired objects that no reader can still see.
+ *
+ * The epoch moves forward (twice at most) if every pinned reader has seen the
+ * current one; then every object retired two epochs ago or more is deleted.
+ * Called at the end of each loop iteration, and at shutdown.
+ *
+ * @return The number of objects destroyed.
+ */
+size_t EpochReclaimer::collect()
+{
+	if (_retired.empty())
+		return 0;
+	for (int i = 0; i < 2 && _tryAdvance(); ++i)
+		;
+
+	size_t count = 0;
+	while (count < _retired.size() && _retired[count].epoch + 2 <= _epoch)
+		++count;
+
+	// Accès par index : un destructeur qui retirerait un autre objet agrandirait la liste
+	for (size_t i = 0; i < count; ++i)
+		_retired[i].destroy(_retired[i].object);
+	_retired.erase(_retired.begin(), _retired.begin() + count);
+	_freedCount += count;
+	return count;
+}
+
+// ========================================= PRIVATE =======================================
+
+void EpochReclaimer::_retire(void* object, void (*destroy)(void*))
+{
+	Retired retired;
+	retired.object = object;
+	retired.destroy = destroy;
+	retired.epoch = _epoch;
+	_retired.push_back(retired);
+	_retiredCount++;
+}
+
+bool EpochReclaimer::_tryAdvance()
+{
+	unsigned long epoch = _epoch;
+	for (size_t i = 0; i < reclaim::MAX_READERS; ++i)
+	{
+		unsigned long pinned = __atomic_load_n(&_slots[i].pinned, __ATOMIC_SEQ_CST);
+		if (pinned != 0 && pinned != epoch)
+			return false;
+	}
+	__atomic_store_n(&_epoch, epoch + 1, __ATOMIC_SEQ_CST);
+	return true;
+}
+
+
+// =========================================================================================
+
+// === INFOS ===
+
+unsigned long EpochReclaimer::getEpoch()
+{
+	return __atomic_load_n(&_epoch, __ATOMIC_SEQ_CST);
+}
+size_t EpochReclaimer::getPendingCount()
+{
+	return _retired.size();
+}
+unsigned long EpochReclaimer::getRetiredCount()
+{
+	return _retiredCount;
+}
+unsigned long EpochReclaimer::getFreedCount()
+{
+	return _freedCount;
+}
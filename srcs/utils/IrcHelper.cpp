@@ -17,6 +17,7 @@
 #include "Channel.hpp"
 #include "Utils.hpp"
 #include "MessageBuilder.hpp"
+#include "ScratchArena.hpp"
 
 // === NAMESPACES ===
 #include "irc_config.hpp"
@@ -287,6 +288,39 @@ std::string IrcHelper::formatUsername(const std::string& username)
 }
 
 
+// === CASEMAPPING HELPER ===
+
+/**
+ * @brief Folds a nickname or channel name to lowercase using RFC 1459 casemapping.
+ *
+ * Besides A-Z -> a-z, RFC 1459 treats the characters []\~ as the uppercase
+ * equivalents of {}|^, so "Nick[1]" and "nick{1}" designate the same user.
+ * The folded string is used as the key of the server's lookup indexes.
+ *
+ * @param name The nickname or channel name to fold.
+ * @return The casefolded name.
+ */
+std::string IrcHelper::toIrcLower(const std::string& name)
+{
+	std::string res = name;
+	for (std::string::size_type i = 0; i < res.size(); ++i)
+	{
+		char c = res[i];
+		if (c >= 'A' && c <= 'Z')
+			res[i] = c + ('a' - 'A');
+		else if (c == '[')
+			res[i] = '{';
+		else if (c == ']')
+			res[i] = '}';
+		else if (c == '\\')
+			res[i] = '|';
+		else if (c == '~')
+			res[i] = '^';
+	}
+	return res;
+}
+
+
 // === MESSAGES HELPER ===
 
 /**
@@ -300,17 +334,18 @@ std::string IrcHelper::formatUsername(const std::string& username)
  * @param msg The IRC message to be sanitized.
  * @param cmd The IRC command associated with the message.
  * @param nickname The nickname of the user sending the message.
- * @return The sanitized IRC message with the leading character removed.
+ * @return The sanitized IRC message with the leading character removed, held by the scratch arena
+ *         (valid until the end of the current command).
  * @throws std::invalid_argument if the message does not meet the required conditions for the given command.
  */
-std::string IrcHelper::sanitizeIrcMessage(std::string msg, const std::string& cmd, const std::string& nickname)
+const std::string& IrcHelper::sanitizeIrcMessage(const std::string& msg, const std::string& cmd, const std::string& nickname)
 {
 	// PART, KICK PRIVMSG, TOPIC, QUIT
 	if (((cmd == PART || cmd == KICK || cmd == PRIVMSG || cmd == TOPIC || cmd == AWAY) && msg[0] != ':')
 		|| (cmd == QUIT && (msg[0] != ':' || Utils::isPrintableSentence(msg) == false)))
 		throw std::invalid_argument(MessageBuilder::ircNeedMoreParams(nickname, cmd));
 
-	return msg.erase(0, 1);
+	return ScratchArena::string().assign(msg, 1, std::string::npos);
 }
 
 
@@ -321,7 +356,7 @@ std::string IrcHelper::sanitizeIrcMessage(std::string msg, const std::string& cm
  *
  * This function performs two checks:
  * 1. Validates the format of the channel name.
- * 2. Checks if the channel exists in the provided channels map.
+ * 2. Checks if the channel exists (the caller resolves it once in the channel registry).
  *
  * If the format of the channel name is invalid, and the optional parameter `opt` is set to "PRINT_ERROR",
  * it sends an error message to the client indicating the bad channel name.
@@ -331,14 +366,14 @@ std::string IrcHelper::sanitizeIrcMessage(std::string msg, const std::string& cm
  *
  * @param client The client requesting the channel check.
  * @param channelName The name of the channel to check.
- * @param channels A map of existing channels.
+ * @param channel The channel found in the registry for this name, or NULL if it does not exist.
  * @param opt Optional parameter to specify if error messages should be sent to the client ("PRINT_ERROR / HIDE_ERROR").
  * @return An integer indicating the result of the check:
  *         - INVALID_FORMAT if the channel name format is invalid.
  *         - NO_FOUND if the channel does not exist.
  *         - ALL_RIGHT if the channel name is valid and the channel exists.
  */
-int IrcHelper::isRightChannel(const Client& client, const std::string& channelName, std::map<std::string, Channel*>& channels, int opt)
+int IrcHelper::isRightChannel(const Client& client, const std::string& channelName, const Channel* channel, int opt)
 {
 	// Check le format du nom du channel
 	if (isValidChannelName(channelName) == false)
@@ -348,7 +383,7 @@ int IrcHelper::isRightChannel(const Client& client, const std::string& channelNa
 		return INVALID_FORMAT;														
 	}
 	// Check si le channel existe
-	if (channelExists(channelName, channels) == false) 
+	if (!channel)
 	{
 		if (opt == PRINT_ERROR)
 			client.sendMessage(MessageBuilder::ircNoSuchChannel(client.getNickname(), channelName), NULL);
@@ -388,29 +423,6 @@ std::string IrcHelper::fixChannelMask(std::string channelName)
 	return res;
 }
 
-/**
- * @brief Checks if a channel exists in the given map of channels.
- * 
- * @param channelName The name of the channel to check for existence.
- * @param channels A map of channel names to Channel pointers.
- * @return true if the channel exists in the map, false otherwise.
- */
-bool IrcHelper::channelExists(const std::string& channelName, std::map<std::string, Channel*>& channels)
-{
-	return channels.find(channelName) != channels.end();
-}
-
-/**
- * @brief Checks if a client exists based on the given file descriptor.
- * 
- * @param clientFd The file descriptor of the client.
- * @return true if the client file descriptor is valid (not -1), false otherwise.
- */
-bool IrcHelper::clientExists(int clientFd)
-{
-	return clientFd != -1;
-}
-
 
 // === MODE HELPER ===
 
@@ -475,11 +487,11 @@ size_t IrcHelper::getExpectedArgCount(std::string mode)
  * @param args A vector of strings containing the mode string and its corresponding arguments.
  * @return A map where the keys are mode characters and the values are the corresponding arguments.
  */
-std::map<char, std::string> IrcHelper::mapModesToArgs(std::vector<std::string> args)
+std::map<char, std::string> IrcHelper::mapModesToArgs(const std::vector<std::string>& args)
 {
-	std::string mode = *++args.begin();
+	const std::string& mode = *++args.begin();
 	std::map<char, std::string> modeArgs;
-	std::vector<std::string>::iterator itArgsMode = ++args.begin();
+	std::vector<std::string>::const_iterator itArgsMode = ++args.begin();
 	itArgsMode++;
 
 	for (size_t i = 0; i < mode.size(); i++)
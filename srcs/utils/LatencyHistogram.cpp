@@ -0,0 +1,152 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LatencyHistogram.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 13:20:51 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 13:20:51 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "LatencyHistogram.hpp"
+
+// =========================================================================================
+
+// === CONSTRUCTOR / DESTRUCTOR ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Allocates every bucket at once: SUB_COUNT exact values below SUB_COUNT,
+ *        then SUB_COUNT buckets per power of two up to 2^MAX_BITS.
+ */
+LatencyHistogram::LatencyHistogram()
+	: _buckets(SUB_COUNT + (MAX_BITS - SUB_BITS + 1) * SUB_COUNT, 0), _count(0), _max(0), _sum(0) {}
+LatencyHistogram::~LatencyHistogram() {}
+
+
+// =========================================================================================
+
+// === RECORD ===
+
+// ========================================= PUBLIC ========================================
+
+void LatencyHistogram::record(unsigned long value)
+{
+	_buckets[_indexOf(value)]++;
+	_count++;
+	_sum += value;
+	if (value > _max)
+		_max = value;
+}
+
+void LatencyHistogram::reset()
+{
+	_buckets.assign(_buckets.size(), 0);
+	_count = _max = 0;
+	_sum = 0;
+}
+
+// ========================================= PRIVATE =======================================
+
+/**
+ * @brief Gives the bucket of a value.
+ *
+ * Below SUB_COUNT, one bucket per value. Above, the highest bit gives the power
+ * of two, and the SUB_BITS bits after it give the linear bucket inside it.
+ */
+size_t LatencyHistogram::_indexOf(unsigned long value)
+{
+	if (value < SUB_COUNT)
+		return value;
+
+	int magnitude = static_cast<int>(sizeof(unsigned long) * 8 - 1) - __builtin_clzl(value);
+	if (magnitude > MAX_BITS)
+		return SUB_COUNT + (MAX_BITS - SUB_BITS + 1) * SUB_COUNT - 1;
+
+	int shift = magnitude - SUB_BITS;
+	return SUB_COUNT + shift * SUB_COUNT + ((value >> shift) & (SUB_COUNT - 1));
+}
+
+/**
+ * @brief Gives the highest value counted in a bucket (percentiles are never underestimated).
+ */
+unsigned long LatencyHistogram::_highestOf(size_t index)
+{
+	if (index < SUB_COUNT)
+		return index;
+
+	size_t shift = (index - SUB_COUNT) / SUB_COUNT;
+	unsigned long sub = (index - SUB_COUNT) % SUB_COUNT;
+	return ((SUB_COUNT + sub + 1) << shift) - 1;
+}
+
+
+// =========================================================================================
+
+// === INFOS ===
+
+unsigned long LatencyHistogram::getCount() const
+{
+	return _count;
+}
+unsigned long LatencyHistogram::getMax() const
+{
+	return _max;
+}
+unsigned long LatencyHistogram::getMean() const
+{
+	return _count ? static_cast<unsigned long>(_sum / _count) : 0;
+}
+unsigned long long LatencyHistogram::getSum() const
+{
+	return _sum;
+}
+
+/**
+ * @brief Gives the value below which a percentage of the recorded values fall.
+ *
+ * @param percentile The percentage, between 0 and 100 (ex: 99.9).
+ * @return The highest value of the bucket reaching that rank (never above the real maximum), 0 if empty.
+ */
+unsigned long LatencyHistogram::getPercentile(double percentile) const
+{
+	if (_count == 0)
+		return 0;
+
+	unsigned long rank = static_cast<unsigned long>(percentile / 100.0 * _count + 0.999999);
+	if (rank == 0)
+		rank = 1;
+
+	unsigned long seen = 0;
+	for (size_t i = 0; i < _buckets.size(); ++i)
+	{
+		seen += _buckets[i];
+		if (seen >= rank)
+			return _highestOf(i) < _max ? _highestOf(i) : _max;
+	}
+	return _max;
+}
+
+
+// =========================================================================================
+
+// === EXPORT ===
+
+/**
+ * @brief Writes the distribution, one non-empty bucket per line:
+ *        highest value of the bucket (ns), number of values, share of values up to it.
+ */
+void LatencyHistogram::write(std::ostream& out) const
+{
+	unsigned long seen = 0;
+	for (size_t i = 0; i < _buckets.size(); ++i)
+	{
+		if (_buckets[i] == 0)
+			continue;
+		seen += _buckets[i];
+		out << _highestOf(i) << " " << _buckets[i] << " " << static_cast<double>(seen) / _count << '\n';
+	}
+}
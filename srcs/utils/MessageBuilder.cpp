@@ -220,6 +220,21 @@ std::string MessageBuilder::ircGlobalUserList(const std::string& nickname, int u
 	return stream.str();
 }
 
+std::string MessageBuilder::ircUserCountPeak(const std::string& nickname, int userCount, int maxUserCount, int knownCount, int maxKnownCount)
+{
+	std::ostringstream stream;
+
+	// Nombre de connexions et pic depuis le lancement du serveur
+	stream << ":" << server::NAME << " " << RPL_LOCALUSERS << " " << nickname << " " << userCount << " " << maxUserCount
+	<< " :Current connections: " << userCount << ", max: " << maxUserCount << eol::IRC;
+
+	// Nombre d'utilisateurs authentifiés et pic depuis le lancement du serveur
+	stream << ":" << server::NAME << " " << RPL_GLOBALUSERS << " " << nickname << " " << knownCount << " " << maxKnownCount
+	<< " :Current users: " << knownCount << ", max: " << maxKnownCount;
+
+	return stream.str();
+}
+
 // --- 431 ERR_NONICKNAMEGIVEN : Aucun nickname fourni.
 std::string MessageBuilder::ircNoNicknameGiven(const std::string& nickname)
 {
@@ -268,34 +283,34 @@ std::string MessageBuilder::ircAlreadyRegistered(const std::string& nickname)
 
 // === RPL MESSAGES ===
 
+// Ces messages sont relayés à chaque PRIVMSG / JOIN / MODE : pas de flux, le message est écrit
+// dans la chaîne de l'appelant, qui garde sa capacité (pas d'allocation en régime établi)
+
 // Message vers channel
-std::string MessageBuilder::ircMsgToChannel(const std::string& nickname, const std::string& channelName, const std::string& message)
+const std::string& MessageBuilder::ircMsgToChannel(std::string& out, const std::string& nickname, const std::string& channelName, const std::string& message)
 {
-	std::ostringstream stream;
-	stream << ":" << nickname << " " << PRIVMSG << " " << channelName << " :" << message;
-	return stream.str();
+	out.assign(":").append(nickname).append(" ").append(PRIVMSG).append(" ").append(channelName).append(" :").append(message);
+	return out;
 }
 // Message privé client to client
-std::string MessageBuilder::ircMsgToClient(const std::string& nickname, const std::string& receiverName, const std::string& message)
+const std::string& MessageBuilder::ircMsgToClient(std::string& out, const std::string& nickname, const std::string& receiverName, const std::string& message)
 {
-	std::ostringstream stream;	
-	stream << ":" << nickname << " " << PRIVMSG << " " << receiverName << " :" << message;
-	return stream.str();
+	out.assign(":").append(nickname).append(" ").append(PRIVMSG).append(" ").append(receiverName).append(" :").append(message);
+	return out;
 }
 // Message envoyé aux autres clients d'un channel quand un client join ce channel
-std::string MessageBuilder::ircClientJoinChannel(const std::string& usermask, const std::string& channelName)
+const std::string& MessageBuilder::ircClientJoinChannel(std::string& out, const std::string& usermask, const std::string& channelName)
 {
-	std::ostringstream stream;	
-	stream << ":" << usermask << " " << JOIN << " :" << channelName;
-	return stream.str();
+	out.assign(":").append(usermask).append(" ").append(JOIN).append(" :").append(channelName);
+	return out;
 }
 // Message envoyé aux autres clients d'un channel quand un opérateur change un mode
-std::string MessageBuilder::ircOpeChangedMode(const std::string& usermask, const std::string& channelName, const std::string& changedMode, const std::string& parameter)
+const std::string& MessageBuilder::ircOpeChangedMode(std::string& out, const std::string& usermask, const std::string& channelName, const std::string& changedMode, const std::string& parameter)
 {
-	std::ostringstream stream;	
-	std::string param = !parameter.empty() ? " " + parameter : "";
-	stream << ":" << usermask << " " << MODE << " " << channelName << " " << changedMode << param;
-	return stream.str();
+	out.assign(":").append(usermask).append(" ").append(MODE).append(" ").append(channelName).append(" ").append(changedMode);
+	if (!parameter.empty())
+		out.append(" ").append(parameter);
+	return out;
 }
 // Message envoyé aux autres clients d'un channel quand le topic est change
 std::string MessageBuilder::ircTopicMessage(const std::string& usermask, const std::string& channelName, const std::string& topic)
@@ -750,6 +765,204 @@ std::string MessageBuilder::ircInvalidPasswordFormat(const std::string &nickname
 }
 
 
+// === RPL SERVER STATS (OPERATORS) ===
+
+// --- 381 RPL_YOUREOPER : Le client est maintenant opérateur du serveur.
+std::string MessageBuilder::ircYoureOper(const std::string& nickname)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_YOUREOPER << " " << nickname
+	<< " :" << IRC_COLOR_SUCCESS << RPL_YOUREOPER_MSG << IRC_RESET;
+	return stream.str();
+}
+
+// --- 491 ERR_NOOPERHOST : Aucun opérateur configuré, ou nom d'opérateur inconnu.
+std::string MessageBuilder::ircNoOperHost(const std::string& nickname)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << ERR_NOOPERHOST << " " << nickname
+	<< " :" << IRC_COLOR_ERR << ERR_NOOPERHOST_MSG << IRC_RESET;
+	return stream.str();
+}
+
+// --- 481 ERR_NOPRIVILEGES : Commande réservée aux opérateurs du serveur.
+std::string MessageBuilder::ircNoPrivileges(const std::string& nickname)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << ERR_NOPRIVILEGES << " " << nickname
+	<< " :" << IRC_COLOR_ERR << ERR_NOPRIVILEGES_MSG << IRC_RESET;
+	return stream.str();
+}
+
+// --- 212 RPL_STATSCOMMANDS : Nombre d'appels d'une commande (STATS m).
+std::string MessageBuilder::ircStatsCommand(const std::string& nickname, const std::string& command, unsigned long calls)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSCOMMANDS << " " << nickname << " " << command << " " << calls;
+	return stream.str();
+}
+
+// --- 242 RPL_STATSUPTIME : Durée de fonctionnement du serveur (STATS u).
+std::string MessageBuilder::ircStatsUptime(const std::string& nickname, time_t uptime)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSUPTIME << " " << nickname << " :Server Up " << uptime / 86400 << " days "
+	<< uptime % 86400 / 3600 << ":" << (uptime % 3600 / 60 < 10 ? "0" : "") << uptime % 3600 / 60
+	<< ":" << (uptime % 60 < 10 ? "0" : "") << uptime % 60;
+	return stream.str();
+}
+
+// --- 249 RPL_STATSDEBUG : Compteurs du serveur, une ligne par sujet (STATS t, STATS z).
+std::string MessageBuilder::ircStatsTraffic(const std::string& nickname, const std::string& label, unsigned long inRate, unsigned long inTotal, unsigned long outRate, unsigned long outTotal)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :" << label << ": in " << inRate << "/s ("
+	<< inTotal << " total), out " << outRate << "/s (" << outTotal << " total)";
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsConnections(const std::string& nickname, unsigned long accepts, int online, int peak)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :Connections: " << accepts
+	<< " accepted, " << online << " online, peak " << peak;
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsDisconnections(const std::string& nickname, unsigned long quit, unsigned long timeout, unsigned long sendq, unsigned long recvq, unsigned long closed)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :Disconnections: " << quit << " quit, "
+	<< timeout << " timeout, " << sendq << " sendq exceeded, " << recvq << " recvq exceeded, " << closed << " closed";
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsChannels(const std::string& nickname, int channelCount, const std::string& largestName, int largestCount)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :Channels: " << channelCount << " active";
+	if (!largestName.empty())
+		stream << ", largest " << largestName << " (" << largestCount << " members)";
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsPool(const std::string& nickname, const std::string& type, size_t inUse, size_t peak, size_t capacity, size_t slabCount)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :" << type << " pool: " << inUse
+	<< " in use, peak " << peak << ", capacity " << capacity << " (" << slabCount << (slabCount > 1 ? " slabs)" : " slab)");
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsQueues(const std::string& nickname, size_t recvQueued, size_t sendQueued, size_t peak)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :Client queues: recvq " << recvQueued
+	<< " B, sendq " << sendQueued << " B, peak " << peak << " B";
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsClientMemory(const std::string& nickname, size_t activeCount, size_t activeBytes, size_t hibernatingCount, size_t hibernatingBytes)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :Client memory: " << activeCount << " active ("
+	<< activeBytes << " B), " << hibernatingCount << " hibernating (" << hibernatingBytes << " B)";
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsAllocations(const std::string& nickname, unsigned long allocations, unsigned long deallocations, unsigned long bytes)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :Heap: " << allocations << " allocations, "
+	<< deallocations << " deallocations, " << bytes << " B requested";
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsResolver(const std::string& nickname, size_t pending, size_t cacheSize)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :DNS resolver: " << pending
+	<< " pending lookups, " << cacheSize << " cached IPs";
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsShards(const std::string& nickname, size_t shardCount, size_t pending, size_t peak)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :Channel shards: " << shardCount
+	<< " shards, " << pending << " queued operations, peak " << peak;
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsFanout(const std::string& nickname, size_t threshold, size_t jobs, unsigned long deferred, unsigned long deliveries)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :Large channels fan-out: " << jobs
+	<< " in progress, " << deferred << " split messages (" << deliveries << " deliveries), threshold " << threshold << " members";
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsReclaimer(const std::string& nickname, unsigned long epoch, size_t pending, unsigned long retired, unsigned long freed)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :Deferred reclamation: epoch " << epoch
+	<< ", " << pending << " pending, " << retired << " retired, " << freed << " freed";
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsFileCopies(const std::string& nickname, size_t pending, unsigned long bytes)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :File copies: " << pending
+	<< " in progress, " << bytes << " B copied";
+	return stream.str();
+}
+
+// --- 249 RPL_STATSDEBUG : Durées d'exécution d'une commande, en microsecondes (STATS l).
+std::string MessageBuilder::ircStatsLatency(const std::string& nickname, const std::string& command, unsigned long calls, unsigned long p50, unsigned long p99, unsigned long p999, unsigned long max)
+{
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(1);
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :" << command << ": " << calls
+	<< " calls, p50 " << p50 / 1000.0 << " us, p99 " << p99 / 1000.0 << " us, p999 " << p999 / 1000.0
+	<< " us, max " << max / 1000.0 << " us";
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsMetrics(const std::string& nickname, size_t connections, unsigned long scrapes)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :Metrics endpoint: " << connections
+	<< " connections, " << scrapes << " scrapes";
+	return stream.str();
+}
+
+// --- 249 RPL_STATSDEBUG : Tours de boucle et retard de traitement, durées en millisecondes (STATS e).
+std::string MessageBuilder::ircStatsLoop(const std::string& nickname, unsigned long ticks, unsigned long slowTicks, unsigned long threshold, unsigned long lag)
+{
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(1);
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :Event loop: " << ticks << " iterations, "
+	<< slowTicks << " slow (over " << threshold / 1e6 << " ms), loop lag " << lag / 1e6 << " ms";
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsLoopWindow(const std::string& nickname, unsigned long long duration, unsigned long long busy, unsigned long ticks, unsigned long maxTick, unsigned long readyFds, unsigned long maxReadyFds, unsigned long lines, unsigned long bytesFlushed, unsigned long maxLag)
+{
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(1);
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :Loop last " << duration / 1e9 << " s: "
+	<< ticks << " iterations, busy " << (duration ? 100.0 * busy / duration : 0.0) << " %, iteration avg "
+	<< (ticks ? busy / 1e6 / ticks : 0.0) << " ms max " << maxTick / 1e6 << " ms, ready fds avg "
+	<< (ticks ? static_cast<double>(readyFds) / ticks : 0.0) << " max " << maxReadyFds << ", " << lines << " lines, "
+	<< bytesFlushed << " B flushed, worst dispatch delay " << maxLag / 1e6 << " ms";
+	return stream.str();
+}
+std::string MessageBuilder::ircStatsLoopTimes(const std::string& nickname, const std::string& label, unsigned long count, unsigned long p50, unsigned long p99, unsigned long p999, unsigned long max)
+{
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(1);
+	stream << ":" << server::NAME << " " << RPL_STATSDEBUG << " " << nickname << " :" << label << ": " << count
+	<< " iterations, p50 " << p50 / 1000.0 << " us, p99 " << p99 / 1000.0 << " us, p999 " << p999 / 1000.0
+	<< " us, max " << max / 1000.0 << " us";
+	return stream.str();
+}
+
+// --- 219 RPL_ENDOFSTATS : Fin d'un rapport STATS.
+std::string MessageBuilder::ircEndOfStats(const std::string& nickname, char query)
+{
+	std::ostringstream stream;
+	stream << ":" << server::NAME << " " << RPL_ENDOFSTATS << " " << nickname << " " << query << " :" << RPL_ENDOFSTATS_MSG;
+	return stream.str();
+}
+
+
 // =========================================================================================
 
 // === SERVER SIDE ===
@@ -837,6 +1050,87 @@ std::string MessageBuilder::msgSignalCaught(const std::string& signalType)
 {
 	return msgBuilder(COLOR_ERR, signalType + " signal caught, server shutting down...", eol::UNIX);
 }
+std::string MessageBuilder::msgPoolOccupancy(const std::string& type, size_t inUse, size_t peak, size_t capacity, size_t slabCount)
+{
+	std::ostringstream stream;
+	stream << type << " pool: " << DEFAULT << inUse << " in use, peak " << peak
+	<< ", capacity " << capacity << " (" << slabCount << (slabCount > 1 ? " slabs)" : " slab)");
+	return msgBuilder("📦 " + COLOR_INFO, stream.str(), "");
+}
+
+std::string MessageBuilder::msgQueueMemory(size_t recvQueued, size_t sendQueued, size_t peak)
+{
+	std::ostringstream stream;
+	stream << "Client queues: " << DEFAULT << "recvq " << recvQueued << " B, sendq " << sendQueued
+	<< " B, peak " << peak << " B";
+	return msgBuilder("📦 " + COLOR_INFO, stream.str(), "");
+}
+
+std::string MessageBuilder::msgClientMemory(size_t activeCount, size_t activeBytes, size_t hibernatingCount, size_t hibernatingBytes)
+{
+	std::ostringstream stream;
+	stream << "Client memory: " << DEFAULT << activeCount << " active (" << activeBytes << " B), "
+	<< hibernatingCount << " hibernating (" << hibernatingBytes << " B)";
+	return msgBuilder("📦 " + COLOR_INFO, stream.str(), "");
+}
+std::string MessageBuilder::msgChannelShards(size_t shardCount, size_t pending, size_t peak)
+{
+	std::ostringstream stream;
+	stream << "Channel shards: " << DEFAULT << shardCount << " shards, " << pending
+	<< " queued operations, peak " << peak;
+	return msgBuilder("📦 " + COLOR_INFO, stream.str(), "");
+}
+
+std::string MessageBuilder::msgFanout(size_t threshold, unsigned long deferred, unsigned long deliveries)
+{
+	std::ostringstream stream;
+	stream << "Large channels fan-out: " << DEFAULT << deferred << " messages split over several iterations ("
+	<< deliveries << " deliveries), threshold " << threshold << " members";
+	return msgBuilder("📦 " + COLOR_INFO, stream.str(), "");
+}
+
+std::string MessageBuilder::msgLatencyFile(const std::string& path, bool written)
+{
+	if (!written)
+		return msgBuilder(COLOR_ERR, "Latency histograms could not be written to " + path, "");
+	return msgBuilder("📦 " + COLOR_INFO, "Latency histograms: " + DEFAULT + "written to " + path, "");
+}
+
+std::string MessageBuilder::msgMetricsEndpoint(int port)
+{
+	std::ostringstream stream;
+	stream << "Metrics endpoint: " << DEFAULT << "http://127.0.0.1:" << port << metrics::PATH;
+	return msgBuilder("📦 " + COLOR_INFO, stream.str(), "");
+}
+
+std::string MessageBuilder::msgSlowTick(unsigned long duration, unsigned long threshold, int readyFds, unsigned long lines, unsigned long bytesFlushed, unsigned long lag, unsigned long unreported)
+{
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(1);
+	stream << "Slow loop iteration: " << DEFAULT << duration / 1e6 << " ms (threshold " << threshold / 1e6 << " ms), "
+	<< readyFds << " ready fds, " << lines << " lines, " << bytesFlushed << " B flushed, worst dispatch delay "
+	<< lag / 1e6 << " ms";
+	if (unreported > 0)
+		stream << ", " << unreported << " slow iterations not reported since the last warning";
+	return msgBuilder("⚠️  " + COLOR_ERR, stream.str(), "");
+}
+
+std::string MessageBuilder::msgSlowTickCulprits(const std::string& work, unsigned long workTime, const std::string& command, const std::string& commandClient, unsigned long commandTime)
+{
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(1);
+	stream << "   Slowest work: " << DEFAULT;
+	if (work.empty())
+		stream << "none";
+	else
+		stream << work << " " << workTime / 1e6 << " ms";
+	stream << COLOR_ERR << ", slowest command: " << DEFAULT;
+	if (command.empty())
+		stream << "none";
+	else
+		stream << command << " from " << commandClient << " " << commandTime / 1e6 << " ms";
+	return msgBuilder(COLOR_ERR, stream.str(), "");
+}
 
 
 // === CLIENTS ===
@@ -875,6 +1169,10 @@ std::string MessageBuilder::msgClientDisconnected(const std::string& clientIp, i
 	stream << text << " => " << COLOR_DISPLAY << "[" << clientIp << "][port " << port << "][socket " << socket << "]" << RESET;
 	return stream.str();
 }
+std::string MessageBuilder::msgClientIsServerOperator(const std::string& nickname)
+{
+	return msgBuilder("🛡️  " + COLOR_INFO, DEFAULT + nickname + COLOR_INFO + " is now a server operator", "");
+}
 
 
 // === CHANNELS ===
@@ -0,0 +1,224 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ScratchArena.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 17:05:12 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 17:05:12 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ScratchArena.hpp"
+
+#include <cwctype>				// std::iswspace()
+#include <stdexcept>			// std::invalid_argument
+
+// === NAMESPACES ===
+#include "irc_config.hpp"
+
+// =========================================================================================
+
+// === STATIC MEMBERS ===
+
+std::deque<std::string> ScratchArena::_strings;
+std::deque<std::vector<std::string> > ScratchArena::_lists;
+std::vector<std::string> ScratchArena::_spareTokens;
+size_t ScratchArena::_usedStrings = 0;
+size_t ScratchArena::_usedLists = 0;
+
+// Au-delà de cette capacité, une chaîne n'est pas gardée pour la commande suivante
+// (une commande exceptionnelle ne doit pas fixer l'empreinte mémoire de l'arène)
+static const size_t KEEP_CAPACITY_MAX = server::BUFFER_SIZE * 2;
+
+// Mêmes séparateurs que l'extraction d'un std::istringstream (locale "C")
+static bool isStreamSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+// Même test que Utils::isOnlySpace(), sur la fin de la chaîne (sans la copier)
+static bool isOnlySpaceFrom(const std::string& s, size_t pos)
+{
+	for (; pos < s.size(); ++pos)
+		if (std::iswspace(s[pos]) == 0)
+			return false;
+	return true;
+}
+
+
+// =========================================================================================
+
+// === BORROWING ===
+
+// ========================================= PUBLIC ========================================
+
+/**
+ * @brief Lends an empty string until the next reset.
+ *
+ * The string keeps the capacity it reached during previous commands.
+ *
+ * @return A reference to the borrowed string (its address is stable until the reset).
+ */
+std::string& ScratchArena::string()
+{
+	// Un deque ne déplace pas ses éléments quand il grandit : les chaînes déjà prêtées restent valides
+	if (_usedStrings == _strings.size())
+		_strings.push_back(std::string());
+
+	std::string& str = _strings[_usedStrings++];
+	str.clear();
+	return str;
+}
+
+/**
+ * @brief Lends an empty token list until the next reset.
+ *
+ * @return A reference to the borrowed list (its address is stable until the reset).
+ */
+std::vector<std::string>& ScratchArena::tokens()
+{
+	if (_usedLists == _lists.size())
+		_lists.push_back(std::vector<std::string>());
+	return _lists[_usedLists++];
+}
+
+
+// === TOKENIZER ===
+
+/**
+ * @brief Splits a string into a borrowed token list.
+ *
+ * @see split(const std::string&, int, std::vector<std::string>&)
+ */
+std::vector<std::string>& ScratchArena::split(const std::string& s, int opt)
+{
+	std::vector<std::string>& list = tokens();
+	split(s, opt, list);
+	return list;
+}
+
+/**
+ * @brief Splits a string exactly like Utils::getTokens(), without a string stream.
+ *
+ * Tokens are appended to the given list and reuse the strings given back
+ * by previous commands, so splitting does not allocate in a steady state.
+ *
+ * @param s The input string to be tokenized.
+ * @param opt The option for tokenization:
+ *            - SENTENCE: the first word, then the rest of the string (without its first space).
+ *            - WORD: every word.
+ *            - COMMA: every comma-separated element.
+ * @param tokens The list receiving the tokens.
+ * @throws std::invalid_argument If an invalid option is provided.
+ */
+void ScratchArena::split(const std::string& s, int opt, std::vector<std::string>& tokens)
+{
+	size_t size = s.size();
+
+	if (opt == splitter::SENTENCE)
+	{
+		size_t start = 0;
+		while (start < size && isStreamSpace(s[start]))
+			start++;
+		if (start == size)
+			return;
+
+		size_t end = start;
+		while (end < size && !isStreamSpace(s[end]))
+			end++;
+		_pushToken(tokens, s, start, end - start);
+
+		// La suite de la ligne, sauf si elle est vide ou ne contient que des espaces
+		if (end < size && !isOnlySpaceFrom(s, end))
+			_pushToken(tokens, s, end + 1, size - end - 1);
+	}
+	else if (opt == splitter::WORD)
+	{
+		size_t pos = 0;
+		while (pos < size)
+		{
+			while (pos < size && isStreamSpace(s[pos]))
+				pos++;
+			size_t end = pos;
+			while (end < size && !isStreamSpace(s[end]))
+				end++;
+			if (end > pos)
+				_pushToken(tokens, s, pos, end - pos);
+			pos = end;
+		}
+	}
+	else if (opt == splitter::COMMA)
+	{
+		// Comme Utils::getTokens(), la recherche d'une virgule commence après le premier caractère
+		size_t init = 0;
+		size_t comma = s.find(',', 1);
+		while (comma != std::string::npos)
+		{
+			_pushToken(tokens, s, init, comma - init);
+			init = comma + 1;
+			comma = s.find(',', comma + 1);
+		}
+		_pushToken(tokens, s, init, std::string::npos);
+	}
+	else
+		throw std::invalid_argument("no opt option");
+}
+
+
+// === RESET ===
+
+/**
+ * @brief Gives back every borrowed string and list.
+ *
+ * Tokens go to the spare list to be reused by the next split, with their capacity.
+ * Strings that grew beyond twice the IRC line size are released instead.
+ */
+void ScratchArena::reset()
+{
+	for (size_t i = 0; i < _usedLists; ++i)
+	{
+		std::vector<std::string>& list = _lists[i];
+		for (std::vector<std::string>::iterator it = list.begin(); it != list.end(); ++it)
+		{
+			if (it->capacity() > KEEP_CAPACITY_MAX)
+				continue;
+			_spareTokens.push_back(std::string());
+			_spareTokens.back().swap(*it);
+		}
+		list.clear();
+	}
+	for (size_t i = 0; i < _usedStrings; ++i)
+	{
+		if (_strings[i].capacity() > KEEP_CAPACITY_MAX)
+			std::string().swap(_strings[i]);
+	}
+	_usedStrings = 0;
+	_usedLists = 0;
+}
+
+
+// === INFOS ===
+
+size_t ScratchArena::footprint()
+{
+	return _strings.size() + _lists.size() + _spareTokens.size();
+}
+
+
+// ========================================= PRIVATE =======================================
+
+/**
+ * @brief Appends a substring to a token list, reusing a spare string if there is one.
+ */
+void ScratchArena::_pushToken(std::vector<std::string>& tokens, const std::string& s, size_t pos, size_t length)
+{
+	tokens.push_back(std::string());
+	if (!_spareTokens.empty())
+	{
+		tokens.back().swap(_spareTokens.back());
+		_spareTokens.pop_back();
+	}
+	tokens.back().assign(s, pos, length);
+}
@@ -0,0 +1,119 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   StringPool.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: ltorkia <ltorkia@student.42.fr>            +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 15:04:12 by ltorkia           #+#    #+#             */
+/*   Updated: 2026/10/18 15:04:12 by ltorkia          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "StringPool.hpp"
+
+// =========================================================================================
+
+HashTable<std::string, Symbol, StringHash> StringPool::_symbols;
+std::vector<StringPool::Entry> StringPool::_entries(1);
+std::vector<Symbol> StringPool::_freeSymbols;
+
+// =========================================================================================
+
+// === INTERNING ===
+
+/**
+ * @brief Interns a string and takes a reference on its symbol.
+ *
+ * If the string is already in the pool, its existing symbol is returned.
+ * Every call must be balanced by a call to release().
+ *
+ * @param str The string to intern (already casefolded by the caller).
+ * @return The symbol designating the string.
+ */
+Symbol StringPool::intern(const std::string& str)
+{
+	Symbol* found = _symbols.find(str);
+	if (found)
+	{
+		_entries[*found].refs++;
+		return *found;
+	}
+
+	// On réutilise un symbole libéré si possible, sinon on en crée un nouveau
+	Symbol symbol;
+	if (!_freeSymbols.empty())
+	{
+		symbol = _freeSymbols.back();
+		_freeSymbols.pop_back();
+	}
+	else
+	{
+		symbol = _entries.size();
+		_entries.push_back(Entry());
+	}
+
+	_entries[symbol].str = str;
+	_entries[symbol].refs = 1;
+	_symbols.insert(str, symbol);
+	return symbol;
+}
+
+/**
+ * @brief Releases a reference on a symbol.
+ *
+ * When the last reference is released, the string leaves the pool
+ * and the symbol can be handed out again for another string.
+ *
+ * @param symbol The symbol to release (0 is ignored).
+ */
+void StringPool::release(Symbol symbol)
+{
+	if (symbol == 0 || symbol >= _entries.size() || _entries[symbol].refs == 0)
+		return;
+	if (--_entries[symbol].refs > 0)
+		return;
+
+	_symbols.erase(_entries[symbol].str);
+	std::string().swap(_entries[symbol].str);
+	_freeSymbols.push_back(symbol);
+}
+
+
+// === LOOKUP ===
+
+/**
+ * @brief Retrieves the symbol of a string without interning it.
+ *
+ * Used for lookups: a string that is not in the pool cannot be
+ * the key of any channel or nickname.
+ *
+ * @param str The string to look for (already casefolded by the caller).
+ * @return The symbol of the string, or 0 if it is not interned.
+ */
+Symbol StringPool::find(const std::string& str)
+{
+	const Symbol* found = _symbols.find(str);
+	return found ? *found : 0;
+}
+
+/**
+ * @brief Retrieves the string designated by a symbol.
+ *
+ * @param symbol An interned symbol.
+ * @return The interned string (empty for symbol 0).
+ */
+const std::string& StringPool::str(Symbol symbol)
+{
+	if (symbol >= _entries.size())
+		return _entries[0].str;
+	return _entries[symbol].str;
+}
+
+
+// === INFOS ===
+
+size_t StringPool::size()
+{
+	return _symbols.size();
+}
@@ -125,7 +125,7 @@ std::string Utils::getEnvValue(const std::string& key)
 bool Utils::paramCheckNeeded(const std::string& cmd)
 {
 	if (cmd != QUIT && cmd != AWAY && cmd != NICK && cmd != PRIVMSG
-		&& cmd != WHOIS && cmd != PING && cmd != PONG)
+		&& cmd != WHOIS && cmd != PING && cmd != PONG && cmd != LUSERS && cmd != STATS)
 		return true;
 	return false;
 }